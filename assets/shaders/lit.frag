@@ -14,53 +14,27 @@ struct Material {
     float ao;
 };
 
-// Light types
-struct DirectionalLight {
-    vec3 direction;
-    vec3 color;
-    float intensity;
+// Every light, uploaded once per frame by LightManager (see
+// renderer/LightBuffer.hpp): directional lights first, then point, then spot
+struct Light {
+    vec4 positionRange;    // xyz position, w range
+    vec4 directionCutOff;  // xyz direction, w cos(inner cone)
+    vec4 colorIntensity;   // rgb color, a intensity
+    vec4 attenuation;      // constant, linear, quadratic, cos(outer cone)
 };
 
-struct PointLight {
-    vec3 position;
-    vec3 color;
-    float intensity;
-    float range;
-    float constant;
-    float linear;
-    float quadratic;
+layout (std430, binding = 0) readonly buffer LightData {
+    uvec4 lightCounts;     // directional, point, spot
+    Light lights[];
 };
 
-struct SpotLight {
-    vec3 position;
-    vec3 direction;
-    vec3 color;
-    float intensity;
-    float range;
-    float cutOff;
-    float outerCutOff;
-};
-
-// Light uniforms
-#define MAX_DIRECTIONAL_LIGHTS 4
-#define MAX_POINT_LIGHTS 8
-#define MAX_SPOT_LIGHTS 8
-
-uniform int numDirectionalLights;
-uniform int numPointLights;
-uniform int numSpotLights;
-
-uniform DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
-uniform SpotLight spotLights[MAX_SPOT_LIGHTS];
-
 uniform Material material;
 uniform vec3 viewPos;
 
 // Function declarations
-vec3 calculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir);
-vec3 calculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-vec3 calculateSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+vec3 calculateDirectionalLight(Light light, vec3 normal, vec3 viewDir);
+vec3 calculatePointLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir);
+vec3 calculateSpotLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
 void main() {
     vec3 norm = normalize(Normal);
@@ -69,19 +43,23 @@ void main() {
     // Calculate lighting
     vec3 result = vec3(0.0);
 
+    uint pointStart = lightCounts.x;
+    uint spotStart = pointStart + lightCounts.y;
+    uint lightEnd = spotStart + lightCounts.z;
+
     // Directional lights
-    for(int i = 0; i < numDirectionalLights && i < MAX_DIRECTIONAL_LIGHTS; i++) {
-        result += calculateDirectionalLight(directionalLights[i], norm, viewDir);
+    for(uint i = 0u; i < pointStart; i++) {
+        result += calculateDirectionalLight(lights[i], norm, viewDir);
     }
 
     // Point lights
-    for(int i = 0; i < numPointLights && i < MAX_POINT_LIGHTS; i++) {
-        result += calculatePointLight(pointLights[i], norm, FragPos, viewDir);
+    for(uint i = pointStart; i < spotStart; i++) {
+        result += calculatePointLight(lights[i], norm, FragPos, viewDir);
     }
 
     // Spot lights
-    for(int i = 0; i < numSpotLights && i < MAX_SPOT_LIGHTS; i++) {
-        result += calculateSpotLight(spotLights[i], norm, FragPos, viewDir);
+    for(uint i = spotStart; i < lightEnd; i++) {
+        result += calculateSpotLight(lights[i], norm, FragPos, viewDir);
     }
 
     // Ambient light
@@ -91,36 +69,39 @@ void main() {
     FragColor = vec4(result, 1.0);
 }
 
-vec3 calculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir) {
-    vec3 lightDir = normalize(-light.direction);
+vec3 calculateDirectionalLight(Light light, vec3 normal, vec3 viewDir) {
+    vec3 lightDir = normalize(-light.directionCutOff.xyz);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a;
     
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = light.color * light.intensity * diff * material.albedo;
+    vec3 diffuse = radiance * diff * material.albedo;
     
     // Specular
     vec3 halfwayDir = normalize(lightDir + viewDir);
     float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
-    vec3 specular = light.color * light.intensity * spec * (1.0 - material.roughness);
+    vec3 specular = radiance * spec * (1.0 - material.roughness);
     
     return diffuse + specular;
 }
 
-vec3 calculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    vec3 lightDir = normalize(light.position - fragPos);
+vec3 calculatePointLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.positionRange.xyz - fragPos);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a;
     
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = light.color * light.intensity * diff * material.albedo;
+    vec3 diffuse = radiance * diff * material.albedo;
     
     // Specular
     vec3 halfwayDir = normalize(lightDir + viewDir);
     float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
-    vec3 specular = light.color * light.intensity * spec * (1.0 - material.roughness);
+    vec3 specular = radiance * spec * (1.0 - material.roughness);
     
     // Attenuation
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * distance * distance);
+    float distance = length(light.positionRange.xyz - fragPos);
+    vec3 factors = light.attenuation.xyz;
+    float attenuation = 1.0 / (factors.x + factors.y * distance + factors.z * distance * distance);
     
     diffuse *= attenuation;
     specular *= attenuation;
@@ -128,25 +109,28 @@ vec3 calculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewD
     return diffuse + specular;
 }
 
-vec3 calculateSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    vec3 lightDir = normalize(light.position - fragPos);
+vec3 calculateSpotLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.positionRange.xyz - fragPos);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a;
     
     // Spot light cone calculation
-    float theta = dot(lightDir, normalize(-light.direction));
-    float epsilon = light.cutOff - light.outerCutOff;
-    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+    float cutOff = light.directionCutOff.w;
+    float outerCutOff = light.attenuation.w;
+    float theta = dot(lightDir, normalize(-light.directionCutOff.xyz));
+    float epsilon = cutOff - outerCutOff;
+    float intensity = clamp((theta - outerCutOff) / epsilon, 0.0, 1.0);
     
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = light.color * light.intensity * diff * material.albedo;
+    vec3 diffuse = radiance * diff * material.albedo;
     
     // Specular
     vec3 halfwayDir = normalize(lightDir + viewDir);
     float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
-    vec3 specular = light.color * light.intensity * spec * (1.0 - material.roughness);
+    vec3 specular = radiance * spec * (1.0 - material.roughness);
     
     // Attenuation
-    float distance = length(light.position - fragPos);
+    float distance = length(light.positionRange.xyz - fragPos);
     float attenuation = 1.0 / (distance * distance);
     
     diffuse *= attenuation * intensity;
@@ -3,6 +3,8 @@
 layout (location = 0) in vec3 aPosition;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+// Per-instance model matrix, locations 5-8 (Mesh::INSTANCE_MATRIX_LOCATION)
+layout (location = 5) in mat4 aInstanceModel;
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -12,10 +14,18 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 uniform mat3 normalMatrix; // For correct normal transformation
+uniform bool useInstancing; // Set by the renderer for instanced batches
 
 void main() {
-    FragPos = vec3(model * vec4(aPosition, 1.0));
-    Normal = normalMatrix * aNormal;
+    mat4 world = model;
+    mat3 normalWorld = normalMatrix;
+    if (useInstancing) {
+        world = aInstanceModel;
+        normalWorld = transpose(inverse(mat3(aInstanceModel)));
+    }
+
+    FragPos = vec3(world * vec4(aPosition, 1.0));
+    Normal = normalWorld * aNormal;
     TexCoords = aTexCoords;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
@@ -0,0 +1,164 @@
+#version 450 core
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoords;
+
+out vec4 FragColor;
+
+// Material properties
+struct Material {
+    vec3 albedo;
+    float metallic;
+    float roughness;
+    float ao;
+};
+
+// Every light, uploaded once per frame by LightManager (see
+// renderer/LightBuffer.hpp): directional lights first, then point, then spot
+struct Light {
+    vec4 positionRange;    // xyz position, w range
+    vec4 directionCutOff;  // xyz direction, w cos(inner cone)
+    vec4 colorIntensity;   // rgb color, a intensity
+    vec4 attenuation;      // constant, linear, quadratic, cos(outer cone)
+};
+
+layout (std430, binding = 0) readonly buffer LightData {
+    uvec4 lightCounts;     // directional, point, spot
+    Light lights[];
+};
+
+// The view frustum cut into clusters, each with the point and spot lights
+// that reach it, assigned on the CPU by LightClusters (see
+// renderer/LightClusters.hpp). Lights are cut off at their range.
+layout (std430, binding = 1) readonly buffer LightClusterGrid {
+    uvec4 clusterCounts;   // tiles x, tiles y, depth slices
+    vec4 clusterDepth;     // slice = floor(log(depth) * x + y); near, far
+    uvec2 clusterRanges[]; // offset, count into lightIndices
+};
+
+layout (std430, binding = 2) readonly buffer LightIndices {
+    uint lightIndices[];
+};
+
+uniform Material material;
+uniform vec3 viewPos;
+uniform mat4 view;
+uniform mat4 projection;
+
+// Function declarations
+vec3 calculateDirectionalLight(Light light, vec3 normal, vec3 viewDir);
+vec3 calculatePointLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir);
+vec3 calculateSpotLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir);
+
+void main() {
+    vec3 norm = normalize(Normal);
+    vec3 viewDir = normalize(viewPos - FragPos);
+    
+    // Calculate lighting
+    vec3 result = vec3(0.0);
+
+    uint pointStart = lightCounts.x;
+    uint spotStart = pointStart + lightCounts.y;
+
+    // Directional lights reach every cluster
+    for(uint i = 0u; i < pointStart; i++) {
+        result += calculateDirectionalLight(lights[i], norm, viewDir);
+    }
+
+    // This fragment's cluster: screen tile from its projected position,
+    // slice from its view depth
+    vec4 viewPosition = view * vec4(FragPos, 1.0);
+    vec4 clipPosition = projection * viewPosition;
+    vec2 screen = clamp(clipPosition.xy / clipPosition.w * 0.5 + 0.5, 0.0, 0.9999);
+    uvec2 tile = uvec2(screen * vec2(clusterCounts.xy));
+    float depth = max(-viewPosition.z, clusterDepth.z);
+    uint slice = uint(clamp(floor(log(depth) * clusterDepth.x + clusterDepth.y), 0.0, float(clusterCounts.z - 1u)));
+    uvec2 range = clusterRanges[tile.x + clusterCounts.x * (tile.y + clusterCounts.y * slice)];
+
+    // Point and spot lights assigned to it
+    for(uint i = range.x; i < range.x + range.y; i++) {
+        uint index = lightIndices[i];
+        if (index < spotStart) {
+            result += calculatePointLight(lights[index], norm, FragPos, viewDir);
+        } else {
+            result += calculateSpotLight(lights[index], norm, FragPos, viewDir);
+        }
+    }
+
+    // Ambient light
+    vec3 ambient = vec3(0.03) * material.albedo * material.ao;
+    result += ambient;
+
+    FragColor = vec4(result, 1.0);
+}
+
+vec3 calculateDirectionalLight(Light light, vec3 normal, vec3 viewDir) {
+    vec3 lightDir = normalize(-light.directionCutOff.xyz);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a;
+    
+    // Diffuse
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = radiance * diff * material.albedo;
+    
+    // Specular
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
+    vec3 specular = radiance * spec * (1.0 - material.roughness);
+    
+    return diffuse + specular;
+}
+
+vec3 calculatePointLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.positionRange.xyz - fragPos);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a;
+    
+    // Diffuse
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = radiance * diff * material.albedo;
+    
+    // Specular
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
+    vec3 specular = radiance * spec * (1.0 - material.roughness);
+    
+    // Attenuation
+    float distance = length(light.positionRange.xyz - fragPos);
+    vec3 factors = light.attenuation.xyz;
+    float attenuation = 1.0 / (factors.x + factors.y * distance + factors.z * distance * distance);
+    
+    diffuse *= attenuation;
+    specular *= attenuation;
+    
+    return diffuse + specular;
+}
+
+vec3 calculateSpotLight(Light light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.positionRange.xyz - fragPos);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a;
+    
+    // Spot light cone calculation
+    float cutOff = light.directionCutOff.w;
+    float outerCutOff = light.attenuation.w;
+    float theta = dot(lightDir, normalize(-light.directionCutOff.xyz));
+    float epsilon = cutOff - outerCutOff;
+    float intensity = clamp((theta - outerCutOff) / epsilon, 0.0, 1.0);
+    
+    // Diffuse
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = radiance * diff * material.albedo;
+    
+    // Specular
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
+    vec3 specular = radiance * spec * (1.0 - material.roughness);
+    
+    // Attenuation
+    float distance = length(light.positionRange.xyz - fragPos);
+    float attenuation = 1.0 / (distance * distance);
+    
+    diffuse *= attenuation * intensity;
+    specular *= attenuation * intensity;
+    
+    return diffuse + specular;
+}
@@ -0,0 +1,51 @@
+#include "Benchmark.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/gameplay/AIController.hpp"
+#include "../src/physics/Collider.hpp"
+#include "../src/physics/RigidBody.hpp"
+#include <cmath>
+#include <string>
+
+namespace {
+    // Bots on a ring around one target, half of them inside aggression range.
+    // Visibility is a raycast against every collider, so cost grows with the
+    // square of the population.
+    void runAI(Benchmark& benchmark) {
+        const size_t botCounts[] = { 100, 500, 2000 };
+        const float deltaTime = 1.0f / 60.0f;
+
+        for (size_t bots : botCounts) {
+            Scene scene;
+            Entity* player = scene.createEntity("Player");
+            player->addComponent<Transform>()->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+            player->addComponent<SphereCollider>()->setRadius(0.5f);
+            EntityHandle target = player->getHandle();
+
+            for (size_t i = 0; i < bots; ++i) {
+                float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(bots);
+                float radius = i % 2 ? 10.0f : 30.0f;
+                glm::vec3 spawn(std::cos(angle) * radius, 1.0f, std::sin(angle) * radius);
+
+                Entity* bot = scene.createEntity("Bot");
+                bot->addComponent<Transform>()->setPosition(spawn);
+                bot->addComponent<RigidBody>()->setMass(70.0f);
+                bot->addComponent<SphereCollider>()->setRadius(0.4f);
+
+                auto ai = bot->addComponent<AIController>();
+                ai->setTarget(target);
+                ai->setPatrolPoints({ spawn, spawn + glm::vec3(5.0f, 0.0f, 0.0f) });
+                ai->setState(AIController::State::Patrol);
+            }
+
+            size_t iterations = 200000 / bots + 5;
+            benchmark.measure("update " + std::to_string(bots) + " bots", iterations, [&]() {
+                scene.view<AIController>().each([deltaTime](Entity*, AIController& ai) {
+                    ai.update(deltaTime);
+                });
+            });
+        }
+    }
+
+    BenchmarkRegistration registration("AIController", runAI);
+}
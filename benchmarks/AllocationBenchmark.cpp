@@ -0,0 +1,112 @@
+#include "Benchmark.hpp"
+#include "../src/core/AllocationTracker.hpp"
+#include "../src/core/Allocators.hpp"
+#include "../src/core/JobSystem.hpp"
+#include "../src/core/Profiler.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/physics/Collider.hpp"
+#include "../src/physics/PhysicsSystem.hpp"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    struct Particle {
+        glm::vec3 position;
+        glm::vec3 velocity;
+        float age;
+    };
+
+    class Drifter : public Component {
+    public:
+        void update(float deltaTime) override {
+            getEntity()->getComponent<Transform>()->translate(glm::vec3(0.0f, 0.0f, 0.1f * deltaTime));
+        }
+    };
+
+    void runAllocators(Benchmark& benchmark) {
+        const size_t count = 10000;
+        std::vector<Particle*> live(count);
+
+        benchmark.measure("new/delete 10k objects", 100, [&]() {
+            for (size_t i = 0; i < count; ++i) live[i] = new Particle();
+            for (size_t i = 0; i < count; ++i) delete live[i];
+        });
+
+        ObjectPool<Particle> pool;
+        benchmark.measure("ObjectPool 10k objects", 100, [&]() {
+            for (size_t i = 0; i < count; ++i) live[i] = pool.create();
+            for (size_t i = 0; i < count; ++i) pool.destroy(live[i]);
+        });
+
+        benchmark.measure("std::vector scratch 10k", 100, [&]() {
+            std::vector<Particle> scratch;
+            for (size_t i = 0; i < count; ++i) scratch.push_back(Particle());
+            doNotOptimize(scratch.back());
+        });
+
+        benchmark.measure("FrameVector scratch 10k", 100, [&]() {
+            FrameVector<Particle> scratch;
+            for (size_t i = 0; i < count; ++i) scratch.push_back(Particle());
+            doNotOptimize(scratch.back());
+            FrameArena::resetAll();
+        });
+    }
+
+    // Scene update with physics and jobs, after warm-up: should not allocate
+    void runSteadyState(Benchmark& benchmark) {
+        if (!AllocationTracker::isEnabled()) {
+            std::cout << "Steady-state allocation check skipped: build with ENGINE_TRACK_ALLOCATIONS=ON" << std::endl;
+        }
+
+        JobSystem::getInstance().initialize();
+        PhysicsSystem& physics = PhysicsSystem::getInstance();
+        physics.initialize();
+
+        Scene scene;
+        for (size_t i = 0; i < 2000; ++i) {
+            Entity* entity = scene.createEntity();
+            entity->addComponent<Transform>()->setPosition(glm::vec3(static_cast<float>(i % 40), 0.0f, static_cast<float>(i / 40)));
+            entity->addComponent<SphereCollider>()->setRadius(0.6f);
+            entity->addComponent<Drifter>();
+        }
+        for (Entity* entity : scene.getEntities()) {
+            physics.addCollider(entity->getComponent<SphereCollider>());
+        }
+
+        const float deltaTime = 1.0f / 60.0f;
+        auto frame = [&]() {
+            scene.update(deltaTime);
+            physics.update(deltaTime);
+            PROFILE_FRAME();
+            FrameArena::resetAll();
+        };
+
+        // Warm-up lets pools, arenas and container capacities reach their high-water marks
+        for (int i = 0; i < 10; ++i) {
+            frame();
+        }
+
+        const int frames = 100;
+        ScopedAllocationCounter counter;
+        for (int i = 0; i < frames; ++i) {
+            frame();
+        }
+        uint64_t allocations = counter.getCount();
+
+        benchmark.measure("steady-state frame 2000 entities", 20, frame);
+        if (AllocationTracker::isEnabled()) {
+            std::cout << "Steady-state heap allocations: " << allocations << " over " << frames << " frames" << std::endl;
+            benchmark.check(allocations == 0, "steady-state frames allocated from the heap");
+        }
+
+        for (Entity* entity : scene.getEntities()) {
+            physics.removeCollider(entity->getComponent<SphereCollider>());
+        }
+        JobSystem::getInstance().shutdown();
+    }
+
+    BenchmarkRegistration allocatorRegistration("Allocators", runAllocators);
+    BenchmarkRegistration steadyStateRegistration("SteadyStateAllocations", runSteadyState);
+}
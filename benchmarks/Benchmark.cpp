@@ -0,0 +1,150 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+void Benchmark::add(const std::string& name, const Function& function) {
+    benchmarks.push_back({ name, function });
+}
+
+int Benchmark::runAll(const std::string& filter) {
+    std::vector<std::string> patterns;
+    std::istringstream stream(filter);
+    for (std::string pattern; std::getline(stream, pattern, ',');) {
+        if (!pattern.empty()) patterns.push_back(pattern);
+    }
+
+    int count = 0;
+    for (const auto& benchmark : benchmarks) {
+        bool matches = patterns.empty() || std::any_of(patterns.begin(), patterns.end(),
+            [&](const std::string& pattern) { return benchmark.name.find(pattern) != std::string::npos; });
+        if (!matches) continue;
+
+        currentBenchmark = benchmark.name;
+        benchmark.function(*this);
+        count++;
+    }
+    return count;
+}
+
+void Benchmark::check(bool condition, const std::string& message) {
+    if (condition) return;
+
+    std::cerr << "FAILED " << currentBenchmark << ": " << message << std::endl;
+    failures++;
+}
+
+std::vector<std::string> Benchmark::getNames() const {
+    std::vector<std::string> names;
+    for (const auto& benchmark : benchmarks) {
+        names.push_back(benchmark.name);
+    }
+    return names;
+}
+
+void Benchmark::measure(const std::string& label, size_t iterations, const std::function<void()>& body) {
+    for (size_t i = 0; i < warmupIterations; ++i) {
+        body();
+    }
+
+    iterations = std::max<size_t>(1, static_cast<size_t>(std::lround(iterations * iterationScale)));
+
+    // Each iteration is timed on its own so outliers show up in max/stddev
+    // instead of being folded into the mean
+    std::vector<double> samples(iterations);
+    for (size_t i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        samples[i] = std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    Result result;
+    result.benchmark = currentBenchmark;
+    result.label = label;
+    result.iterations = iterations;
+
+    double total = 0.0;
+    for (double sample : samples) total += sample;
+    result.mean = total / iterations;
+
+    double variance = 0.0;
+    for (double sample : samples) variance += (sample - result.mean) * (sample - result.mean);
+    result.stddev = iterations > 1 ? std::sqrt(variance / (iterations - 1)) : 0.0;
+
+    std::sort(samples.begin(), samples.end());
+    result.min = samples.front();
+    result.max = samples.back();
+    result.median = iterations % 2 ? samples[iterations / 2]
+                                   : 0.5 * (samples[iterations / 2 - 1] + samples[iterations / 2]);
+    results.push_back(result);
+
+    std::cout << std::left << std::setw(24) << currentBenchmark
+              << std::setw(40) << label << ' '
+              << std::right << std::fixed << std::setprecision(4)
+              << result.mean << " ms/iter"
+              << "  (median " << result.median
+              << ", min " << result.min
+              << ", sd " << result.stddev
+              << ", n=" << iterations << ")" << std::endl;
+}
+
+bool Benchmark::writeJson(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open benchmark output: " << path << std::endl;
+        return false;
+    }
+
+    file << std::setprecision(9);
+    file << "{\n  \"unit\": \"ms\",\n  \"warmup\": " << warmupIterations << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        file << (i ? ",\n" : "\n")
+             << "    {\"benchmark\": " << quoteJson(result.benchmark)
+             << ", \"label\": " << quoteJson(result.label)
+             << ", \"iterations\": " << result.iterations
+             << ", \"mean\": " << result.mean
+             << ", \"median\": " << result.median
+             << ", \"min\": " << result.min
+             << ", \"max\": " << result.max
+             << ", \"stddev\": " << result.stddev << "}";
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
+
+std::string Benchmark::quoteJson(const std::string& value) {
+    std::ostringstream out;
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+std::vector<unsigned> Benchmark::getThreadCounts() {
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < hardwareThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(hardwareThreads);
+    return counts;
+}
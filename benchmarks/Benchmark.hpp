@@ -0,0 +1,92 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal timing harness shared by the engine benchmarks
+class Benchmark {
+public:
+    using Function = std::function<void(Benchmark&)>;
+
+    // Timing summary for one measure() call, in milliseconds per iteration
+    struct Result {
+        std::string benchmark;
+        std::string label;
+        size_t iterations = 0;
+        double mean = 0.0;
+        double median = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double stddev = 0.0;
+    };
+
+    static Benchmark& getInstance() {
+        static Benchmark instance;
+        return instance;
+    }
+
+    void add(const std::string& name, const Function& function);
+
+    // Runs benchmarks whose name contains any of the comma-separated filter
+    // words, or all of them for an empty filter; returns how many ran
+    int runAll(const std::string& filter = "");
+
+    // Untimed passes before every measurement, to warm caches and allocators
+    void setWarmupIterations(size_t count) { warmupIterations = count; }
+
+    // Scales every benchmark's iteration count; at least one iteration always runs
+    void setIterationScale(double scale) { iterationScale = scale; }
+
+    // Times each of `iterations` calls of `body` and records the statistics under `label`
+    void measure(const std::string& label, size_t iterations, const std::function<void()>& body);
+
+    // Records a failed expectation of the running benchmark when `condition`
+    // is false; the suite then exits non-zero
+    void check(bool condition, const std::string& message);
+    size_t getFailureCount() const { return failures; }
+
+    const std::vector<Result>& getResults() const { return results; }
+    std::vector<std::string> getNames() const;
+
+    // Writes every recorded result as {"results": [...]}; returns false on I/O failure
+    bool writeJson(const std::string& path) const;
+
+    // `value` as a quoted JSON string literal
+    static std::string quoteJson(const std::string& value);
+
+    // Thread counts for scaling sweeps: 1, 2, 4, ... up to the hardware thread count
+    static std::vector<unsigned> getThreadCounts();
+
+private:
+    Benchmark() = default;
+    ~Benchmark() = default;
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    struct Entry {
+        std::string name;
+        Function function;
+    };
+
+    std::vector<Entry> benchmarks;
+    std::vector<Result> results;
+    std::string currentBenchmark;
+    size_t failures = 0;
+    size_t warmupIterations = 1;
+    double iterationScale = 1.0;
+};
+
+// Registers a benchmark function at static-initialisation time
+struct BenchmarkRegistration {
+    BenchmarkRegistration(const std::string& name, const Benchmark::Function& function) {
+        Benchmark::getInstance().add(name, function);
+    }
+};
+
+// Prevents the optimiser from discarding a computed value
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
@@ -0,0 +1,379 @@
+#include "BenchmarkBaseline.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace {
+    // Just enough JSON for files written by Benchmark::writeJson and
+    // BenchmarkBaseline::save, which may since have been edited by hand
+    struct JsonValue {
+        enum class Type { Null, Bool, Number, String, Array, Object };
+        Type type = Type::Null;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> array;
+        std::map<std::string, JsonValue> object;
+
+        const JsonValue* find(const std::string& key) const {
+            auto it = object.find(key);
+            return it != object.end() ? &it->second : nullptr;
+        }
+        double numberOr(const std::string& key, double fallback) const {
+            const JsonValue* value = find(key);
+            return value && value->type == Type::Number ? value->number : fallback;
+        }
+        std::string stringOr(const std::string& key, const std::string& fallback) const {
+            const JsonValue* value = find(key);
+            return value && value->type == Type::String ? value->string : fallback;
+        }
+    };
+
+    class JsonParser {
+    public:
+        explicit JsonParser(const std::string& text) : text(text) {}
+
+        bool parse(JsonValue& value) {
+            if (!parseValue(value)) return false;
+            skipWhitespace();
+            return position == text.size();
+        }
+
+        size_t getPosition() const { return position; }
+
+    private:
+        const std::string& text;
+        size_t position = 0;
+
+        void skipWhitespace() {
+            while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+                position++;
+            }
+        }
+
+        bool consume(char expected) {
+            skipWhitespace();
+            if (position < text.size() && text[position] == expected) {
+                position++;
+                return true;
+            }
+            return false;
+        }
+
+        bool consumeWord(const char* word) {
+            size_t length = std::char_traits<char>::length(word);
+            if (text.compare(position, length, word) != 0) return false;
+            position += length;
+            return true;
+        }
+
+        bool parseValue(JsonValue& value) {
+            skipWhitespace();
+            if (position >= text.size()) return false;
+
+            char c = text[position];
+            if (c == '{') return parseObject(value);
+            if (c == '[') return parseArray(value);
+            if (c == '"') {
+                value.type = JsonValue::Type::String;
+                return parseString(value.string);
+            }
+            if (consumeWord("true") || consumeWord("false")) {
+                value.type = JsonValue::Type::Bool;
+                value.number = c == 't' ? 1.0 : 0.0;
+                return true;
+            }
+            if (consumeWord("null")) {
+                value.type = JsonValue::Type::Null;
+                return true;
+            }
+
+            const char* begin = text.c_str() + position;
+            char* end = nullptr;
+            value.number = std::strtod(begin, &end);
+            if (end == begin) return false;
+            value.type = JsonValue::Type::Number;
+            position += end - begin;
+            return true;
+        }
+
+        bool parseString(std::string& out) {
+            if (!consume('"')) return false;
+            out.clear();
+            while (position < text.size()) {
+                char c = text[position++];
+                if (c == '"') return true;
+                if (c != '\\') {
+                    out += c;
+                    continue;
+                }
+                if (position >= text.size()) return false;
+                char escape = text[position++];
+                switch (escape) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u': {
+                        // Benchmark names are ASCII; wider code points are kept as '?'
+                        if (position + 4 > text.size()) return false;
+                        long code = std::strtol(text.substr(position, 4).c_str(), nullptr, 16);
+                        out += code < 0x80 ? static_cast<char>(code) : '?';
+                        position += 4;
+                        break;
+                    }
+                    default: out += escape; break;
+                }
+            }
+            return false;
+        }
+
+        bool parseArray(JsonValue& value) {
+            value.type = JsonValue::Type::Array;
+            consume('[');
+            if (consume(']')) return true;
+            do {
+                value.array.emplace_back();
+                if (!parseValue(value.array.back())) return false;
+            } while (consume(','));
+            return consume(']');
+        }
+
+        bool parseObject(JsonValue& value) {
+            value.type = JsonValue::Type::Object;
+            consume('{');
+            if (consume('}')) return true;
+            do {
+                skipWhitespace();
+                std::string key;
+                if (!parseString(key) || !consume(':')) return false;
+                if (!parseValue(value.object[key])) return false;
+            } while (consume(','));
+            return consume('}');
+        }
+    };
+
+    // Two-sided 95% critical values of Student's t for 1..30 degrees of freedom
+    double criticalT(double degreesOfFreedom) {
+        static const double table[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+        };
+        if (degreesOfFreedom < 1.0) return table[0];
+        if (degreesOfFreedom > 30.0) return 1.96;
+        return table[static_cast<size_t>(degreesOfFreedom) - 1];
+    }
+
+    std::string key(const std::string& benchmark, const std::string& label) {
+        return benchmark + '\n' + label;
+    }
+
+    const char* statusName(BenchmarkBaseline::Comparison::Status status) {
+        using Status = BenchmarkBaseline::Comparison::Status;
+        switch (status) {
+            case Status::Unchanged: return "ok";
+            case Status::Improved: return "faster";
+            case Status::Slower: return "slower (noise)";
+            case Status::Regressed: return "REGRESSION";
+            case Status::New: return "new";
+            case Status::Missing: return "missing";
+        }
+        return "";
+    }
+}
+
+bool BenchmarkBaseline::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open baseline: " << path << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    JsonValue root;
+    JsonParser parser(text);
+    if (!parser.parse(root) || root.type != JsonValue::Type::Object) {
+        std::cerr << "Invalid baseline JSON in " << path << " near offset " << parser.getPosition() << std::endl;
+        return false;
+    }
+
+    const JsonValue* results = root.find("results");
+    if (!results || results->type != JsonValue::Type::Array) {
+        std::cerr << "Baseline " << path << " has no results array" << std::endl;
+        return false;
+    }
+
+    defaultThreshold = root.numberOr("defaultThreshold", DEFAULT_THRESHOLD);
+    entries.clear();
+    for (const JsonValue& value : results->array) {
+        if (value.type != JsonValue::Type::Object) continue;
+
+        Entry entry;
+        entry.result.benchmark = value.stringOr("benchmark", "");
+        entry.result.label = value.stringOr("label", "");
+        entry.result.iterations = static_cast<size_t>(value.numberOr("iterations", 0.0));
+        entry.result.mean = value.numberOr("mean", 0.0);
+        entry.result.median = value.numberOr("median", entry.result.mean);
+        entry.result.min = value.numberOr("min", entry.result.median);
+        entry.result.max = value.numberOr("max", entry.result.median);
+        entry.result.stddev = value.numberOr("stddev", 0.0);
+        entry.threshold = value.numberOr("threshold", defaultThreshold);
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+bool BenchmarkBaseline::save(const std::string& path, const std::vector<Benchmark::Result>& results) {
+    std::error_code error;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open baseline for writing: " << path << std::endl;
+        return false;
+    }
+
+    file << std::setprecision(6);
+    file << "{\n  \"unit\": \"ms\",\n  \"defaultThreshold\": " << DEFAULT_THRESHOLD << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Benchmark::Result& result = results[i];
+        double variation = result.mean > 0.0 ? result.stddev / result.mean : 0.0;
+        double threshold = std::max(DEFAULT_THRESHOLD, std::ceil(variation * 3.0 * 100.0) / 100.0);
+
+        file << (i ? ",\n" : "\n")
+             << "    {\"benchmark\": " << Benchmark::quoteJson(result.benchmark)
+             << ", \"label\": " << Benchmark::quoteJson(result.label)
+             << ", \"iterations\": " << result.iterations
+             << ", \"mean\": " << result.mean
+             << ", \"median\": " << result.median
+             << ", \"min\": " << result.min
+             << ", \"max\": " << result.max
+             << ", \"stddev\": " << result.stddev
+             << ", \"threshold\": " << threshold << "}";
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
+
+std::vector<BenchmarkBaseline::Comparison> BenchmarkBaseline::compare(const std::vector<Benchmark::Result>& results) const {
+    std::map<std::string, const Entry*> byKey;
+    for (const Entry& entry : entries) {
+        byKey[key(entry.result.benchmark, entry.result.label)] = &entry;
+    }
+
+    std::vector<Comparison> comparisons;
+    std::set<std::string> seen;
+    std::set<std::string> benchmarksRun;
+    for (const Benchmark::Result& result : results) {
+        benchmarksRun.insert(result.benchmark);
+
+        Comparison comparison;
+        comparison.benchmark = result.benchmark;
+        comparison.label = result.label;
+        comparison.currentMedian = result.median;
+
+        std::string resultKey = key(result.benchmark, result.label);
+        auto it = byKey.find(resultKey);
+        if (it == byKey.end()) {
+            comparison.status = Comparison::Status::New;
+            comparison.threshold = defaultThreshold;
+            comparisons.push_back(comparison);
+            continue;
+        }
+        seen.insert(resultKey);
+
+        const Benchmark::Result& base = it->second->result;
+        comparison.baselineMedian = base.median;
+        comparison.threshold = it->second->threshold;
+        comparison.change = base.median > 0.0 ? (result.median - base.median) / base.median : 0.0;
+
+        // Welch's t-test: significant when the means differ by more than the
+        // combined sampling noise of both runs would explain
+        double varianceBase = base.iterations > 0 ? base.stddev * base.stddev / base.iterations : 0.0;
+        double varianceCurrent = result.iterations > 0 ? result.stddev * result.stddev / result.iterations : 0.0;
+        double standardError = std::sqrt(varianceBase + varianceCurrent);
+        bool significant = true;
+        if (standardError > 0.0) {
+            comparison.tStatistic = (result.mean - base.mean) / standardError;
+
+            double degreesOfFreedom = 1.0;
+            if (base.iterations > 1 && result.iterations > 1) {
+                degreesOfFreedom = (varianceBase + varianceCurrent) * (varianceBase + varianceCurrent) /
+                    (varianceBase * varianceBase / (base.iterations - 1) +
+                     varianceCurrent * varianceCurrent / (result.iterations - 1));
+            }
+            significant = std::abs(comparison.tStatistic) > criticalT(degreesOfFreedom);
+        }
+
+        if (comparison.change > comparison.threshold) {
+            comparison.status = significant ? Comparison::Status::Regressed : Comparison::Status::Slower;
+        } else if (comparison.change < -comparison.threshold && significant) {
+            comparison.status = Comparison::Status::Improved;
+        }
+        comparisons.push_back(comparison);
+    }
+
+    // Baseline metrics that vanished from a benchmark that did run
+    for (const Entry& entry : entries) {
+        if (!benchmarksRun.count(entry.result.benchmark)) continue;
+        if (seen.count(key(entry.result.benchmark, entry.result.label))) continue;
+
+        Comparison comparison;
+        comparison.benchmark = entry.result.benchmark;
+        comparison.label = entry.result.label;
+        comparison.status = Comparison::Status::Missing;
+        comparison.baselineMedian = entry.result.median;
+        comparison.threshold = entry.threshold;
+        comparisons.push_back(comparison);
+    }
+
+    return comparisons;
+}
+
+size_t BenchmarkBaseline::writeReport(std::ostream& out, const std::vector<Comparison>& comparisons) {
+    size_t regressions = 0;
+    size_t improvements = 0;
+
+    out << std::left << std::setw(24) << "benchmark"
+        << std::setw(40) << "label"
+        << std::right << std::setw(12) << "base ms"
+        << std::setw(12) << "now ms"
+        << std::setw(10) << "change"
+        << std::setw(8) << "limit"
+        << std::setw(8) << "t"
+        << "  status" << std::endl;
+
+    for (const Comparison& comparison : comparisons) {
+        if (comparison.status == Comparison::Status::Regressed) regressions++;
+        if (comparison.status == Comparison::Status::Improved) improvements++;
+
+        out << std::left << std::setw(24) << comparison.benchmark
+            << std::setw(40) << comparison.label
+            << std::right << std::fixed << std::setprecision(4)
+            << std::setw(12) << comparison.baselineMedian
+            << std::setw(12) << comparison.currentMedian
+            << std::setprecision(1)
+            << std::setw(9) << comparison.change * 100.0 << "%"
+            << std::setw(7) << comparison.threshold * 100.0 << "%"
+            << std::setprecision(2) << std::setw(8) << comparison.tStatistic
+            << "  " << statusName(comparison.status) << std::endl;
+    }
+
+    out << regressions << " regression(s), " << improvements << " improvement(s) across "
+        << comparisons.size() << " metric(s)" << std::endl;
+    return regressions;
+}
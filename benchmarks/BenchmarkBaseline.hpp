@@ -0,0 +1,55 @@
+#pragma once
+#include "Benchmark.hpp"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Reference timings for the performance gate. Stored as the same JSON that
+// --json writes, plus a per-result "threshold": the relative slowdown of the
+// median that still counts as noise for that metric.
+class BenchmarkBaseline {
+public:
+    struct Entry {
+        Benchmark::Result result;
+        double threshold = 0.0;
+    };
+
+    struct Comparison {
+        enum class Status {
+            Unchanged,
+            Improved,
+            Slower,     // Over the threshold but not statistically significant
+            Regressed,  // Over the threshold and significant
+            New,        // Not in the baseline
+            Missing     // In the baseline, its benchmark ran, but it did not
+        };
+
+        std::string benchmark;
+        std::string label;
+        Status status = Status::Unchanged;
+        double baselineMedian = 0.0;
+        double currentMedian = 0.0;
+        double change = 0.0;      // Relative change of the median; positive is slower
+        double threshold = 0.0;
+        double tStatistic = 0.0;  // Welch's t on the means; positive is slower
+    };
+
+    // Used for entries without their own threshold
+    static constexpr double DEFAULT_THRESHOLD = 0.05;
+
+    bool load(const std::string& path);
+    bool empty() const { return entries.empty(); }
+
+    // Thresholds default to three coefficients of variation of each result,
+    // never below DEFAULT_THRESHOLD. Edit the file to tune individual metrics.
+    static bool save(const std::string& path, const std::vector<Benchmark::Result>& results);
+
+    std::vector<Comparison> compare(const std::vector<Benchmark::Result>& results) const;
+
+    // Prints a table of every comparison and returns the number of regressions
+    static size_t writeReport(std::ostream& out, const std::vector<Comparison>& comparisons);
+
+private:
+    std::vector<Entry> entries;
+    double defaultThreshold = DEFAULT_THRESHOLD;
+};
@@ -0,0 +1,107 @@
+#include "Benchmark.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/components/Light.hpp"
+#include "../src/components/Camera.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+    class Tag : public Component {};
+    class Marker : public Component {};
+
+    // Previous lookup: linear dynamic_cast over the entity's components
+    template<typename T>
+    T* dynamicCastLookup(const std::vector<std::unique_ptr<Component>>& components) {
+        for (const auto& component : components) {
+            if (T* casted = dynamic_cast<T*>(component.get())) {
+                return casted;
+            }
+        }
+        return nullptr;
+    }
+
+    void runComponentLookup(Benchmark& benchmark) {
+        const size_t entityCount = 10000;
+
+        // Transform added last so the scan walks the whole list, as for
+        // entities whose Transform sits behind other components
+        std::vector<std::vector<std::unique_ptr<Component>>> legacy(entityCount);
+        for (auto& components : legacy) {
+            components.push_back(std::make_unique<Tag>());
+            components.push_back(std::make_unique<Marker>());
+            components.push_back(std::make_unique<Camera>());
+            components.push_back(std::make_unique<Light>());
+            components.push_back(std::make_unique<Transform>());
+        }
+
+        Scene scene;
+        std::vector<Entity*> entities;
+        for (size_t i = 0; i < entityCount; ++i) {
+            Entity* entity = scene.createEntity();
+            entity->addComponent<Tag>();
+            entity->addComponent<Marker>();
+            entity->addComponent<Camera>();
+            entity->addComponent<Light>();
+            entity->addComponent<Transform>();
+            entities.push_back(entity);
+        }
+
+        benchmark.measure("dynamic_cast scan x10k", 200, [&]() {
+            for (const auto& components : legacy) {
+                doNotOptimize(dynamicCastLookup<Transform>(components));
+            }
+        });
+        benchmark.measure("type id lookup x10k", 200, [&]() {
+            for (Entity* entity : entities) {
+                doNotOptimize(entity->getComponent<Transform>());
+            }
+        });
+    }
+
+    // Reading two components of every matching entity: per-entity lookups
+    // against a view, with a third of the entities filtered out
+    void runComponentView(Benchmark& benchmark) {
+        const size_t entityCount = 30000;
+
+        Scene scene;
+        for (size_t i = 0; i < entityCount; ++i) {
+            Entity* entity = scene.createEntity();
+            entity->addComponent<Transform>()->setPosition(glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+            entity->addComponent<Light>()->setIntensity(static_cast<float>(i % 10));
+            if (i % 3 == 0) {
+                entity->addComponent<Tag>();
+            }
+        }
+
+        benchmark.measure("getComponent per entity x30k", 200, [&]() {
+            float sum = 0.0f;
+            for (Entity* entity : scene.getEntities()) {
+                if (entity->getComponent<Tag>()) continue;
+                Transform* transform = entity->getComponent<Transform>();
+                Light* light = entity->getComponent<Light>();
+                if (transform && light) {
+                    sum += transform->getPosition().x * light->getIntensity();
+                }
+            }
+            doNotOptimize(sum);
+        });
+        benchmark.measure("view iterator x30k", 200, [&]() {
+            float sum = 0.0f;
+            for (auto [entity, transform, light] : scene.view<Transform, Light>().exclude<Tag>()) {
+                sum += transform.getPosition().x * light.getIntensity();
+            }
+            doNotOptimize(sum);
+        });
+        benchmark.measure("view each x30k", 200, [&]() {
+            float sum = 0.0f;
+            scene.view<Transform, Light>().exclude<Tag>().each([&sum](Entity*, Transform& transform, Light& light) {
+                sum += transform.getPosition().x * light.getIntensity();
+            });
+            doNotOptimize(sum);
+        });
+    }
+
+    BenchmarkRegistration registration("ComponentLookup", runComponentLookup);
+    BenchmarkRegistration viewRegistration("ComponentView", runComponentView);
+}
@@ -0,0 +1,110 @@
+#include "Benchmark.hpp"
+#include "../src/components/MeshRenderer.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/core/Random.hpp"
+#include "../src/scene/CullingSet.hpp"
+#include "../src/scene/DynamicAABBTree.hpp"
+#include "../src/scene/Scene.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    // Same level layout as the SpatialIndex benchmark: a 1 km square of props
+    std::vector<AABB> makeBoxes(size_t count, Random& random) {
+        std::vector<AABB> boxes(count);
+        for (AABB& box : boxes) {
+            glm::vec3 center(random.range(-500.0f, 500.0f), random.range(0.0f, 10.0f), random.range(-500.0f, 500.0f));
+            glm::vec3 extents(random.range(0.25f, 2.0f));
+            box = AABB(center - extents, center + extents);
+        }
+        return boxes;
+    }
+
+    struct View {
+        const char* name;
+        Frustum frustum;
+    };
+
+    // One frame's cull of 100k renderables from two cameras: a player at
+    // ground level, which sees a few percent of the level, and a high
+    // overview camera, which sees most of it
+    void runFrustumCulling(Benchmark& benchmark) {
+        const size_t count = 100000;
+        Random random(count);
+        std::vector<AABB> boxes = makeBoxes(count, random);
+
+        DynamicAABBTree tree;
+        CullingSet cullingSet;
+        for (size_t i = 0; i < count; ++i) {
+            tree.createProxy(boxes[i], &boxes[i]);
+            cullingSet.add(boxes[i], static_cast<uint32_t>(i));
+        }
+
+        const glm::vec3 up(0.0f, 1.0f, 0.0f);
+        glm::mat4 player = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 200.0f) *
+                           glm::lookAt(glm::vec3(0.0f, 1.8f, 0.0f), glm::vec3(1.0f, 1.8f, 0.3f), up);
+        glm::mat4 overview = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 1.0f, 2000.0f) *
+                             glm::lookAt(glm::vec3(0.0f, 600.0f, 700.0f), glm::vec3(0.0f), up);
+        const View views[] = {
+            { "player view", Frustum::fromMatrix(player) },
+            { "overview", Frustum::fromMatrix(overview) },
+        };
+
+        for (const View& view : views) {
+            std::string suffix = std::string(", ") + view.name;
+
+            // What every frame paid before culling: each box against the frustum
+            size_t scalarVisible = 0;
+            benchmark.measure("scalar loop 100k" + suffix, 20, [&]() {
+                scalarVisible = 0;
+                for (const AABB& box : boxes) {
+                    if (view.frustum.intersects(box)) ++scalarVisible;
+                }
+                doNotOptimize(scalarVisible);
+            });
+
+            size_t treeVisible = 0;
+            benchmark.measure("tree query 100k" + suffix, 20, [&]() {
+                treeVisible = 0;
+                tree.queryFrustum(view.frustum, [&treeVisible](int32_t) { ++treeVisible; return true; });
+                doNotOptimize(treeVisible);
+            });
+
+            std::vector<uint32_t> visible;
+            visible.reserve(count);
+            CullingSet::Stats stats;
+            benchmark.measure("culling set 100k" + suffix, 20, [&]() {
+                visible.clear();
+                stats = cullingSet.cull(view.frustum, visible);
+                doNotOptimize(visible.data());
+            });
+
+            // Tree results include fat-margin hits, so only the exact tests should agree
+            std::cout << view.name << ": " << stats.visible << " visible, " << stats.getCulled()
+                      << " culled (scalar " << scalarVisible << ", tree " << treeVisible << ")" << std::endl;
+        }
+
+        // The path Renderer takes: exact bounds kept by the scene's index
+        Scene scene;
+        scene.reserveEntities(count);
+        for (size_t i = 0; i < count; ++i) {
+            Entity* entity = scene.createEntity("Prop");
+            entity->addComponent<Transform>()->setPosition(boxes[i].getCenter());
+            entity->addComponent<MeshRenderer>()->setLocalBounds(AABB(boxes[i].min - boxes[i].getCenter(),
+                                                                      boxes[i].max - boxes[i].getCenter()));
+        }
+        scene.update(0.0f);
+
+        std::vector<Entity*> entities;
+        entities.reserve(count);
+        benchmark.measure("scene cull 100k, player view", 20, [&]() {
+            entities.clear();
+            scene.getSpatialIndex().cull(SpatialIndex::Layer::Renderables, views[0].frustum, entities);
+            doNotOptimize(entities.data());
+        });
+    }
+
+    BenchmarkRegistration registration("FrustumCulling", runFrustumCulling);
+}
@@ -0,0 +1,113 @@
+#include "Benchmark.hpp"
+#include "../src/core/Allocators.hpp"
+#include "../src/core/JobSystem.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/physics/Collider.hpp"
+#include "../src/physics/PhysicsSystem.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+    // One thread means no workers: parallelFor falls back to a plain loop
+    void startJobSystem(unsigned threads) {
+        JobSystem::getInstance().shutdown();
+        if (threads > 1) {
+            JobSystem::getInstance().initialize(threads - 1);
+        }
+    }
+
+    float simulateWork(size_t index, int cost) {
+        float value = static_cast<float>(index);
+        for (int i = 0; i < cost; ++i) {
+            value = std::sin(value) * 0.5f + std::sqrt(value + 1.0f);
+        }
+        return value;
+    }
+
+    void runSynthetic(Benchmark& benchmark) {
+        const size_t itemCount = 200000;
+        std::vector<float> results(itemCount);
+
+        for (unsigned threads : Benchmark::getThreadCounts()) {
+            startJobSystem(threads);
+            JobSystem& jobs = JobSystem::getInstance();
+            std::string suffix = " x" + std::to_string(threads);
+
+            // Every item costs the same
+            benchmark.measure("uniform parallel_for" + suffix, 20, [&]() {
+                jobs.parallelFor(0, itemCount, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        results[i] = simulateWork(i, 16);
+                    }
+                });
+                doNotOptimize(results[itemCount / 2]);
+            });
+
+            // Cost grows with the index, so static splits would leave threads idle
+            benchmark.measure("skewed parallel_for" + suffix, 20, [&]() {
+                jobs.parallelFor(0, itemCount, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        results[i] = simulateWork(i, static_cast<int>(i * 32 / itemCount) + 1);
+                    }
+                });
+                doNotOptimize(results[itemCount / 2]);
+            });
+
+            // Many tiny independent jobs: measures scheduling and stealing overhead
+            benchmark.measure("10k small jobs" + suffix, 20, [&]() {
+                JobCounter counter;
+                for (size_t i = 0; i < 10000; ++i) {
+                    jobs.run([&results, i]() { results[i] = simulateWork(i, 4); }, &counter);
+                }
+                jobs.wait(counter);
+                doNotOptimize(results[0]);
+            });
+        }
+
+        JobSystem::getInstance().shutdown();
+    }
+
+    void runBroadphase(Benchmark& benchmark) {
+        const size_t colliderCount = 3000;
+        const float deltaTime = 1.0f / 60.0f;
+
+        // Static spheres on a jittered grid, so the narrow phase sees a realistic number of pairs
+        Scene scene;
+        for (size_t i = 0; i < colliderCount; ++i) {
+            Entity* entity = scene.createEntity("Sphere");
+            auto transform = entity->addComponent<Transform>();
+            transform->setPosition(glm::vec3(
+                static_cast<float>(i % 20) * 1.5f,
+                static_cast<float>((i / 20) % 15) * 1.5f + std::sin(static_cast<float>(i)) * 0.4f,
+                static_cast<float>(i / 300) * 1.5f));
+            auto sphere = entity->addComponent<SphereCollider>();
+            sphere->setRadius(0.9f);
+        }
+
+        // Components are stable now that every entity has its final archetype
+        PhysicsSystem& physics = PhysicsSystem::getInstance();
+        std::vector<SphereCollider*> spheres;
+        physics.initialize();
+        for (const auto& entity : scene.getEntities()) {
+            spheres.push_back(entity->getComponent<SphereCollider>());
+            physics.addCollider(spheres.back());
+        }
+
+        for (unsigned threads : Benchmark::getThreadCounts()) {
+            startJobSystem(threads);
+            benchmark.measure("broadphase 3000 colliders x" + std::to_string(threads), 5, [&]() {
+                physics.update(deltaTime);
+                FrameArena::resetAll();
+            });
+        }
+
+        for (auto sphere : spheres) {
+            physics.removeCollider(sphere);
+        }
+        JobSystem::getInstance().shutdown();
+    }
+
+    BenchmarkRegistration syntheticRegistration("JobSystem", runSynthetic);
+    BenchmarkRegistration broadphaseRegistration("PhysicsBroadphase", runBroadphase);
+}
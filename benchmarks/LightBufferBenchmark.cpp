@@ -0,0 +1,96 @@
+#include "Benchmark.hpp"
+#include "../src/components/Light.hpp"
+#include "../src/core/Random.hpp"
+#include "../src/renderer/LightBuffer.hpp"
+#include "../src/renderer/Uniforms.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    struct PlacedLight {
+        std::unique_ptr<Light> light;
+        glm::vec3 position;
+        glm::vec3 direction;
+    };
+
+    // Grouped by type as LightManager gathers them: one sun, then a mix of
+    // point and spot lights over a level
+    std::vector<PlacedLight> makeLights(size_t count, Random& random) {
+        std::vector<PlacedLight> lights;
+        lights.push_back({ std::make_unique<Light>(Light::Type::Directional), glm::vec3(0.0f),
+                           glm::normalize(glm::vec3(-0.3f, -1.0f, -0.2f)) });
+        for (size_t i = 1; i < count; ++i) {
+            Light::Type type = i < count * 3 / 4 ? Light::Type::Point : Light::Type::Spot;
+            auto light = std::make_unique<Light>(type);
+            light->setRange(random.range(4.0f, 20.0f));
+            light->setIntensity(random.range(0.5f, 3.0f));
+            light->setSpotAngle(random.range(15.0f, 40.0f));
+            glm::vec3 position(random.range(-200.0f, 200.0f), random.range(1.0f, 8.0f), random.range(-200.0f, 200.0f));
+            lights.push_back({ std::move(light), position, glm::vec3(0.0f, -1.0f, 0.0f) });
+        }
+        return lights;
+    }
+
+    // Per-frame light cost on the CPU. Before the storage buffer every shader
+    // was sent every field of every light (capped at 8 point and 8 spot);
+    // now one pack and one upload serve all shaders.
+    void runLightBuffer(Benchmark& benchmark) {
+        const size_t shaders = 8;
+        Random random(42);
+
+        {
+            // The old path at its cap, through pre-resolved handles (the
+            // cheapest it ever got): 8 point lights, 7 fields, 8 shaders
+            std::vector<UniformInfo> reflection;
+            const char* fields[] = { "position", "color", "intensity", "range", "constant", "linear", "quadratic" };
+            for (size_t i = 0; i < 8; ++i) {
+                for (size_t f = 0; f < 7; ++f) {
+                    std::string name = "pointLights[" + std::to_string(i) + "]." + fields[f];
+                    UniformType type = f < 2 ? UniformType::Vec3 : UniformType::Float;
+                    reflection.push_back({ name, type, static_cast<int32_t>(reflection.size()) });
+                }
+            }
+            std::vector<UniformTable> tables(shaders);
+            for (UniformTable& table : tables) table.build(reflection);
+
+            std::vector<uint32_t> ids;
+            for (const UniformInfo& uniform : reflection) ids.push_back(UniformNames::find(uniform.name));
+
+            // Lights move, so values change every frame
+            float time = 0.0f;
+            size_t uploads = 0;
+            benchmark.measure("per-shader uniforms, 8 lights x 8 shaders", 200, [&]() {
+                time += 1.0f;
+                uploads = 0;
+                for (UniformTable& table : tables) {
+                    for (size_t u = 0; u < reflection.size(); ++u) {
+                        glm::vec3 value(time, static_cast<float>(u), 0.0f);
+                        if (table.write(ids[u], reflection[u].type, &value) >= 0) uploads++;
+                    }
+                }
+                doNotOptimize(uploads);
+            });
+            std::cout << "per-shader uniforms: " << uploads << " uploads per frame" << std::endl;
+        }
+
+        const size_t counts[] = { 8, 256, 1024 };
+        for (size_t count : counts) {
+            std::vector<PlacedLight> lights = makeLights(count, random);
+            LightBuffer buffer;
+            benchmark.measure("pack " + std::to_string(count) + " lights", 200, [&]() {
+                buffer.clear();
+                buffer.reserve(lights.size());
+                for (const PlacedLight& placed : lights) {
+                    buffer.add(*placed.light, placed.position, placed.direction);
+                }
+                doNotOptimize(buffer.getLights().data());
+            });
+            std::cout << count << " lights: 1 upload of " << buffer.getByteSize() << " bytes per frame, shared by "
+                      << shaders << " shaders" << std::endl;
+        }
+    }
+
+    BenchmarkRegistration registration("LightBuffer", runLightBuffer);
+}
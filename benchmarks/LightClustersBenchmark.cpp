@@ -0,0 +1,108 @@
+#include "Benchmark.hpp"
+#include "../src/components/Light.hpp"
+#include "../src/core/JobSystem.hpp"
+#include "../src/core/Random.hpp"
+#include "../src/renderer/LightBuffer.hpp"
+#include "../src/renderer/LightClusters.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    // One thread means no workers: parallelFor falls back to a plain loop
+    void startJobSystem(unsigned threads) {
+        JobSystem::getInstance().shutdown();
+        if (threads > 1) {
+            JobSystem::getInstance().initialize(threads - 1);
+        }
+    }
+
+    // One sun, then point and spot lights scattered over a level around the
+    // camera, spots aimed roughly downwards
+    void fillLights(LightBuffer& buffer, size_t count, Random& random) {
+        Light sun(Light::Type::Directional);
+        buffer.clear();
+        buffer.reserve(count);
+        buffer.add(sun, glm::vec3(0.0f), glm::normalize(glm::vec3(-0.3f, -1.0f, -0.2f)));
+
+        Light point(Light::Type::Point), spot(Light::Type::Spot);
+        for (size_t i = 1; i < count; ++i) {
+            Light& light = i < count * 3 / 4 ? point : spot;
+            light.setRange(random.range(4.0f, 20.0f));
+            light.setSpotAngle(random.range(15.0f, 40.0f));
+            glm::vec3 position(random.range(-200.0f, 200.0f), random.range(1.0f, 8.0f), random.range(-200.0f, 200.0f));
+            glm::vec3 direction(random.range(-0.5f, 0.5f), -1.0f, random.range(-0.5f, 0.5f));
+            buffer.add(light, position, glm::normalize(direction));
+        }
+    }
+
+    // Every cluster's list against a brute-force pass over every light:
+    // point lights must match the scalar sphere-AABB test exactly, spot
+    // lights must be a subset of it. Returns the number of disagreements.
+    size_t verify(const LightClusters& clusters, const LightBuffer& buffer, const glm::mat4& view) {
+        const LightBufferHeader& counts = buffer.getHeader();
+        const std::vector<GpuLight>& lights = buffer.getLights();
+        const uint32_t spotStart = counts.directionalCount + counts.pointCount;
+
+        size_t errors = 0;
+        std::vector<uint32_t> expected;
+        for (uint32_t cluster = 0; cluster < clusters.getClusterCount(); ++cluster) {
+            AABB bounds = clusters.getClusterBounds(cluster);
+            expected.clear();
+            for (uint32_t i = counts.directionalCount; i < lights.size(); ++i) {
+                glm::vec3 position = glm::vec3(view * glm::vec4(glm::vec3(lights[i].positionRange), 1.0f));
+                if (bounds.overlapsSphere(position, lights[i].positionRange.w)) expected.push_back(i);
+            }
+
+            const ClusterRange& range = clusters.getRanges()[cluster];
+            const uint32_t* assigned = clusters.getLightIndices().data() + range.offset;
+            std::vector<uint32_t> actual(assigned, assigned + range.count);
+            std::sort(actual.begin(), actual.end());
+            for (uint32_t index : actual) {
+                if (!std::binary_search(expected.begin(), expected.end(), index)) errors++;
+            }
+            for (uint32_t index : expected) {
+                if (index < spotStart && !std::binary_search(actual.begin(), actual.end(), index)) errors++;
+            }
+        }
+        return errors;
+    }
+
+    // Per-frame CPU cost of clustered light assignment for a 16x9x24 grid
+    void runLightClusters(Benchmark& benchmark) {
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.8f, 0.0f), glm::vec3(0.3f, 1.5f, -1.0f),
+                                           glm::vec3(0.0f, 1.0f, 0.0f));
+        Random random(25);
+
+        const size_t counts[] = { 1024, 4096 };
+        for (size_t count : counts) {
+            LightBuffer buffer;
+            fillLights(buffer, count, random);
+            LightClusters clusters;
+
+            // First build pays for the cluster bounds; later ones reuse them
+            clusters.build(view, projection, 0.1f, 300.0f, buffer);
+            size_t errors = verify(clusters, buffer, view);
+
+            for (unsigned threads : Benchmark::getThreadCounts()) {
+                startJobSystem(threads);
+                benchmark.measure("assign " + std::to_string(count) + " lights x" + std::to_string(threads), 100, [&]() {
+                    clusters.build(view, projection, 0.1f, 300.0f, buffer);
+                    doNotOptimize(clusters.getLightIndices().data());
+                });
+            }
+            JobSystem::getInstance().shutdown();
+
+            const LightClusters::Stats& stats = clusters.getStats();
+            std::cout << count << " lights: " << clusters.getClusterCount() << " clusters, " << stats.assignments
+                      << " assignments, at most " << stats.maxPerCluster << " per cluster, " << stats.emptyClusters
+                      << " empty, " << errors << " disagreements with brute force" << std::endl;
+        }
+    }
+
+    BenchmarkRegistration registration("LightClusters", runLightClusters);
+}
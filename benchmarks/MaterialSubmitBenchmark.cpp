@@ -0,0 +1,293 @@
+#include "Benchmark.hpp"
+#include "../src/core/Random.hpp"
+#include "../src/renderer/Uniforms.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+    const size_t SHADERS = 8;
+    const size_t MATERIALS = 300;
+    const size_t DRAWS = 10000;
+    const size_t POINT_LIGHTS = 8;
+
+    // Uniforms lit.frag-style shaders declare, with made-up locations
+    std::vector<UniformInfo> makeReflection() {
+        std::vector<UniformInfo> uniforms = {
+            { "model", UniformType::Mat4, 0 },
+            { "view", UniformType::Mat4, 1 },
+            { "projection", UniformType::Mat4, 2 },
+            { "viewPos", UniformType::Vec3, 3 },
+            { "material.albedo", UniformType::Vec3, 4 },
+            { "material.metallic", UniformType::Float, 5 },
+            { "material.roughness", UniformType::Float, 6 },
+            { "material.ao", UniformType::Float, 7 },
+            { "emissive", UniformType::Vec3, 8 },
+            { "uvScale", UniformType::Vec2, 9 },
+            { "albedoMap", UniformType::Int, 10 },
+            { "normalMap", UniformType::Int, 11 },
+            { "numPointLights", UniformType::Int, 12 },
+        };
+        const char* fields[] = { "position", "color", "intensity", "range" };
+        for (size_t i = 0; i < POINT_LIGHTS; ++i) {
+            for (size_t f = 0; f < 4; ++f) {
+                std::string name = "pointLights[" + std::to_string(i) + "]." + fields[f];
+                UniformType type = f < 2 ? UniformType::Vec3 : UniformType::Float;
+                uniforms.push_back({ name, type, static_cast<int32_t>(uniforms.size()) });
+            }
+        }
+        return uniforms;
+    }
+
+    struct MaterialValues {
+        glm::vec3 albedo;
+        float metallic;
+        float roughness;
+        float ao;
+        glm::vec3 emissive;
+        glm::vec2 uvScale;
+    };
+
+    struct Light {
+        glm::vec3 position;
+        glm::vec3 color;
+        float intensity;
+        float range;
+    };
+
+    // The old path: values in string-keyed maps, set by name every bind,
+    // with the shader resolving names through its own map. Every set is an upload.
+    struct LegacyShader {
+        std::unordered_map<std::string, int32_t> locations;
+        uint64_t uploads = 0;
+        int64_t checksum = 0;
+
+        void set(const std::string& name) {
+            auto it = locations.find(name);
+            if (it != locations.end()) {
+                uploads++;
+                checksum += it->second;
+            }
+        }
+    };
+
+    struct LegacyMaterial {
+        size_t shader;
+        std::unordered_map<std::string, float> floats;
+        std::unordered_map<std::string, int> ints;
+        std::unordered_map<std::string, glm::vec2> vector2s;
+        std::unordered_map<std::string, glm::vec3> vector3s;
+        std::unordered_map<std::string, glm::vec4> vector4s;
+        std::unordered_map<std::string, glm::mat4> matrix4s;
+
+        void apply(LegacyShader& target) const {
+            for (const auto& entry : floats) target.set(entry.first);
+            for (const auto& entry : ints) target.set(entry.first);
+            for (const auto& entry : vector2s) target.set(entry.first);
+            for (const auto& entry : vector3s) target.set(entry.first);
+            for (const auto& entry : vector4s) target.set(entry.first);
+            for (const auto& entry : matrix4s) target.set(entry.first);
+        }
+    };
+
+    struct HandleMaterial {
+        size_t shader;
+        PropertyBlock properties;
+    };
+
+    struct LightHandles {
+        UniformHandle<glm::vec3> position, color;
+        UniformHandle<float> intensity, range;
+    };
+
+    // A frame's submission from the CPU side: per shader the camera and
+    // lights, per material change its properties, per draw the model matrix
+    void runMaterialSubmit(Benchmark& benchmark) {
+        Random random(MATERIALS);
+        std::vector<UniformInfo> reflection = makeReflection();
+
+        std::vector<MaterialValues> values(MATERIALS);
+        for (MaterialValues& material : values) {
+            material.albedo = glm::vec3(random.range(0.0f, 1.0f), random.range(0.0f, 1.0f), random.range(0.0f, 1.0f));
+            material.metallic = random.nextUInt() % 2 ? 1.0f : 0.0f;
+            material.roughness = random.range(0.1f, 1.0f);
+            material.ao = 1.0f;
+            material.emissive = glm::vec3(0.0f);
+            material.uvScale = glm::vec2(1.0f);
+        }
+        std::vector<Light> lights(POINT_LIGHTS);
+        for (Light& light : lights) {
+            light.position = glm::vec3(random.range(-50.0f, 50.0f), 5.0f, random.range(-50.0f, 50.0f));
+            light.color = glm::vec3(1.0f);
+            light.intensity = random.range(0.5f, 2.0f);
+            light.range = random.range(5.0f, 20.0f);
+        }
+
+        // Draws in render queue order: grouped by shader, then material
+        std::vector<uint32_t> draws(DRAWS);
+        for (uint32_t& draw : draws) {
+            draw = random.nextUInt() % MATERIALS;
+        }
+        std::sort(draws.begin(), draws.end(), [](uint32_t a, uint32_t b) {
+            return std::make_pair(a % SHADERS, a) < std::make_pair(b % SHADERS, b);
+        });
+        std::vector<glm::mat4> models(DRAWS, glm::mat4(1.0f));
+        for (size_t i = 0; i < DRAWS; ++i) {
+            models[i][3] = glm::vec4(static_cast<float>(i), 0.0f, 0.0f, 1.0f);
+        }
+        glm::mat4 view(1.0f), projection(1.0f);
+        glm::vec3 viewPosition(0.0f, 1.8f, 0.0f);
+
+        // Legacy
+        std::vector<LegacyShader> legacyShaders(SHADERS);
+        for (LegacyShader& shader : legacyShaders) {
+            for (const UniformInfo& uniform : reflection) shader.locations[uniform.name] = uniform.location;
+        }
+        std::vector<LegacyMaterial> legacyMaterials(MATERIALS);
+        for (size_t m = 0; m < MATERIALS; ++m) {
+            LegacyMaterial& material = legacyMaterials[m];
+            material.shader = m % SHADERS;
+            material.vector3s["material.albedo"] = values[m].albedo;
+            material.floats["material.metallic"] = values[m].metallic;
+            material.floats["material.roughness"] = values[m].roughness;
+            material.floats["material.ao"] = values[m].ao;
+            material.vector3s["emissive"] = values[m].emissive;
+            material.vector2s["uvScale"] = values[m].uvScale;
+            material.ints["albedoMap"] = 0;
+            material.ints["normalMap"] = 1;
+        }
+
+        auto legacyFrame = [&]() {
+            size_t shader = SIZE_MAX, material = SIZE_MAX;
+            for (uint32_t draw : draws) {
+                LegacyShader& target = legacyShaders[draw % SHADERS];
+                if (draw % SHADERS != shader) {
+                    shader = draw % SHADERS;
+                    material = SIZE_MAX;
+                    target.set("view");
+                    target.set("projection");
+                    target.set("viewPos");
+                    target.set("numPointLights");
+                    for (size_t i = 0; i < POINT_LIGHTS; ++i) {
+                        std::string base = "pointLights[" + std::to_string(i) + "].";
+                        target.set(base + "position");
+                        target.set(base + "color");
+                        target.set(base + "intensity");
+                        target.set(base + "range");
+                    }
+                }
+                if (draw != material) {
+                    material = draw;
+                    legacyMaterials[draw].apply(target);
+                }
+                target.set("model");
+            }
+        };
+
+        uint64_t legacyUploads = 0;
+        benchmark.measure("legacy string maps, 300 materials", 50, [&]() {
+            for (LegacyShader& shader : legacyShaders) shader.uploads = 0;
+            legacyFrame();
+            legacyUploads = 0;
+            for (LegacyShader& shader : legacyShaders) legacyUploads += shader.uploads;
+            doNotOptimize(legacyShaders[0].checksum);
+        });
+
+        // Handles
+        std::vector<UniformTable> tables(SHADERS);
+        for (UniformTable& table : tables) table.build(reflection);
+
+        const UniformHandle<glm::vec3> albedo("material.albedo");
+        const UniformHandle<float> metallic("material.metallic");
+        const UniformHandle<float> roughness("material.roughness");
+        const UniformHandle<float> ao("material.ao");
+        const UniformHandle<glm::vec3> emissive("emissive");
+        const UniformHandle<glm::vec2> uvScale("uvScale");
+        const UniformHandle<int> albedoMap("albedoMap");
+        const UniformHandle<int> normalMap("normalMap");
+        const UniformHandle<glm::mat4> modelHandle("model");
+        const UniformHandle<glm::mat4> viewHandle("view");
+        const UniformHandle<glm::mat4> projectionHandle("projection");
+        const UniformHandle<glm::vec3> viewPositionHandle("viewPos");
+        const UniformHandle<int> numPointLights("numPointLights");
+        std::vector<LightHandles> lightHandles(POINT_LIGHTS);
+        for (size_t i = 0; i < POINT_LIGHTS; ++i) {
+            std::string base = "pointLights[" + std::to_string(i) + "].";
+            lightHandles[i] = { UniformHandle<glm::vec3>(base + "position"), UniformHandle<glm::vec3>(base + "color"),
+                                UniformHandle<float>(base + "intensity"), UniformHandle<float>(base + "range") };
+        }
+
+        std::vector<HandleMaterial> materials(MATERIALS);
+        for (size_t m = 0; m < MATERIALS; ++m) {
+            HandleMaterial& material = materials[m];
+            material.shader = m % SHADERS;
+            material.properties.set(albedo, values[m].albedo);
+            material.properties.set(metallic, values[m].metallic);
+            material.properties.set(roughness, values[m].roughness);
+            material.properties.set(ao, values[m].ao);
+            material.properties.set(emissive, values[m].emissive);
+            material.properties.set(uvScale, values[m].uvScale);
+            material.properties.set(albedoMap, 0);
+            material.properties.set(normalMap, 1);
+        }
+
+        uint64_t uploads = 0;
+        int64_t checksum = 0;
+        auto upload = [&](int32_t location, UniformType, const void*) {
+            uploads++;
+            checksum += location;
+        };
+        auto write = [&](UniformTable& table, uint32_t id, UniformType type, const void* value) {
+            int32_t location = table.write(id, type, value);
+            if (location >= 0) upload(location, type, value);
+        };
+
+        auto handleFrame = [&]() {
+            size_t shader = SIZE_MAX, material = SIZE_MAX;
+            for (size_t d = 0; d < DRAWS; ++d) {
+                uint32_t draw = draws[d];
+                UniformTable& table = tables[draw % SHADERS];
+                if (draw % SHADERS != shader) {
+                    shader = draw % SHADERS;
+                    material = SIZE_MAX;
+                    write(table, viewHandle.getId(), UniformType::Mat4, &view);
+                    write(table, projectionHandle.getId(), UniformType::Mat4, &projection);
+                    write(table, viewPositionHandle.getId(), UniformType::Vec3, &viewPosition);
+                    int lightCount = static_cast<int>(POINT_LIGHTS);
+                    write(table, numPointLights.getId(), UniformType::Int, &lightCount);
+                    for (size_t i = 0; i < POINT_LIGHTS; ++i) {
+                        write(table, lightHandles[i].position.getId(), UniformType::Vec3, &lights[i].position);
+                        write(table, lightHandles[i].color.getId(), UniformType::Vec3, &lights[i].color);
+                        write(table, lightHandles[i].intensity.getId(), UniformType::Float, &lights[i].intensity);
+                        write(table, lightHandles[i].range.getId(), UniformType::Float, &lights[i].range);
+                    }
+                }
+                if (draw != material) {
+                    material = draw;
+                    materials[draw].properties.apply(table, upload);
+                }
+                write(table, modelHandle.getId(), UniformType::Mat4, &models[d]);
+            }
+        };
+
+        // The first frame uploads everything; later ones only what changed
+        uploads = 0;
+        handleFrame();
+        uint64_t firstFrameUploads = uploads;
+
+        benchmark.measure("handles + property blocks, 300 materials", 50, [&]() {
+            uploads = 0;
+            handleFrame();
+            doNotOptimize(checksum);
+        });
+
+        std::cout << "uploads per frame: " << legacyUploads << " legacy, " << firstFrameUploads
+                  << " first frame with handles, " << uploads << " steady state" << std::endl;
+    }
+
+    BenchmarkRegistration registration("MaterialSubmit", runMaterialSubmit);
+}
@@ -0,0 +1,52 @@
+#include "Benchmark.hpp"
+#include "../src/sculpting/MeshIO.hpp"
+#include "../src/sculpting/SculptMesh.hpp"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace {
+    // OBJ text parsing and the binary format on the same meshes, so the two
+    // load paths compare directly
+    void runMeshIO(Benchmark& benchmark) {
+        const size_t vertexCounts[] = { 100000, 1000000 };
+        const auto directory = std::filesystem::temp_directory_path();
+        const std::string objPath = (directory / "engine_meshio_benchmark.obj").string();
+        const std::string binaryPath = (directory / "engine_meshio_benchmark.smsh").string();
+
+        for (size_t vertices : vertexCounts) {
+            int cells = static_cast<int>(std::sqrt(static_cast<double>(vertices))) - 1;
+            SculptMesh source;
+            source.initializeAsPlane(10.0f, 10.0f, cells);
+
+            size_t iterations = vertices >= 1000000 ? 3 : 10;
+            std::string suffix = " " + std::to_string(vertices / 1000) + "k verts";
+
+            if (!MeshIO::saveToOBJ(source, objPath)) {
+                std::cerr << "Could not write " << objPath << std::endl;
+                return;
+            }
+            std::cout << "OBJ size: " << std::filesystem::file_size(objPath) / 1024 << " KiB" << std::endl;
+
+            SculptMesh loaded;
+            benchmark.measure("parse OBJ" + suffix, iterations, [&]() {
+                MeshIO::loadFromOBJ(loaded, objPath);
+                doNotOptimize(loaded.getVertices().data());
+            });
+            benchmark.measure("save binary" + suffix, iterations, [&]() {
+                MeshIO::saveToBinary(source, binaryPath);
+            });
+            benchmark.measure("load binary" + suffix, iterations, [&]() {
+                MeshIO::loadFromBinary(loaded, binaryPath);
+                doNotOptimize(loaded.getVertices().data());
+            });
+        }
+
+        std::remove(objPath.c_str());
+        std::remove(binaryPath.c_str());
+    }
+
+    BenchmarkRegistration registration("MeshIO", runMeshIO);
+}
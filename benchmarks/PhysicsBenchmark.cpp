@@ -0,0 +1,77 @@
+#include "Benchmark.hpp"
+#include "../src/core/Allocators.hpp"
+#include "../src/core/JobSystem.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/physics/CapsuleCollider.hpp"
+#include "../src/physics/Collider.hpp"
+#include "../src/physics/PhysicsSystem.hpp"
+#include <cmath>
+#include <string>
+
+namespace {
+    // Colliders on a cube-ish grid. With a wide spacing no bounds overlap and
+    // the update is all broad phase; a tight one hands every neighbour pair to
+    // the narrow phase.
+    void buildColliders(Scene& scene, size_t count, float spacing) {
+        const size_t side = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(count))));
+        for (size_t i = 0; i < count; ++i) {
+            Entity* entity = scene.createEntity("Body");
+            entity->addComponent<Transform>()->setPosition(glm::vec3(
+                static_cast<float>(i % side) * spacing,
+                static_cast<float>((i / side) % side) * spacing + std::sin(static_cast<float>(i)) * 0.2f,
+                static_cast<float>(i / (side * side)) * spacing));
+
+            // Mixed shapes so every narrow-phase pairing is exercised
+            switch (i % 3) {
+                case 0:
+                    entity->addComponent<SphereCollider>()->setRadius(0.9f);
+                    break;
+                case 1:
+                    entity->addComponent<BoxCollider>()->setSize(glm::vec3(1.6f));
+                    break;
+                default: {
+                    auto capsule = entity->addComponent<CapsuleCollider>();
+                    capsule->setRadius(0.6f);
+                    capsule->setHeight(1.8f);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Single-threaded so counts compare directly; JobSystem covers thread scaling
+    void runPhysics(Benchmark& benchmark) {
+        const size_t counts[] = { 500, 1000, 2000, 4000 };
+        const float deltaTime = 1.0f / 60.0f;
+
+        JobSystem::getInstance().shutdown();
+        PhysicsSystem& physics = PhysicsSystem::getInstance();
+        physics.initialize();
+
+        for (size_t count : counts) {
+            // Quadratic broad phase: keep the total work per count roughly level
+            size_t iterations = 4000000 / (count * count) + 3;
+            std::string suffix = " " + std::to_string(count);
+
+            {
+                Scene scene;
+                buildColliders(scene, count, 4.0f);
+                benchmark.measure("broadphase only" + suffix, iterations, [&]() {
+                    physics.update(deltaTime);
+                    FrameArena::resetAll();
+                });
+            }
+            {
+                Scene scene;
+                buildColliders(scene, count, 1.5f);
+                benchmark.measure("broad + narrow phase" + suffix, iterations, [&]() {
+                    physics.update(deltaTime);
+                    FrameArena::resetAll();
+                });
+            }
+        }
+    }
+
+    BenchmarkRegistration registration("Physics", runPhysics);
+}
@@ -0,0 +1,99 @@
+#include "Benchmark.hpp"
+#include "../src/scene/Prefab.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/gameplay/AIController.hpp"
+#include "../src/gameplay/HealthSystem.hpp"
+#include "../src/gameplay/WeaponSystem.hpp"
+#include "../src/physics/CapsuleCollider.hpp"
+#include "../src/physics/RigidBody.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+    WeaponData makeRifle() {
+        WeaponData rifle;
+        rifle.name = "Assault Rifle";
+        rifle.damage = 10.0f;
+        rifle.fireRate = 5.0f;
+        rifle.reloadTime = 2.0f;
+        rifle.magazineSize = 30;
+        rifle.range = 100.0f;
+        rifle.spread = 2.0f;
+        rifle.automatic = true;
+        rifle.recoilVertical = 0.1f;
+        rifle.recoilHorizontal = 0.05f;
+        rifle.recoilRecovery = 5.0f;
+        rifle.idleAnim = "rifle_idle";
+        rifle.fireAnim = "rifle_fire";
+        rifle.reloadAnim = "rifle_reload";
+        return rifle;
+    }
+
+    // Same bot as the headless run: physics body, capsule, AI, weapon, health
+    void setUpBot(Entity& bot, const WeaponData& rifle) {
+        bot.addComponent<Transform>();
+        bot.addComponent<RigidBody>()->setMass(70.0f);
+
+        auto capsule = bot.addComponent<CapsuleCollider>();
+        capsule->setRadius(0.3f);
+        capsule->setHeight(1.8f);
+
+        bot.addComponent<AIController>()->setState(AIController::State::Patrol);
+        bot.addComponent<WeaponSystem>()->addWeapon(rifle);
+        bot.addComponent<HealthSystem>()->setMaxHealth(100.0f);
+    }
+
+    // Spawning a wave of bots in one frame, entity by entity and from a
+    // prefab. Both place the bots afterwards, as a spawner would. Every bot
+    // registers its capsule and rigid body with PhysicsSystem, so this also
+    // times that registration.
+    void runPrefab(Benchmark& benchmark) {
+        const size_t bots = 10000;
+        const WeaponData rifle = makeRifle();
+
+        auto place = [](const std::vector<Entity*>& spawned) {
+            for (size_t i = 0; i < spawned.size(); ++i) {
+                glm::vec3 spawn(static_cast<float>(i % 100) * 2.0f, 1.0f, static_cast<float>(i / 100) * 2.0f);
+                spawned[i]->getComponent<Transform>()->setPosition(spawn);
+            }
+        };
+
+        // Scenes are kept alive until after timing so teardown is not measured
+        std::vector<std::unique_ptr<Scene>> scenes;
+
+        benchmark.measure("spawn 10k bots, per component", 3, [&]() {
+            scenes.push_back(std::make_unique<Scene>());
+            Scene& scene = *scenes.back();
+            scene.reserveEntities(bots);
+
+            std::vector<Entity*> spawned;
+            spawned.reserve(bots);
+            for (size_t i = 0; i < bots; ++i) {
+                Entity* bot = scene.createEntity("Bot");
+                setUpBot(*bot, rifle);
+                spawned.push_back(bot);
+            }
+            place(spawned);
+        });
+        scenes.clear();
+
+        Prefab prefab("Bot");
+        prefab.addComponent<Transform>();
+        prefab.addComponent<RigidBody>()->setMass(70.0f);
+        auto capsule = prefab.addComponent<CapsuleCollider>();
+        capsule->setRadius(0.3f);
+        capsule->setHeight(1.8f);
+        prefab.addComponent<AIController>()->setState(AIController::State::Patrol);
+        prefab.addComponent<WeaponSystem>()->addWeapon(rifle);
+        prefab.addComponent<HealthSystem>()->setMaxHealth(100.0f);
+
+        benchmark.measure("spawn 10k bots, prefab", 3, [&]() {
+            scenes.push_back(std::make_unique<Scene>());
+            place(prefab.instantiate(*scenes.back(), bots));
+        });
+        scenes.clear();
+    }
+
+    BenchmarkRegistration registration("Prefab", runPrefab);
+}
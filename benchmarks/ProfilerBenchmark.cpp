@@ -0,0 +1,49 @@
+#include "Benchmark.hpp"
+#include "../src/core/Profiler.hpp"
+#include <iostream>
+
+namespace {
+    // Uses ProfileScope directly so the cost is measured even when the
+    // PROFILE_* macros are compiled out
+    void runProfiler(Benchmark& benchmark) {
+        const size_t scopeCount = 100000;
+        Profiler& profiler = Profiler::getInstance();
+        float value = 0.0f;
+
+        profiler.setEnabled(false);
+        benchmark.measure("100k scopes, disabled", 20, [&]() {
+            for (size_t i = 0; i < scopeCount; ++i) {
+                ProfileScope scope("Benchmark");
+                value += 1.0f;
+            }
+            doNotOptimize(value);
+        });
+
+        profiler.setEnabled(true);
+        benchmark.measure("100k scopes, recording", 20, [&]() {
+            for (size_t i = 0; i < scopeCount; ++i) {
+                ProfileScope scope("Benchmark");
+                value += 1.0f;
+            }
+            doNotOptimize(value);
+            profiler.endFrame();
+        });
+
+        benchmark.measure("100k nested scopes, recording", 20, [&]() {
+            for (size_t i = 0; i < scopeCount / 4; ++i) {
+                ProfileScope outer("Outer");
+                for (int j = 0; j < 3; ++j) {
+                    ProfileScope inner("Inner");
+                    value += 1.0f;
+                }
+            }
+            doNotOptimize(value);
+            profiler.endFrame();
+        });
+
+        std::cout << "retained frames: " << profiler.getFrames().size() << std::endl;
+        profiler.clear();
+    }
+
+    BenchmarkRegistration registration("Profiler", runProfiler);
+}
@@ -0,0 +1,97 @@
+#include "Benchmark.hpp"
+#include "../src/core/Random.hpp"
+#include "../src/renderer/RenderQueue.hpp"
+#include <iostream>
+#include <vector>
+
+namespace {
+    // Stands in for GL: counts calls and touches the packet like a real
+    // backend would read the instance's matrix
+    class CountingBackend : public RenderBackend {
+    public:
+        void bindShader(uint16_t shader) override { checksum += shader; }
+        void bindMaterial(uint16_t material) override { checksum += material; }
+        void bindMesh(uint16_t mesh) override { checksum += mesh; }
+        void draw(const RenderPacket& packet) override { checksum += packet.instance; }
+
+        uint64_t checksum = 0;
+    };
+
+    struct Draw {
+        uint16_t shader;
+        uint16_t material;
+        uint16_t mesh;
+        float depth;
+    };
+
+    // A level's worth of draws in entity order: a handful of shaders, a few
+    // hundred materials each tied to one shader, and shared meshes
+    std::vector<Draw> makeDraws(size_t count, Random& random) {
+        const uint32_t shaders = 8, materials = 300, meshes = 120;
+        std::vector<Draw> draws(count);
+        for (Draw& draw : draws) {
+            draw.material = static_cast<uint16_t>(random.nextUInt() % materials);
+            draw.shader = static_cast<uint16_t>(draw.material % shaders);
+            draw.mesh = static_cast<uint16_t>(random.nextUInt() % meshes);
+            draw.depth = random.range(0.5f, 300.0f);
+        }
+        return draws;
+    }
+
+    void fill(RenderQueue& queue, const std::vector<Draw>& draws) {
+        queue.clear();
+        for (size_t i = 0; i < draws.size(); ++i) {
+            const Draw& draw = draws[i];
+            queue.push(RenderPass::Opaque, draw.shader, draw.material, draw.mesh, draw.depth, static_cast<uint32_t>(i));
+        }
+    }
+
+    void runRenderQueue(Benchmark& benchmark) {
+        const size_t counts[] = { 1000, 10000, 100000 };
+
+        for (size_t count : counts) {
+            std::string suffix = " " + std::to_string(count);
+            Random random(count);
+            std::vector<Draw> draws = makeDraws(count, random);
+            RenderQueue queue;
+            queue.reserve(count);
+            CountingBackend backend;
+            size_t iterations = 1000000 / count + 5;
+
+            // Submission in entity order is what every frame paid before the queue
+            fill(queue, draws);
+            RenderStats unsorted = queue.submit(backend);
+
+            benchmark.measure("fill" + suffix, iterations, [&]() {
+                fill(queue, draws);
+            });
+            benchmark.measure("fill + sort" + suffix, iterations, [&]() {
+                fill(queue, draws);
+                queue.sort();
+            });
+            RenderStats sorted;
+            benchmark.measure("fill + sort + submit" + suffix, iterations, [&]() {
+                fill(queue, draws);
+                queue.sort();
+                sorted = queue.submit(backend);
+            });
+            doNotOptimize(backend.checksum);
+
+            // Sanity check on the sort, since the benchmark is the only harness that runs it
+            const std::vector<RenderPacket>& packets = queue.getPackets();
+            for (size_t i = 1; i < packets.size(); ++i) {
+                if (packets[i - 1].sortKey > packets[i].sortKey) {
+                    std::cerr << "RenderQueue: packets out of order at " << i << std::endl;
+                    break;
+                }
+            }
+
+            std::cout << "draws" << suffix << ": state changes " << unsorted.getStateChanges()
+                      << " unsorted, " << sorted.getStateChanges() << " sorted (shader "
+                      << sorted.shaderChanges << ", material " << sorted.materialChanges
+                      << ", mesh " << sorted.meshChanges << ")" << std::endl;
+        }
+    }
+
+    BenchmarkRegistration registration("RenderQueue", runRenderQueue);
+}
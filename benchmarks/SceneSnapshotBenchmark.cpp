@@ -0,0 +1,85 @@
+#include "Benchmark.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/scene/SceneSnapshot.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/components/Light.hpp"
+#include "../src/physics/Collider.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    // Level-like content: clusters of ten transforms under one root, half
+    // of them with a sphere collider, some boxes and a light per hundred
+    void buildLevel(Scene& scene, size_t count) {
+        Entity* root = nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            Entity* entity = scene.createEntity("Prop");
+            Transform* transform = entity->addComponent<Transform>();
+            transform->setPosition(glm::vec3(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100)));
+
+            // Component pointers move with the archetype, so hold the entity
+            if (i % 10 == 0) {
+                root = entity;
+            } else {
+                transform->setParent(root->getComponent<Transform>());
+            }
+
+            if (i % 2 == 0) {
+                entity->addComponent<SphereCollider>()->setRadius(0.5f);
+            } else if (i % 5 == 1) {
+                entity->addComponent<BoxCollider>()->setSize(glm::vec3(1.0f, 2.0f, 1.0f));
+            }
+            if (i % 100 == 0) {
+                Light* light = entity->addComponent<Light>(Light::Type::Point);
+                light->setRange(10.0f);
+            }
+        }
+    }
+
+    void runSnapshot(Benchmark& benchmark) {
+        const size_t count = 100000;
+        const std::string path =
+            (std::filesystem::temp_directory_path() / "engine_snapshot_benchmark.scnb").string();
+
+        // Scenes are kept alive until after timing so teardown is not measured
+        std::vector<std::unique_ptr<Scene>> scenes;
+
+        benchmark.measure("build in code 100k", 3, [&]() {
+            scenes.push_back(std::make_unique<Scene>());
+            buildLevel(*scenes.back(), count);
+        });
+
+        std::vector<std::byte> blob;
+        benchmark.measure("serialize 100k", 3, [&]() {
+            blob = SceneSnapshot::serialize(*scenes.front());
+        });
+        std::cout << "snapshot size: " << blob.size() / 1024 << " KiB" << std::endl;
+
+        SceneSnapshot::save(*scenes.front(), path);
+        scenes.clear();
+
+        benchmark.measure("instantiate from memory 100k", 3, [&]() {
+            scenes.push_back(std::make_unique<Scene>());
+            SceneSnapshot::instantiate(*scenes.back(), blob.data(), blob.size());
+        });
+
+        // Loaded entities come back in snapshot order, so a faithful load
+        // serializes to the same bytes
+        bool identical = SceneSnapshot::serialize(*scenes.front()) == blob;
+        std::cout << "round trip: " << (identical ? "identical" : "DIFFERS") << std::endl;
+        scenes.clear();
+
+        benchmark.measure("load mapped file 100k", 3, [&]() {
+            scenes.push_back(std::make_unique<Scene>());
+            SceneSnapshot::load(*scenes.back(), path);
+        });
+        scenes.clear();
+
+        std::remove(path.c_str());
+    }
+
+    BenchmarkRegistration registration("SceneSnapshot", runSnapshot);
+}
@@ -0,0 +1,64 @@
+#include "Benchmark.hpp"
+#include "../src/scene/Scene.hpp"
+#include "../src/components/Transform.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+    // Cheap gameplay-style component so the benchmark measures iteration cost
+    class Spinner : public Component {
+    public:
+        void update(float deltaTime) override {
+            angle += speed * deltaTime;
+        }
+
+        float angle = 0.0f;
+        float speed = 90.0f;
+    };
+
+    // Previous layout: one heap allocation per component, ticked entity by entity
+    struct LegacyEntity {
+        std::vector<std::unique_ptr<Component>> components;
+
+        void update(float deltaTime) {
+            for (auto& component : components) {
+                component->update(deltaTime);
+            }
+        }
+    };
+
+    void runSceneUpdate(Benchmark& benchmark) {
+        const size_t counts[] = { 1000, 10000, 100000 };
+        const float deltaTime = 1.0f / 60.0f;
+
+        for (size_t count : counts) {
+            std::vector<std::unique_ptr<LegacyEntity>> legacy;
+            legacy.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                auto entity = std::make_unique<LegacyEntity>();
+                entity->components.push_back(std::make_unique<Transform>());
+                entity->components.push_back(std::make_unique<Spinner>());
+                legacy.push_back(std::move(entity));
+            }
+
+            Scene scene;
+            for (size_t i = 0; i < count; ++i) {
+                Entity* entity = scene.createEntity();
+                entity->addComponent<Transform>();
+                entity->addComponent<Spinner>();
+            }
+
+            size_t iterations = 1000000 / count + 10;
+            benchmark.measure("legacy unique_ptr " + std::to_string(count), iterations, [&]() {
+                for (auto& entity : legacy) {
+                    entity->update(deltaTime);
+                }
+            });
+            benchmark.measure("archetype chunks " + std::to_string(count), iterations, [&]() {
+                scene.update(deltaTime);
+            });
+        }
+    }
+
+    BenchmarkRegistration registration("SceneUpdate", runSceneUpdate);
+}
@@ -0,0 +1,54 @@
+#include "Benchmark.hpp"
+#include "../src/sculpting/SculptMesh.hpp"
+#include <cmath>
+#include <string>
+
+namespace {
+    std::string vertexLabel(size_t vertices) {
+        return vertices >= 1000000 ? std::to_string(vertices / 1000000) + "M"
+                                   : std::to_string(vertices / 1000) + "k";
+    }
+
+    // Brush dabs on a unit plane; the radius covers about 1% of the surface,
+    // so each dab touches a fixed share of the vertices at every density
+    void runSculpt(Benchmark& benchmark) {
+        const size_t vertexCounts[] = { 100000, 1000000, 5000000 };
+        const float radius = 0.056f;
+
+        for (size_t vertices : vertexCounts) {
+            int cells = static_cast<int>(std::sqrt(static_cast<double>(vertices))) - 1;
+            SculptMesh mesh;
+            mesh.initializeAsPlane(1.0f, 1.0f, cells);
+
+            size_t iterations = 10000000 / vertices + 2;
+            std::string suffix = " " + vertexLabel(vertices);
+
+            // Dabs walk along a diagonal so consecutive strokes do not stack
+            size_t dab = 0;
+            auto nextDab = [&]() {
+                float t = static_cast<float>(dab++ % 16) / 16.0f;
+                return glm::vec3(t - 0.4f, 0.0f, 0.4f - t);
+            };
+
+            benchmark.measure("pull" + suffix, iterations, [&]() {
+                mesh.pull(nextDab(), radius, 0.5f);
+                doNotOptimize(mesh.getVertices().data());
+            });
+            benchmark.measure("smooth" + suffix, iterations, [&]() {
+                mesh.smooth(nextDab(), radius, 0.5f);
+                doNotOptimize(mesh.getVertices().data());
+            });
+            benchmark.measure("inflate" + suffix, iterations, [&]() {
+                mesh.inflate(nextDab(), radius, 0.5f);
+                doNotOptimize(mesh.getVertices().data());
+            });
+            // Every brush ends with this; shows how much of a dab it is
+            benchmark.measure("recalculateNormals" + suffix, iterations, [&]() {
+                mesh.recalculateNormals();
+                doNotOptimize(mesh.getVertices().data());
+            });
+        }
+    }
+
+    BenchmarkRegistration registration("SculptBrush", runSculpt);
+}
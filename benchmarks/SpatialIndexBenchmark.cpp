@@ -0,0 +1,150 @@
+#include "Benchmark.hpp"
+#include "../src/components/MeshRenderer.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/core/Random.hpp"
+#include "../src/scene/DynamicAABBTree.hpp"
+#include "../src/scene/Scene.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+    // Objects scattered over a 1 km square, a few metres tall, like a level
+    std::vector<AABB> makeBoxes(size_t count, Random& random) {
+        std::vector<AABB> boxes(count);
+        for (AABB& box : boxes) {
+            glm::vec3 center(random.range(-500.0f, 500.0f), random.range(0.0f, 10.0f), random.range(-500.0f, 500.0f));
+            glm::vec3 extents(random.range(0.25f, 2.0f));
+            box = AABB(center - extents, center + extents);
+        }
+        return boxes;
+    }
+
+    glm::vec3 randomDirection(Random& random) {
+        return glm::normalize(glm::vec3(random.range(-1.0f, 1.0f), random.range(-0.1f, 0.1f), random.range(-1.0f, 1.0f)));
+    }
+
+    void runSpatialIndex(Benchmark& benchmark) {
+        const size_t counts[] = { 10000, 100000 };
+        const size_t queries = 1000;
+
+        for (size_t count : counts) {
+            std::string suffix = " " + std::to_string(count);
+            Random random(count);
+            std::vector<AABB> boxes = makeBoxes(count, random);
+            size_t iterations = 1000000 / count + 3;
+
+            DynamicAABBTree tree;
+            benchmark.measure("build" + suffix, iterations, [&]() {
+                tree.clear();
+                for (size_t i = 0; i < count; ++i) {
+                    tree.createProxy(boxes[i], &boxes[i]);
+                }
+            });
+
+            // Query inputs are fixed up front so every variant sees the same work
+            std::vector<glm::vec3> origins(queries), directions(queries);
+            for (size_t i = 0; i < queries; ++i) {
+                origins[i] = glm::vec3(random.range(-500.0f, 500.0f), 1.8f, random.range(-500.0f, 500.0f));
+                directions[i] = randomDirection(random);
+            }
+
+            benchmark.measure("1000 AABB queries" + suffix, 20, [&]() {
+                size_t hits = 0;
+                for (const glm::vec3& origin : origins) {
+                    tree.query(AABB(origin - glm::vec3(10.0f), origin + glm::vec3(10.0f)),
+                        [&hits](int32_t) { ++hits; return true; });
+                }
+                doNotOptimize(hits);
+            });
+
+            benchmark.measure("1000 sphere queries" + suffix, 20, [&]() {
+                size_t hits = 0;
+                for (const glm::vec3& origin : origins) {
+                    tree.querySphere(origin, 10.0f, [&hits](int32_t) { ++hits; return true; });
+                }
+                doNotOptimize(hits);
+            });
+
+            // A player's view: 90 degree FOV, 200 m draw distance
+            glm::mat4 projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+            benchmark.measure("100 frustum queries" + suffix, 20, [&]() {
+                size_t visible = 0;
+                for (size_t i = 0; i < 100; ++i) {
+                    glm::mat4 view = glm::lookAt(origins[i], origins[i] + directions[i], glm::vec3(0.0f, 1.0f, 0.0f));
+                    tree.queryFrustum(Frustum::fromMatrix(projection * view),
+                        [&visible](int32_t) { ++visible; return true; });
+                }
+                doNotOptimize(visible);
+            });
+
+            // Closest hit within weapon range, narrow phase against the exact box
+            auto closestHit = [&](const glm::vec3& origin, const glm::vec3& direction) {
+                glm::vec3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+                float closest = 100.0f;
+                tree.raycast(origin, direction, closest, [&](int32_t proxy, float maxDistance) {
+                    float distance;
+                    const AABB& box = *static_cast<const AABB*>(tree.getUserData(proxy));
+                    if (box.intersectRay(origin, inverse, maxDistance, distance)) {
+                        closest = distance;
+                        return distance;
+                    }
+                    return maxDistance;
+                });
+                return closest;
+            };
+            benchmark.measure("1000 raycasts" + suffix, 20, [&]() {
+                float total = 0.0f;
+                for (size_t i = 0; i < queries; ++i) {
+                    total += closestHit(origins[i], directions[i]);
+                }
+                doNotOptimize(total);
+            });
+
+            // What every raycast cost before the index
+            benchmark.measure("1000 raycasts, linear scan" + suffix, count > 10000 ? 2 : 5, [&]() {
+                float total = 0.0f;
+                for (size_t i = 0; i < queries; ++i) {
+                    glm::vec3 inverse(1.0f / directions[i].x, 1.0f / directions[i].y, 1.0f / directions[i].z);
+                    float closest = 100.0f;
+                    for (const AABB& box : boxes) {
+                        float distance;
+                        if (box.intersectRay(origins[i], inverse, closest, distance)) {
+                            closest = distance;
+                        }
+                    }
+                    total += closest;
+                }
+                doNotOptimize(total);
+            });
+
+            // Scene upkeep: a tenth of the renderers move each tick
+            Scene scene;
+            std::vector<Transform*> moving;
+            for (size_t i = 0; i < count; ++i) {
+                Entity* entity = scene.createEntity("Prop");
+                auto transform = entity->addComponent<Transform>();
+                transform->setPosition(boxes[i].getCenter());
+                entity->addComponent<MeshRenderer>()->setLocalBounds(AABB(boxes[i].min - boxes[i].getCenter(),
+                                                                          boxes[i].max - boxes[i].getCenter()));
+            }
+            scene.update(0.0f);
+            for (size_t i = 0; i < count; i += 10) {
+                moving.push_back(scene.getEntities()[i]->getComponent<Transform>());
+            }
+
+            float step = 0.0f;
+            benchmark.measure("scene update, 10% moving" + suffix, iterations * 10, [&]() {
+                step += 1.0f;
+                glm::vec3 offset(std::sin(step) * 0.05f, 0.0f, std::cos(step) * 0.05f);
+                for (Transform* transform : moving) {
+                    transform->translate(offset);
+                }
+                scene.update(1.0f / 60.0f);
+            });
+        }
+    }
+
+    BenchmarkRegistration registration("SpatialIndex", runSpatialIndex);
+}
@@ -0,0 +1,81 @@
+#include "Benchmark.hpp"
+#include "../src/core/JobSystem.hpp"
+#include "../src/scene/Scene.hpp"
+#include <cmath>
+#include <iostream>
+
+namespace {
+    // Independent gameplay-style components: each only touches itself, so
+    // their systems can all run at once
+    template<int N>
+    class Simulated : public Component {
+    public:
+        void update(float deltaTime) override {
+            for (int i = 0; i < 32; ++i) {
+                value = std::sin(value + deltaTime) * 0.5f + 0.5f;
+            }
+        }
+
+        float value = 0.0f;
+    };
+
+    // Reads one of the above, so it has to wait for that system
+    class Follower : public Component {
+    public:
+        void update(float deltaTime) override {
+            value += getEntity()->getComponent<Simulated<0>>()->value * deltaTime;
+        }
+
+        float value = 0.0f;
+    };
+
+    template<int N>
+    void addSimulated(Scene& scene, Entity* entity) {
+        entity->addComponent<Simulated<N>>();
+        scene.declareComponentAccess<Simulated<N>>("Simulated" + std::to_string(N),
+            SystemAccess().write<Simulated<N>>());
+    }
+
+    void runScheduler(Benchmark& benchmark) {
+        const size_t entityCount = 10000;
+        const float deltaTime = 1.0f / 60.0f;
+
+        Scene scene;
+        for (size_t i = 0; i < entityCount; ++i) {
+            Entity* entity = scene.createEntity();
+            addSimulated<0>(scene, entity);
+            addSimulated<1>(scene, entity);
+            addSimulated<2>(scene, entity);
+            addSimulated<3>(scene, entity);
+            addSimulated<4>(scene, entity);
+            addSimulated<5>(scene, entity);
+            addSimulated<6>(scene, entity);
+            addSimulated<7>(scene, entity);
+            entity->addComponent<Follower>();
+        }
+        scene.declareComponentAccess<Follower>("Follower",
+            SystemAccess().write<Follower>().read<Simulated<0>>());
+
+        auto counts = Benchmark::getThreadCounts();
+        for (unsigned threads : counts) {
+            JobSystem::getInstance().shutdown();
+            if (threads > 1) {
+                JobSystem::getInstance().initialize(threads - 1);
+            }
+
+            benchmark.measure("9 systems 10k entities x" + std::to_string(threads), 20, [&]() {
+                scene.update(deltaTime);
+            });
+        }
+
+        // Show how the systems overlapped at the widest thread count
+        scene.getScheduler().setTimelineEnabled(true);
+        scene.update(deltaTime);
+        scene.getScheduler().dumpTimeline(std::cout);
+        scene.getScheduler().setTimelineEnabled(false);
+
+        JobSystem::getInstance().shutdown();
+    }
+
+    BenchmarkRegistration registration("SystemScheduler", runScheduler);
+}
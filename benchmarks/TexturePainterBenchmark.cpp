@@ -0,0 +1,36 @@
+#include "Benchmark.hpp"
+#include "../src/sculpting/TexturePainter.hpp"
+#include <string>
+
+namespace {
+    // Base layer plus one half-transparent overlay, composited on the CPU.
+    // An 8K RGBA layer is 256 MiB, so the painter is rebuilt per size.
+    void runCompositing(Benchmark& benchmark) {
+        const int sizes[] = { 2048, 4096, 8192 };
+
+        for (int size : sizes) {
+            TexturePainter painter;
+            painter.initialize(size, size);
+            int overlay = painter.addLayer("Overlay");
+            painter.getLayer(overlay).opacity = 0.5f;
+
+            // Non-trivial pixel values so no blend path is short-circuited
+            for (size_t layer = 0; layer < painter.getLayerCount(); ++layer) {
+                auto& pixels = painter.getLayer(static_cast<int>(layer)).pixels;
+                for (size_t i = 0; i < pixels.size(); ++i) {
+                    pixels[i] = static_cast<unsigned char>((i * 31 + layer * 97) & 0xFF);
+                }
+            }
+
+            size_t iterations = size >= 8192 ? 2 : 16384 / size;
+            std::string label = std::to_string(size / 1024) + "K";
+
+            benchmark.measure("composite 2 layers " + label, iterations, [&]() {
+                painter.compositeLayers();
+                doNotOptimize(painter.getComposite().data());
+            });
+        }
+    }
+
+    BenchmarkRegistration registration("TexturePainter", runCompositing);
+}
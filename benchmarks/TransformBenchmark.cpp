@@ -0,0 +1,101 @@
+#include "Benchmark.hpp"
+#include "../src/components/Transform.hpp"
+#include "../src/core/JobSystem.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+    // Previous scheme: each transform composes T * R * S with full matrix
+    // products and multiplies by its parent's cached matrix
+    struct LegacyTransform {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec3 scale = glm::vec3(1.0f);
+        LegacyTransform* parent = nullptr;
+        glm::mat4 world = glm::mat4(1.0f);
+
+        void updateWorldMatrix() {
+            glm::mat4 local = glm::translate(glm::mat4(1.0f), position) *
+                              glm::mat4_cast(rotation) *
+                              glm::scale(glm::mat4(1.0f), scale);
+            world = parent ? parent->world * local : local;
+        }
+    };
+
+    // depth == 1 gives a flat list of roots, otherwise chains of `depth` nodes
+    void buildHierarchy(size_t count, size_t depth,
+                        std::vector<std::unique_ptr<Transform>>& transforms,
+                        std::vector<LegacyTransform>& legacy) {
+        transforms.clear();
+        legacy.assign(count, LegacyTransform());
+        for (size_t i = 0; i < count; ++i) {
+            auto transform = std::make_unique<Transform>();
+            glm::vec3 offset(0.1f * static_cast<float>(i % 7), 0.5f, 0.0f);
+            transform->setPosition(offset);
+            legacy[i].position = offset;
+
+            if (i % depth != 0) {
+                transform->setParent(transforms.back().get());
+                legacy[i].parent = &legacy[i - 1];
+            }
+            transforms.push_back(std::move(transform));
+        }
+    }
+
+    void runHierarchy(Benchmark& benchmark, const std::string& name, size_t depth) {
+        const size_t count = 100000;
+        std::vector<std::unique_ptr<Transform>> transforms;
+        std::vector<LegacyTransform> legacy;
+        buildHierarchy(count, depth, transforms, legacy);
+
+        TransformSystem& system = TransformSystem::getInstance();
+        system.update();
+
+        float angle = 0.0f;
+        benchmark.measure(name + " legacy, all moving", 20, [&]() {
+            angle += 0.01f;
+            for (size_t i = 0; i < count; i += depth) {
+                legacy[i].rotation = glm::quat(glm::vec3(0.0f, angle, 0.0f));
+            }
+            for (auto& transform : legacy) {
+                transform.updateWorldMatrix();
+            }
+            doNotOptimize(legacy.back().world);
+        });
+
+        benchmark.measure(name + " batched, all moving", 20, [&]() {
+            angle += 0.01f;
+            for (size_t i = 0; i < count; i += depth) {
+                transforms[i]->setRotation(glm::quat(glm::vec3(0.0f, angle, 0.0f)));
+            }
+            system.update();
+            doNotOptimize(transforms.back()->getWorldMatrix());
+        });
+
+        // Only one root in a hundred moves; the rest of the pass is flag checks
+        benchmark.measure(name + " batched, 1% moving", 20, [&]() {
+            angle += 0.01f;
+            for (size_t i = 0; i < count; i += depth * 100) {
+                transforms[i]->setRotation(glm::quat(glm::vec3(0.0f, angle, 0.0f)));
+            }
+            system.update();
+            doNotOptimize(transforms.back()->getWorldMatrix());
+        });
+    }
+
+    void runTransforms(Benchmark& benchmark) {
+        for (unsigned threads : Benchmark::getThreadCounts()) {
+            JobSystem::getInstance().shutdown();
+            if (threads > 1) {
+                JobSystem::getInstance().initialize(threads - 1);
+            }
+
+            std::string suffix = " x" + std::to_string(threads);
+            runHierarchy(benchmark, "flat 100k" + suffix, 1);
+            runHierarchy(benchmark, "deep 100x1000" + suffix, 1000);
+        }
+        JobSystem::getInstance().shutdown();
+    }
+
+    BenchmarkRegistration registration("TransformPropagation", runTransforms);
+}
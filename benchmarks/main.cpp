@@ -0,0 +1,147 @@
+// Engine benchmark suite. Runs headless: nothing here needs a window or GPU.
+// The filter is a comma-separated list of words matched against benchmark
+// names. With --baseline the run is compared against stored results and the
+// exit code is 2 if any metric regressed, and 3 if a benchmark's own check
+// failed.
+//
+//   engine_benchmarks [filter] [--json file] [--warmup N] [--scale X] [--list]
+//                     [--baseline file] [--save-baseline file] [--report file]
+#include "Benchmark.hpp"
+#include "BenchmarkBaseline.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    struct Options {
+        std::string filter;
+        std::string json;
+        size_t warmup = 1;
+        double scale = 1.0;    // Multiplies every benchmark's iteration count
+        bool list = false;
+        std::string baseline;      // Compare against this file
+        std::string saveBaseline;  // Record this run as the new baseline
+        std::string report;        // Also write the comparison table here
+    };
+
+    void printUsage() {
+        std::cout << "Usage: engine_benchmarks [filter] [--json file] [--warmup N] "
+                     "[--scale X] [--list] [--baseline file] [--save-baseline file] "
+                     "[--report file]" << std::endl;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return false;
+            }
+            if (arg == "--list") {
+                options.list = true;
+                continue;
+            }
+            if (arg.compare(0, 2, "--") != 0) {
+                options.filter = arg;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+
+            std::string value = argv[++i];
+            if (arg == "--json") {
+                options.json = value;
+            } else if (arg == "--warmup") {
+                options.warmup = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (arg == "--scale") {
+                options.scale = std::atof(value.c_str());
+            } else if (arg == "--baseline") {
+                options.baseline = value;
+            } else if (arg == "--save-baseline") {
+                options.saveBaseline = value;
+            } else if (arg == "--report") {
+                options.report = value;
+            } else {
+                std::cerr << "Unknown option " << arg << std::endl;
+                printUsage();
+                return false;
+            }
+        }
+
+        if (options.scale <= 0.0) {
+            std::cerr << "Iteration scale must be positive" << std::endl;
+            return false;
+        }
+        if (!options.report.empty() && options.baseline.empty()) {
+            std::cerr << "--report needs --baseline" << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    Benchmark& benchmark = Benchmark::getInstance();
+    if (options.list) {
+        for (const auto& name : benchmark.getNames()) {
+            std::cout << name << std::endl;
+        }
+        return 0;
+    }
+
+    // Load first so a bad baseline fails before minutes of benchmarking
+    BenchmarkBaseline baseline;
+    if (!options.baseline.empty() && !baseline.load(options.baseline)) {
+        std::cerr << "Record one with --save-baseline " << options.baseline << std::endl;
+        return 1;
+    }
+
+    benchmark.setWarmupIterations(options.warmup);
+    benchmark.setIterationScale(options.scale);
+
+    if (benchmark.runAll(options.filter) == 0) {
+        std::cerr << "No benchmarks matched filter: " << options.filter << std::endl;
+        return 1;
+    }
+
+    if (!options.json.empty() && !benchmark.writeJson(options.json)) {
+        return 1;
+    }
+    if (!options.saveBaseline.empty()) {
+        if (!BenchmarkBaseline::save(options.saveBaseline, benchmark.getResults())) {
+            return 1;
+        }
+        std::cout << "Baseline written to " << options.saveBaseline << std::endl;
+    }
+
+    if (!options.baseline.empty()) {
+        auto comparisons = baseline.compare(benchmark.getResults());
+        std::cout << std::endl;
+        size_t regressions = BenchmarkBaseline::writeReport(std::cout, comparisons);
+
+        if (!options.report.empty()) {
+            std::ofstream report(options.report);
+            if (!report.is_open()) {
+                std::cerr << "Failed to open report: " << options.report << std::endl;
+                return 1;
+            }
+            BenchmarkBaseline::writeReport(report, comparisons);
+        }
+        if (regressions > 0) {
+            return 2;
+        }
+    }
+
+    if (benchmark.getFailureCount() > 0) {
+        std::cerr << benchmark.getFailureCount() << " benchmark check(s) failed" << std::endl;
+        return 3;
+    }
+    return 0;
+}
@@ -2,9 +2,13 @@
 #include "../src/core/ResourceManager.hpp"
 #include "../src/components/Transform.hpp"
 #include "../src/components/MeshRenderer.hpp"
+#include "../src/core/GlfwInputSource.hpp"
 #include <GLFW/glfw3.h>
 
-DemoScene::DemoScene() {}
+DemoScene::DemoScene()
+    : cameraEntity(nullptr)
+    , modelEntity(nullptr)
+{}
 
 DemoScene::~DemoScene() {}
 
@@ -14,7 +18,7 @@ bool DemoScene::initialize() {
     }
 
     // Initialize input system
-    Input::getInstance().initialize(engine.getWindow());
+    Input::getInstance().setSource(std::make_unique<GlfwInputSource>(engine.getWindow()));
 
     // Setup scene
     setupCamera();
@@ -24,7 +28,7 @@ bool DemoScene::initialize() {
 }
 
 void DemoScene::setupCamera() {
-    cameraEntity = std::make_shared<Entity>("MainCamera");
+    cameraEntity = scene.createEntity("MainCamera");
     
     auto transform = cameraEntity->addComponent<Transform>();
     transform->setPosition(glm::vec3(0.0f, 2.0f, -5.0f));
@@ -46,7 +50,7 @@ void DemoScene::setupModel() {
     auto material = resourceManager.createMaterial("default", shader);
 
     // Create model entity
-    modelEntity = std::make_shared<Entity>("Model");
+    modelEntity = scene.createEntity("Model");
     
     auto transform = modelEntity->addComponent<Transform>();
     transform->setPosition(glm::vec3(0.0f, 0.0f, 0.0f));
@@ -65,8 +69,7 @@ void DemoScene::update(float deltaTime) {
     Input::getInstance().update();
     handleInput(deltaTime);
 
-    if (cameraEntity) cameraEntity->update(deltaTime);
-    if (modelEntity) modelEntity->update(deltaTime);
+    scene.update(deltaTime);
 }
 
 void DemoScene::handleInput(float deltaTime) {
@@ -2,6 +2,7 @@
 #include "../src/core/Engine.hpp"
 #include "../src/core/Input.hpp"
 #include "../src/components/Camera.hpp"
+#include "../src/scene/Scene.hpp"
 #include <memory>
 
 class DemoScene {
@@ -15,8 +16,9 @@ public:
 
 private:
     Engine engine;
-    std::shared_ptr<Entity> cameraEntity;
-    std::shared_ptr<Entity> modelEntity;
+    Scene scene;
+    Entity* cameraEntity;
+    Entity* modelEntity;
 
     void setupCamera();
     void setupModel();
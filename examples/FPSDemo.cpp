@@ -12,7 +12,7 @@ void FPSDemo::setupPlayer() {
     auto health = playerEntity->addComponent<HealthSystem>();
     health->setMaxHealth(100.0f);
     health->setRegeneration(1.0f);
-    health->onDamage([this](float amount, Entity* attacker) {
+    health->onDamage([this](float amount, EntityHandle attacker) {
         onPlayerDamaged(amount, attacker);
     });
 
@@ -72,7 +72,7 @@ void FPSDemo::setupAI() {
 }
 
 void FPSDemo::spawnAI(const glm::vec3& position) {
-    auto aiEntity = std::make_shared<Entity>("AI");
+    auto aiEntity = scene.createEntity("AI");
 
     // Transform
     auto transform = aiEntity->addComponent<Transform>();
@@ -102,11 +102,12 @@ void FPSDemo::spawnAI(const glm::vec3& position) {
     // Health System
     auto health = aiEntity->addComponent<HealthSystem>();
     health->setMaxHealth(100.0f);
-    health->onDamage([this, aiEntity](float amount, Entity* attacker) {
-        onAIDamaged(aiEntity.get(), amount, attacker);
+    EntityHandle aiHandle = aiEntity->getHandle();
+    health->onDamage([this, aiHandle](float amount, EntityHandle attacker) {
+        onAIDamaged(aiHandle, amount, attacker);
     });
-    health->onDeath([this, aiEntity](Entity* killer) {
-        onAIKilled(aiEntity.get(), killer);
+    health->onDeath([this, aiHandle](EntityHandle killer) {
+        onAIKilled(aiHandle, killer);
     });
 
     // Weapon System
@@ -124,10 +125,13 @@ void FPSDemo::spawnAI(const glm::vec3& position) {
     // Visual Effects
     aiEntity->addComponent<VisualEffects>();
 
-    aiEntities.push_back(aiEntity);
+    aiEntities.push_back(aiHandle);
 }
 
-void FPSDemo::onPlayerDamaged(float amount, Entity* attacker) {
+void FPSDemo::onPlayerDamaged(float amount, EntityHandle attackerHandle) {
+    Entity* attacker = scene.getEntity(attackerHandle);
+    if (!attacker) return;
+
     // Create blood effect
     if (auto effects = playerEntity->getComponent<VisualEffects>()) {
         glm::vec3 damageDir = glm::normalize(playerEntity->getComponent<Transform>()->getPosition() -
@@ -136,7 +140,11 @@ void FPSDemo::onPlayerDamaged(float amount, Entity* attacker) {
     }
 }
 
-void FPSDemo::onAIDamaged(Entity* ai, float amount, Entity* attacker) {
+void FPSDemo::onAIDamaged(EntityHandle aiHandle, float amount, EntityHandle attackerHandle) {
+    Entity* ai = scene.getEntity(aiHandle);
+    Entity* attacker = scene.getEntity(attackerHandle);
+    if (!ai || !attacker) return;
+
     // Create blood effect
     if (auto effects = ai->getComponent<VisualEffects>()) {
         glm::vec3 damageDir = glm::normalize(ai->getComponent<Transform>()->getPosition() -
@@ -145,17 +153,23 @@ void FPSDemo::onAIDamaged(Entity* ai, float amount, Entity* attacker) {
     }
 }
 
-void FPSDemo::onAIKilled(Entity* ai, Entity* killer) {
+void FPSDemo::onAIKilled(EntityHandle aiHandle, EntityHandle killer) {
+    Entity* ai = scene.getEntity(aiHandle);
+    if (!ai) return;
+
     // Create death effects
     if (auto effects = ai->getComponent<VisualEffects>()) {
         effects->createBloodSplatter(ai->getComponent<Transform>()->getPosition(), glm::vec3(0, 1, 0));
     }
 
     // Schedule respawn
-    respawnAI(ai);
+    respawnAI(aiHandle);
 }
 
-void FPSDemo::respawnAI(Entity* deadAI) {
+void FPSDemo::respawnAI(EntityHandle deadHandle) {
+    Entity* deadAI = scene.getEntity(deadHandle);
+    if (!deadAI) return;
+
     // Find random spawn point away from player
     glm::vec3 playerPos = playerEntity->getComponent<Transform>()->getPosition();
     float maxDist = 0.0f;
@@ -178,13 +192,8 @@ void FPSDemo::respawnAI(Entity* deadAI) {
 void FPSDemo::update(float deltaTime) {
     handleInput(deltaTime);
 
-    // Update player
-    playerEntity->update(deltaTime);
-
-    // Update AI
-    for (auto& ai : aiEntities) {
-        ai->update(deltaTime);
-    }
+    // Update player and AI
+    scene.update(deltaTime);
 }
 
 void FPSDemo::render() {
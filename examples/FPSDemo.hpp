@@ -5,6 +5,7 @@
 #include "../src/gameplay/HealthSystem.hpp"
 #include "../src/gameplay/AIController.hpp"
 #include "../src/effects/VisualEffects.hpp"
+#include "../src/scene/Scene.hpp"
 #include <memory>
 
 class FPSDemo {
@@ -18,8 +19,9 @@ public:
 
 private:
     Engine engine;
-    std::shared_ptr<Entity> playerEntity;
-    std::vector<std::shared_ptr<Entity>> aiEntities;
+    Scene scene;
+    Entity* playerEntity;
+    std::vector<EntityHandle> aiEntities;
     std::vector<glm::vec3> spawnPoints;
 
     void setupPlayer();
@@ -28,10 +30,10 @@ private:
     void setupAI();
     void handleInput(float deltaTime);
     void spawnAI(const glm::vec3& position);
-    void respawnAI(Entity* deadAI);
+    void respawnAI(EntityHandle deadAI);
     
     // Combat event handlers
-    void onPlayerDamaged(float amount, Entity* attacker);
-    void onAIDamaged(Entity* ai, float amount, Entity* attacker);
-    void onAIKilled(Entity* ai, Entity* killer);
+    void onPlayerDamaged(float amount, EntityHandle attacker);
+    void onAIDamaged(EntityHandle ai, float amount, EntityHandle attacker);
+    void onAIKilled(EntityHandle ai, EntityHandle killer);
 };
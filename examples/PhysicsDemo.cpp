@@ -7,8 +7,11 @@
 #include "../src/physics/RigidBody.hpp"
 #include "../src/physics/Collider.hpp"
 #include "../src/renderer/LightManager.hpp"
+#include "../src/core/GlfwInputSource.hpp"
 
-PhysicsDemo::PhysicsDemo() {}
+PhysicsDemo::PhysicsDemo()
+    : cameraEntity(nullptr)
+{}
 
 PhysicsDemo::~PhysicsDemo() {}
 
@@ -18,7 +21,7 @@ bool PhysicsDemo::initialize() {
     }
 
     // Initialize systems
-    Input::getInstance().initialize(engine.getWindow());
+    Input::getInstance().setSource(std::make_unique<GlfwInputSource>(engine.getWindow()));
     PhysicsSystem::getInstance().initialize();
     
     // Setup scene
@@ -29,7 +32,7 @@ bool PhysicsDemo::initialize() {
 }
 
 void PhysicsDemo::setupCamera() {
-    cameraEntity = std::make_shared<Entity>("MainCamera");
+    cameraEntity = scene.createEntity("MainCamera");
     
     auto transform = cameraEntity->addComponent<Transform>();
     transform->setPosition(glm::vec3(0.0f, 5.0f, -10.0f));
@@ -41,7 +44,7 @@ void PhysicsDemo::setupCamera() {
 
 void PhysicsDemo::setupScene() {
     // Create ground plane
-    auto ground = std::make_shared<Entity>("Ground");
+    auto ground = scene.createEntity("Ground");
     auto groundTransform = ground->addComponent<Transform>();
     groundTransform->setPosition(glm::vec3(0.0f, -1.0f, 0.0f));
     groundTransform->setScale(glm::vec3(20.0f, 0.2f, 20.0f));
@@ -61,7 +64,7 @@ void PhysicsDemo::setupScene() {
     createPhysicsObject(glm::vec3(-1.0f, 9.0f, 0.0f));
 
     // Setup lighting
-    auto light = std::make_shared<Entity>("MainLight");
+    auto light = scene.createEntity("MainLight");
     auto lightTransform = light->addComponent<Transform>();
     lightTransform->setPosition(glm::vec3(5.0f, 10.0f, -5.0f));
 
@@ -69,12 +72,10 @@ void PhysicsDemo::setupScene() {
     directionalLight->setType(Light::Type::Directional);
     directionalLight->setColor(glm::vec3(1.0f));
     directionalLight->setIntensity(1.0f);
-
-    LightManager::getInstance().addLight(directionalLight);
 }
 
 void PhysicsDemo::createPhysicsObject(const glm::vec3& position, bool isKinematic) {
-    auto entity = std::make_shared<Entity>("PhysicsObject");
+    auto entity = scene.createEntity("PhysicsObject");
     
     // Transform
     auto transform = entity->addComponent<Transform>();
@@ -103,10 +104,7 @@ void PhysicsDemo::update(float deltaTime) {
     handleInput(deltaTime);
 
     // Update all entities
-    for (auto& entity : physicsObjects) {
-        entity->update(deltaTime);
-    }
-    if (cameraEntity) cameraEntity->update(deltaTime);
+    scene.update(deltaTime);
 
     // Physics system updates automatically
 }
@@ -152,5 +150,6 @@ void PhysicsDemo::handleInput(float deltaTime) {
 }
 
 void PhysicsDemo::render() {
+    LightManager::getInstance().gatherLights(scene);
     engine.render();
 }
@@ -6,8 +6,12 @@
 #include "../src/renderer/LightManager.hpp"
 #include "../src/ui/UISystem.hpp"
 #include "../src/ui/SculptingUI.hpp"
+#include "../src/core/GlfwInputSource.hpp"
 
-SculptingDemo::SculptingDemo() {}
+SculptingDemo::SculptingDemo()
+    : cameraEntity(nullptr)
+    , sculptMeshEntity(nullptr)
+{}
 
 SculptingDemo::~SculptingDemo() {}
 
@@ -17,7 +21,7 @@ bool SculptingDemo::initialize() {
     }
 
     // Initialize systems
-    Input::getInstance().initialize(engine.getWindow());
+    Input::getInstance().setSource(std::make_unique<GlfwInputSource>(engine.getWindow()));
     UISystem::getInstance().initialize(engine.getWindow());
     SculptingSystem::getInstance().initialize();
     SculptingUI::getInstance().initialize();
@@ -31,7 +35,7 @@ bool SculptingDemo::initialize() {
 }
 
 void SculptingDemo::setupCamera() {
-    cameraEntity = std::make_shared<Entity>("MainCamera");
+    cameraEntity = scene.createEntity("MainCamera");
     
     auto transform = cameraEntity->addComponent<Transform>();
     transform->setPosition(glm::vec3(0.0f, 2.0f, -5.0f));
@@ -47,7 +51,7 @@ void SculptingDemo::setupSculptMesh() {
     sculptMesh = std::make_shared<SculptMesh>();
     sculptMesh->initializeAsSphere(1.0f, 3);
 
-    sculptMeshEntity = std::make_shared<Entity>("SculptMesh");
+    sculptMeshEntity = scene.createEntity("SculptMesh");
     auto transform = sculptMeshEntity->addComponent<Transform>();
     transform->setPosition(glm::vec3(0.0f, 0.0f, 0.0f));
 
@@ -71,7 +75,7 @@ void SculptingDemo::setupSculptMesh() {
 
 void SculptingDemo::setupLighting() {
     // Create main directional light
-    auto lightEntity = std::make_shared<Entity>("MainLight");
+    auto lightEntity = scene.createEntity("MainLight");
     auto lightTransform = lightEntity->addComponent<Transform>();
     lightTransform->setPosition(glm::vec3(5.0f, 5.0f, -5.0f));
     lightTransform->setRotation(glm::quat(glm::vec3(-45.0f, 45.0f, 0.0f)));
@@ -82,7 +86,7 @@ void SculptingDemo::setupLighting() {
     light->setIntensity(1.0f);
 
     // Add fill light
-    auto fillLightEntity = std::make_shared<Entity>("FillLight");
+    auto fillLightEntity = scene.createEntity("FillLight");
     auto fillTransform = fillLightEntity->addComponent<Transform>();
     fillTransform->setPosition(glm::vec3(-3.0f, 2.0f, 2.0f));
 
@@ -91,9 +95,6 @@ void SculptingDemo::setupLighting() {
     fillLight->setColor(glm::vec3(0.6f, 0.8f, 1.0f));
     fillLight->setIntensity(0.5f);
     fillLight->setRange(10.0f);
-
-    LightManager::getInstance().addLight(light);
-    LightManager::getInstance().addLight(fillLight);
 }
 
 void SculptingDemo::update(float deltaTime) {
@@ -104,10 +105,8 @@ void SculptingDemo::update(float deltaTime) {
     SculptingSystem::getInstance().update(deltaTime);
 
     // Update entities
-    if (cameraEntity) cameraEntity->update(deltaTime);
+    scene.update(deltaTime);
     if (sculptMeshEntity) {
-        sculptMeshEntity->update(deltaTime);
-        
         // Update mesh renderer with new mesh data when sculpted
         if (auto meshRenderer = sculptMeshEntity->getComponent<MeshRenderer>()) {
             meshRenderer->setMesh(sculptMesh->generateMesh());
@@ -151,6 +150,7 @@ void SculptingDemo::render() {
     UISystem::getInstance().beginFrame();
 
     // Render scene
+    LightManager::getInstance().gatherLights(scene);
     engine.render();
 
     // Render UI
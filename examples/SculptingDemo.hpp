@@ -1,6 +1,7 @@
 #pragma once
 #include "../src/core/Engine.hpp"
 #include "../src/sculpting/SculptingSystem.hpp"
+#include "../src/scene/Scene.hpp"
 #include <memory>
 
 class SculptingDemo {
@@ -14,8 +15,9 @@ public:
 
 private:
     Engine engine;
-    std::shared_ptr<Entity> cameraEntity;
-    std::shared_ptr<Entity> sculptMeshEntity;
+    Scene scene;
+    Entity* cameraEntity;
+    Entity* sculptMeshEntity;
     std::shared_ptr<SculptMesh> sculptMesh;
 
     void setupCamera();
@@ -1,5 +1,6 @@
 #include "Camera.hpp"
 #include "Transform.hpp"
+#include "../scene/Entity.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 
 Camera::Camera()
@@ -73,12 +74,17 @@ const glm::mat4& Camera::getProjectionMatrix() const {
 
 glm::mat4 Camera::getViewMatrix() const {
     if (auto transform = getEntity()->getComponent<Transform>()) {
-        // Inverse of world transform is our view matrix
-        return glm::inverse(transform->getWorldMatrix());
+        // Inverse of the interpolated world transform, so the camera moves
+        // in step with the meshes it renders
+        return glm::inverse(transform->getRenderMatrix());
     }
     return glm::mat4(1.0f);
 }
 
+Frustum Camera::getFrustum() const {
+    return Frustum::fromMatrix(getProjectionMatrix() * getViewMatrix());
+}
+
 void Camera::updateProjectionMatrix() {
     if (projType == ProjectionType::Perspective) {
         projectionMatrix = glm::perspective(glm::radians(fov), aspectRatio, nearPlane, farPlane);
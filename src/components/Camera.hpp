@@ -1,6 +1,7 @@
 #pragma once
 #include "Component.hpp"
 #include <glm/glm.hpp>
+#include "../scene/Bounds.hpp"
 
 class Camera : public Component {
 public:
@@ -26,6 +27,9 @@ public:
     // Matrices
     const glm::mat4& getProjectionMatrix() const;
     glm::mat4 getViewMatrix() const;
+
+    // World-space view volume for culling, e.g. Scene::render(camera.getFrustum())
+    Frustum getFrustum() const;
     
     // Frustum properties
     float getFOV() const { return fov; }
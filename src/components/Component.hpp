@@ -10,10 +10,11 @@ public:
     virtual void update(float deltaTime) {}
     virtual void render() {}
 
-    Entity* getEntity() { return entity; }
+    Entity* getEntity() const { return entity; }
 
 protected:
     Entity* entity;
 
     friend class Entity;
+    friend class ComponentStorage;
 };
@@ -1,5 +1,6 @@
 #include "Light.hpp"
 #include "Transform.hpp"
+#include "../scene/Entity.hpp"
 
 Light::Light(Type type)
     : type(type)
@@ -15,13 +16,16 @@ void Light::update(float deltaTime) {
 
 glm::vec3 Light::getDirection() const {
     if (auto transform = getEntity()->getComponent<Transform>()) {
-        // Use the forward vector of the transform
-        glm::mat4 rotation = glm::mat4_cast(transform->getRotation());
-        return -glm::normalize(glm::vec3(rotation * glm::vec4(0.0f, 0.0f, 1.0f, 0.0f)));
+        return directionFromRotation(transform->getRotation());
     }
     return glm::vec3(0.0f, -1.0f, 0.0f); // Default down direction
 }
 
+glm::vec3 Light::directionFromRotation(const glm::quat& rotation) {
+    // Use the forward vector of the transform
+    return -glm::normalize(rotation * glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
 glm::vec3 Light::getPosition() const {
     if (auto transform = getEntity()->getComponent<Transform>()) {
         return transform->getPosition();
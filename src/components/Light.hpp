@@ -1,6 +1,7 @@
 #pragma once
 #include "Component.hpp"
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 class Light : public Component {
 public:
@@ -30,6 +31,7 @@ public:
 
     // Get direction (for directional and spot lights)
     glm::vec3 getDirection() const;
+    static glm::vec3 directionFromRotation(const glm::quat& rotation);
 
     // Get position (for point and spot lights)
     glm::vec3 getPosition() const;
@@ -1,30 +1,38 @@
 #include "MeshRenderer.hpp"
-#include "Transform.hpp"
+
+// Headless builds link no GL, so drawing compiles away there
+#ifndef ENGINE_HEADLESS
 #include "../renderer/Mesh.hpp"
 #include "../renderer/Material.hpp"
+#endif
 
 MeshRenderer::MeshRenderer()
     : mesh(nullptr)
     , material(nullptr)
+    , localBounds(glm::vec3(-0.5f), glm::vec3(0.5f))
 {}
 
 void MeshRenderer::update(float deltaTime) {
     // Update logic if needed
 }
 
-void MeshRenderer::render() {
+void MeshRenderer::draw([[maybe_unused]] const glm::mat4& worldMatrix) const {
+#ifndef ENGINE_HEADLESS
     if (!mesh || !material) return;
 
-    auto transform = getEntity()->getComponent<Transform>();
-    if (!transform) return;
-
     material->bind();
-    material->setModelMatrix(transform->getWorldMatrix());
+    material->setModelMatrix(worldMatrix);
     mesh->render();
+#endif
 }
 
 void MeshRenderer::setMesh(std::shared_ptr<Mesh> newMesh) {
     mesh = newMesh;
+#ifndef ENGINE_HEADLESS
+    if (mesh) {
+        localBounds = mesh->getBounds();
+    }
+#endif
 }
 
 void MeshRenderer::setMaterial(std::shared_ptr<Material> newMaterial) {
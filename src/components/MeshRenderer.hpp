@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include <glm/glm.hpp>
+#include "../scene/Bounds.hpp"
 
 struct Mesh;
 class Material;
@@ -11,7 +12,10 @@ class MeshRenderer : public Component {
 public:
     MeshRenderer();
     void update(float deltaTime) override;
-    void render() override;
+
+    // Issues the draw with the owning entity's world matrix. Called by
+    // Scene::render for every entity that also has a Transform.
+    void draw(const glm::mat4& worldMatrix) const;
 
     void setMesh(std::shared_ptr<Mesh> mesh);
     void setMaterial(std::shared_ptr<Material> material);
@@ -19,7 +23,13 @@ public:
     Mesh* getMesh() const { return mesh.get(); }
     Material* getMaterial() const { return material.get(); }
 
+    // Model-space bounds used for culling. setMesh takes them from the mesh;
+    // set them directly for meshes deformed in the shader.
+    const AABB& getLocalBounds() const { return localBounds; }
+    void setLocalBounds(const AABB& bounds) { localBounds = bounds; }
+
 private:
     std::shared_ptr<Mesh> mesh;
     std::shared_ptr<Material> material;
+    AABB localBounds;
 };
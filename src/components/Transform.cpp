@@ -2,90 +2,117 @@
 #include <glm/gtx/matrix_decompose.hpp>
 
 Transform::Transform()
-    : position(0.0f)
-    , rotation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f))
-    , scale(1.0f)
-    , parent(nullptr)
-    , dirtyMatrix(true)
-    , cachedWorldMatrix(1.0f)
+    : node(TransformSystem::getInstance().createNode(this))
 {}
 
-void Transform::update(float deltaTime) {
-    if (dirtyMatrix) {
-        updateWorldMatrix();
+Transform::~Transform() {
+    if (node != TransformSystem::INVALID_NODE) {
+        TransformSystem::getInstance().destroyNode(node);
+    }
+}
+
+Transform::Transform(Transform&& other) noexcept
+    : Component(other)
+    , node(other.node)
+{
+    other.node = TransformSystem::INVALID_NODE;
+    TransformSystem::getInstance().setOwner(node, this);
+}
+
+Transform::Transform(const Transform& other)
+    : Component(other)
+    , node(TransformSystem::getInstance().createNode(this))
+{
+    auto& system = TransformSystem::getInstance();
+    system.localPosition(node) = system.localPosition(other.node);
+    system.localRotation(node) = system.localRotation(other.node);
+    system.localScale(node) = system.localScale(other.node);
+    if (Transform* parent = other.getParent()) {
+        system.setParent(node, parent->node);
     }
 }
 
 void Transform::setPosition(const glm::vec3& pos) {
-    position = pos;
-    dirtyMatrix = true;
+    auto& system = TransformSystem::getInstance();
+    system.localPosition(node) = pos;
+    system.markDirty(node);
 }
 
 const glm::vec3& Transform::getPosition() const {
-    return position;
+    return TransformSystem::getInstance().localPosition(node);
 }
 
 void Transform::translate(const glm::vec3& delta) {
-    position += delta;
-    dirtyMatrix = true;
+    auto& system = TransformSystem::getInstance();
+    system.localPosition(node) += delta;
+    system.markDirty(node);
+}
+
+void Transform::teleport(const glm::vec3& pos) {
+    setPosition(pos);
+    TransformSystem::getInstance().snap(node);
 }
 
 void Transform::setRotation(const glm::quat& rot) {
-    rotation = rot;
-    dirtyMatrix = true;
+    auto& system = TransformSystem::getInstance();
+    system.localRotation(node) = rot;
+    system.markDirty(node);
 }
 
 void Transform::setRotationEuler(const glm::vec3& euler) {
-    rotation = glm::quat(glm::radians(euler));
-    dirtyMatrix = true;
+    setRotation(glm::quat(glm::radians(euler)));
 }
 
 const glm::quat& Transform::getRotation() const {
-    return rotation;
+    return TransformSystem::getInstance().localRotation(node);
 }
 
 glm::vec3 Transform::getRotationEuler() const {
-    return glm::degrees(glm::eulerAngles(rotation));
+    return glm::degrees(glm::eulerAngles(getRotation()));
 }
 
 void Transform::rotate(const glm::vec3& euler) {
-    rotation = glm::quat(glm::radians(euler)) * rotation;
-    dirtyMatrix = true;
+    setRotation(glm::quat(glm::radians(euler)) * getRotation());
+}
+
+glm::vec3 Transform::getForward() const {
+    return getRotation() * glm::vec3(0.0f, 0.0f, -1.0f);
+}
+
+glm::vec3 Transform::getRight() const {
+    return getRotation() * glm::vec3(1.0f, 0.0f, 0.0f);
+}
+
+glm::vec3 Transform::getUp() const {
+    return getRotation() * glm::vec3(0.0f, 1.0f, 0.0f);
 }
 
 void Transform::setScale(const glm::vec3& s) {
-    scale = s;
-    dirtyMatrix = true;
+    auto& system = TransformSystem::getInstance();
+    system.localScale(node) = s;
+    system.markDirty(node);
 }
 
 const glm::vec3& Transform::getScale() const {
-    return scale;
+    return TransformSystem::getInstance().localScale(node);
 }
 
 glm::mat4 Transform::getLocalMatrix() const {
-    return glm::translate(glm::mat4(1.0f), position) *
-           glm::mat4_cast(rotation) *
-           glm::scale(glm::mat4(1.0f), scale);
+    return TransformSystem::composeMatrix(getPosition(), getRotation(), getScale());
 }
 
 glm::mat4 Transform::getWorldMatrix() const {
-    return cachedWorldMatrix;
+    return TransformSystem::getInstance().getWorldMatrix(node);
 }
 
-void Transform::setParent(Transform* newParent) {
-    parent = newParent;
-    dirtyMatrix = true;
+const glm::mat4& Transform::getRenderMatrix() const {
+    return TransformSystem::getInstance().getRenderMatrix(node);
 }
 
-Transform* Transform::getParent() const {
-    return parent;
+void Transform::setParent(Transform* newParent) {
+    TransformSystem::getInstance().setParent(node, newParent ? newParent->node : TransformSystem::INVALID_NODE);
 }
 
-void Transform::updateWorldMatrix() {
-    if (parent) {
-        cachedWorldMatrix = parent->getWorldMatrix() * getLocalMatrix();
-    } else {
-        cachedWorldMatrix = getLocalMatrix();
-    }
-    dirtyMatrix = false;
+Transform* Transform::getParent() const {
+    return TransformSystem::getInstance().getParent(node);
 }
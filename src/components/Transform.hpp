@@ -1,19 +1,32 @@
 #pragma once
 #include "Component.hpp"
+#include "TransformSystem.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+// Handle to a node in the TransformSystem, which stores the actual TRS and
+// world matrix data. World matrices are refreshed in batch by
+// TransformSystem::update(), once per Scene::update.
 class Transform : public Component {
 public:
     Transform();
-    void update(float deltaTime) override;
+    ~Transform();
+
+    // Chunk relocation moves the handle; the node itself stays put
+    Transform(Transform&& other) noexcept;
+    // A copy is a new node with the same local TRS and parent
+    Transform(const Transform& other);
+    Transform& operator=(const Transform&) = delete;
 
     // Position
     void setPosition(const glm::vec3& pos);
     const glm::vec3& getPosition() const;
     void translate(const glm::vec3& delta);
 
+    // Moves without render interpolation from the old position
+    void teleport(const glm::vec3& pos);
+
     // Rotation
     void setRotation(const glm::quat& rot);
     void setRotationEuler(const glm::vec3& euler);
@@ -21,25 +34,29 @@ public:
     glm::vec3 getRotationEuler() const;
     void rotate(const glm::vec3& euler);
 
+    // Local axes in parent space; forward is -Z
+    glm::vec3 getForward() const;
+    glm::vec3 getRight() const;
+    glm::vec3 getUp() const;
+
     // Scale
     void setScale(const glm::vec3& scale);
     const glm::vec3& getScale() const;
 
-    // Matrices
+    // Matrices. The world matrix is as of the last TransformSystem update.
     glm::mat4 getLocalMatrix() const;
     glm::mat4 getWorldMatrix() const;
 
-    // Hierarchy
+    // World matrix blended between the last two simulation ticks. Use for
+    // rendering; equals the world matrix when no interpolation ran.
+    const glm::mat4& getRenderMatrix() const;
+
+    // Hierarchy. Linking that would create a cycle is ignored.
     void setParent(Transform* parent);
     Transform* getParent() const;
 
+    uint32_t getNode() const { return node; }
+
 private:
-    glm::vec3 position;
-    glm::quat rotation;
-    glm::vec3 scale;
-    Transform* parent;
-    bool dirtyMatrix;
-    glm::mat4 cachedWorldMatrix;
-
-    void updateWorldMatrix();
+    uint32_t node;
 };
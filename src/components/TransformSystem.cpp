@@ -0,0 +1,395 @@
+#include "TransformSystem.hpp"
+#include "../core/JobSystem.hpp"
+#include <algorithm>
+
+namespace {
+    // Both operands are affine (bottom row 0,0,0,1), so the last row of the
+    // product is known and each column needs three or four vec4 madds
+    inline glm::mat4 multiplyAffine(const glm::mat4& a, const glm::mat4& b) {
+        glm::mat4 result;
+        result[0] = a[0] * b[0].x + a[1] * b[0].y + a[2] * b[0].z;
+        result[1] = a[0] * b[1].x + a[1] * b[1].y + a[2] * b[1].z;
+        result[2] = a[0] * b[2].x + a[1] * b[2].y + a[2] * b[2].z;
+        result[3] = a[0] * b[3].x + a[1] * b[3].y + a[2] * b[3].z + a[3];
+        return result;
+    }
+}
+
+glm::mat4 TransformSystem::composeMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+    glm::mat3 basis = glm::mat3_cast(rotation);
+    return glm::mat4(
+        glm::vec4(basis[0] * scale.x, 0.0f),
+        glm::vec4(basis[1] * scale.y, 0.0f),
+        glm::vec4(basis[2] * scale.z, 0.0f),
+        glm::vec4(position, 1.0f));
+}
+
+uint32_t TransformSystem::createNode(Transform* owner) {
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<uint32_t>(idToSlot.size());
+        idToSlot.push_back(INVALID_NODE);
+    }
+
+    // New nodes are roots: reuse a dead root slot in place, or append, which
+    // keeps the depth-first order intact either way
+    uint32_t slot;
+    if (!freeRootSlots.empty()) {
+        slot = freeRootSlots.back();
+        freeRootSlots.pop_back();
+        positions[slot] = glm::vec3(0.0f);
+        rotations[slot] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        scales[slot] = glm::vec3(1.0f);
+        worldMatrices[slot] = glm::mat4(1.0f);
+        parents[slot] = -1;
+        dirty[slot] = 1;
+        worldChanged[slot] = 0;
+        slotToId[slot] = id;
+        owners[slot] = owner;
+        previousPositions[slot] = glm::vec3(0.0f);
+        previousRotations[slot] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        previousScales[slot] = glm::vec3(1.0f);
+        hasPrevious[slot] = 0;
+        renderChanged[slot] = 0;
+        renderMatrices[slot] = glm::mat4(1.0f);
+        deadSlots--;
+    } else {
+        slot = static_cast<uint32_t>(positions.size());
+        positions.push_back(glm::vec3(0.0f));
+        rotations.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        scales.push_back(glm::vec3(1.0f));
+        worldMatrices.push_back(glm::mat4(1.0f));
+        parents.push_back(-1);
+        dirty.push_back(1);
+        worldChanged.push_back(0);
+        slotToId.push_back(id);
+        owners.push_back(owner);
+        previousPositions.push_back(glm::vec3(0.0f));
+        previousRotations.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+        previousScales.push_back(glm::vec3(1.0f));
+        hasPrevious.push_back(0);
+        renderChanged.push_back(0);
+        renderMatrices.push_back(glm::mat4(1.0f));
+        rootRanges.emplace_back(slot, slot + 1);
+        rangeNeedsRelayout.push_back(0);
+    }
+
+    idToSlot[id] = slot;
+    liveNodes++;
+    return id;
+}
+
+void TransformSystem::destroyNode(uint32_t node) {
+    uint32_t slot = idToSlot[node];
+    uint32_t range = findRange(slot);
+    idToSlot[node] = INVALID_NODE;
+    freeIds.push_back(node);
+    liveNodes--;
+
+    if (rangeNeedsRelayout[range]) {
+        // relayout() turns any children into roots
+        killSlot(slot);
+        return;
+    }
+
+    // The range is in depth-first order and no live node in it has a dead
+    // parent, so a first child would be the next live slot
+    uint32_t next = slot + 1;
+    while (next < rootRanges[range].second && !isAlive(static_cast<int32_t>(next))) {
+        ++next;
+    }
+    bool hasChildren = next < rootRanges[range].second && parents[next] == static_cast<int32_t>(slot);
+
+    killSlot(slot);
+    if (hasChildren) {
+        rangeNeedsRelayout[range] = 1;
+        relayoutRanges.push_back(range);
+    } else if (rootRanges[range].second - rootRanges[range].first == 1) {
+        freeRootSlots.push_back(slot);
+    }
+}
+
+bool TransformSystem::setParent(uint32_t node, uint32_t parent) {
+    uint32_t slot = idToSlot[node];
+    int32_t parentSlot = -1;
+
+    if (parent != INVALID_NODE) {
+        parentSlot = static_cast<int32_t>(idToSlot[parent]);
+        for (int32_t ancestor = parentSlot; ancestor >= 0; ancestor = parents[ancestor]) {
+            if (ancestor == static_cast<int32_t>(slot)) return false;
+        }
+    }
+
+    if (parents[slot] == parentSlot) return true;
+
+    // Both trees involved are laid out again on the next update
+    flagRange(slot);
+    if (parentSlot >= 0) {
+        flagRange(static_cast<uint32_t>(parentSlot));
+    }
+
+    parents[slot] = parentSlot;
+    dirty[slot] = 1;
+    hasPrevious[slot] = 0; // Blending across parent spaces would sweep through the world
+    return true;
+}
+
+Transform* TransformSystem::getParent(uint32_t node) const {
+    int32_t parentSlot = parents[idToSlot[node]];
+    if (parentSlot < 0 || slotToId[parentSlot] == INVALID_NODE) return nullptr;
+    return owners[parentSlot];
+}
+
+void TransformSystem::update() {
+    relayout();
+    if (deadSlots > liveNodes) {
+        compact();
+    }
+
+    // Subtrees never share nodes, so ranges of roots are independent
+    JobSystem::getInstance().parallelFor(0, rootRanges.size(), [this](size_t begin, size_t end) {
+        updateRange(rootRanges[begin].first, rootRanges[end - 1].second);
+    });
+    renderMatricesValid = false;
+}
+
+void TransformSystem::savePreviousState() {
+    previousPositions = positions;
+    previousRotations = rotations;
+    previousScales = scales;
+    hasPrevious.assign(hasPrevious.size(), 1);
+}
+
+void TransformSystem::interpolate(float alpha) {
+    // Parent links must be in depth-first order, as for update()
+    relayout();
+
+    JobSystem::getInstance().parallelFor(0, rootRanges.size(), [this, alpha](size_t begin, size_t end) {
+        interpolateRange(rootRanges[begin].first, rootRanges[end - 1].second, alpha);
+    });
+    renderMatricesValid = true;
+}
+
+void TransformSystem::interpolateRange(uint32_t begin, uint32_t end, float alpha) {
+    for (uint32_t i = begin; i < end; ++i) {
+        int32_t parent = parents[i];
+
+        // Nodes that did not move during the tick render at their world matrix
+        bool moved = hasPrevious[i] &&
+            (previousPositions[i] != positions[i] || previousRotations[i] != rotations[i] ||
+             previousScales[i] != scales[i]);
+        bool changed = moved || (parent >= 0 && renderChanged[parent]);
+        renderChanged[i] = changed;
+        if (!changed) {
+            renderMatrices[i] = worldMatrices[i];
+            continue;
+        }
+
+        glm::mat4 local = moved
+            ? composeMatrix(glm::mix(previousPositions[i], positions[i], alpha),
+                            glm::slerp(previousRotations[i], rotations[i], alpha),
+                            glm::mix(previousScales[i], scales[i], alpha))
+            : composeMatrix(positions[i], rotations[i], scales[i]);
+        renderMatrices[i] = parent >= 0 ? multiplyAffine(renderMatrices[parent], local) : local;
+    }
+}
+
+void TransformSystem::updateRange(uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i) {
+        int32_t parent = parents[i];
+
+        // A parent precedes its children, so its flag for this pass is already final
+        bool changed = dirty[i] || (parent >= 0 && worldChanged[parent]);
+        worldChanged[i] = changed;
+        if (!changed) continue;
+
+        dirty[i] = 0;
+        glm::mat4 local = composeMatrix(positions[i], rotations[i], scales[i]);
+        worldMatrices[i] = parent >= 0 ? multiplyAffine(worldMatrices[parent], local) : local;
+    }
+}
+
+uint32_t TransformSystem::findRange(uint32_t slot) const {
+    auto it = std::upper_bound(rootRanges.begin(), rootRanges.end(), slot,
+        [](uint32_t value, const std::pair<uint32_t, uint32_t>& range) { return value < range.first; });
+    return static_cast<uint32_t>(it - rootRanges.begin()) - 1;
+}
+
+void TransformSystem::flagRange(uint32_t slot) {
+    uint32_t range = findRange(slot);
+    if (!rangeNeedsRelayout[range]) {
+        rangeNeedsRelayout[range] = 1;
+        relayoutRanges.push_back(range);
+    }
+}
+
+// Leaves the slot in place as a gap that update() skips
+void TransformSystem::killSlot(uint32_t slot) {
+    slotToId[slot] = INVALID_NODE;
+    owners[slot] = nullptr;
+    parents[slot] = -1;
+    dirty[slot] = 0;
+    hasPrevious[slot] = 0;
+    deadSlots++;
+}
+
+void TransformSystem::relayout() {
+    if (relayoutRanges.empty()) return;
+
+    // Live nodes of the flagged ranges, in slot order. Links between trees
+    // flag both ends, so every live parent of a gathered node is gathered.
+    std::sort(relayoutRanges.begin(), relayoutRanges.end());
+    gathered.clear();
+    for (uint32_t range : relayoutRanges) {
+        for (uint32_t s = rootRanges[range].first; s < rootRanges[range].second; ++s) {
+            if (isAlive(static_cast<int32_t>(s))) gathered.push_back(s);
+        }
+    }
+
+    const uint32_t slotCount = static_cast<uint32_t>(positions.size());
+    const uint32_t count = static_cast<uint32_t>(gathered.size());
+    if (slotRemap.size() < slotCount) {
+        slotRemap.resize(slotCount);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        slotRemap[gathered[i]] = static_cast<int32_t>(i);
+    }
+
+    // Children of each gathered node as a compact adjacency list
+    childStart.assign(count + 1, 0);
+    for (uint32_t s : gathered) {
+        if (isAlive(parents[s])) childStart[slotRemap[parents[s]] + 1]++;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        childStart[i + 1] += childStart[i];
+    }
+    children.resize(childStart[count]);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t s = gathered[i];
+        if (isAlive(parents[s])) children[childStart[slotRemap[parents[s]]]++] = i;
+    }
+    for (uint32_t i = count; i > 0; --i) {
+        childStart[i] = childStart[i - 1];
+    }
+    childStart[0] = 0;
+
+    // Depth-first walk from every root; orphans of destroyed parents become
+    // roots. The new trees are appended as ranges of their own.
+    order.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (isAlive(parents[gathered[i]])) continue;
+
+        uint32_t rangeBegin = slotCount + static_cast<uint32_t>(order.size());
+        stack.push_back(i);
+        while (!stack.empty()) {
+            uint32_t current = stack.back();
+            stack.pop_back();
+            order.push_back(gathered[current]);
+            for (uint32_t c = childStart[current + 1]; c > childStart[current]; --c) {
+                stack.push_back(children[c - 1]);
+            }
+        }
+        rootRanges.emplace_back(rangeBegin, slotCount + static_cast<uint32_t>(order.size()));
+        rangeNeedsRelayout.push_back(0);
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        slotRemap[order[i]] = static_cast<int32_t>(slotCount + i);
+    }
+    for (uint32_t old : order) {
+        int32_t parent = parents[old];
+        bool orphaned = parent >= 0 && !isAlive(parent);
+
+        idToSlot[slotToId[old]] = static_cast<uint32_t>(positions.size());
+        positions.push_back(positions[old]);
+        rotations.push_back(rotations[old]);
+        scales.push_back(scales[old]);
+        worldMatrices.push_back(worldMatrices[old]);
+        parents.push_back(isAlive(parent) ? slotRemap[parent] : -1);
+        dirty.push_back(dirty[old] || orphaned);
+        worldChanged.push_back(0);
+        slotToId.push_back(slotToId[old]);
+        owners.push_back(owners[old]);
+        previousPositions.push_back(previousPositions[old]);
+        previousRotations.push_back(previousRotations[old]);
+        previousScales.push_back(previousScales[old]);
+        hasPrevious.push_back(hasPrevious[old] && !orphaned);
+        renderChanged.push_back(0);
+        renderMatrices.push_back(renderMatrices[old]);
+    }
+
+    // The flagged ranges are now all gaps
+    for (uint32_t old : order) {
+        killSlot(old);
+    }
+    for (uint32_t range : relayoutRanges) {
+        rangeNeedsRelayout[range] = 0;
+        if (rootRanges[range].second - rootRanges[range].first == 1) {
+            freeRootSlots.push_back(rootRanges[range].first);
+        }
+    }
+    relayoutRanges.clear();
+}
+
+// Squeezes out dead slots in place. Relative order is kept, so parents still
+// precede their children and every range stays contiguous.
+void TransformSystem::compact() {
+    const uint32_t slotCount = static_cast<uint32_t>(positions.size());
+    if (slotRemap.size() < slotCount) {
+        slotRemap.resize(slotCount);
+    }
+
+    uint32_t write = 0;
+    size_t keptRanges = 0;
+    for (const auto& range : rootRanges) {
+        uint32_t rangeBegin = write;
+        for (uint32_t s = range.first; s < range.second; ++s) {
+            if (!isAlive(static_cast<int32_t>(s))) continue;
+
+            slotRemap[s] = static_cast<int32_t>(write);
+            positions[write] = positions[s];
+            rotations[write] = rotations[s];
+            scales[write] = scales[s];
+            worldMatrices[write] = worldMatrices[s];
+            parents[write] = parents[s] >= 0 ? slotRemap[parents[s]] : -1;
+            dirty[write] = dirty[s];
+            worldChanged[write] = worldChanged[s];
+            slotToId[write] = slotToId[s];
+            owners[write] = owners[s];
+            previousPositions[write] = previousPositions[s];
+            previousRotations[write] = previousRotations[s];
+            previousScales[write] = previousScales[s];
+            hasPrevious[write] = hasPrevious[s];
+            renderChanged[write] = renderChanged[s];
+            renderMatrices[write] = renderMatrices[s];
+            idToSlot[slotToId[write]] = write;
+            ++write;
+        }
+        if (write > rangeBegin) {
+            rootRanges[keptRanges++] = { rangeBegin, write };
+        }
+    }
+
+    positions.resize(write);
+    rotations.resize(write);
+    scales.resize(write);
+    worldMatrices.resize(write);
+    parents.resize(write);
+    dirty.resize(write);
+    worldChanged.resize(write);
+    slotToId.resize(write);
+    owners.resize(write);
+    previousPositions.resize(write);
+    previousRotations.resize(write);
+    previousScales.resize(write);
+    hasPrevious.resize(write);
+    renderChanged.resize(write);
+    renderMatrices.resize(write);
+    rootRanges.resize(keptRanges);
+    rangeNeedsRelayout.assign(keptRanges, 0);
+    freeRootSlots.clear();
+    deadSlots = 0;
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+class Transform;
+
+// Owns the data behind every Transform. Local TRS, parent links and world
+// matrices live in parallel arrays kept in depth-first order, so parents
+// always precede their children and each root's subtree is one contiguous
+// range. World matrices are then refreshed in a single forward pass.
+//
+// Structural changes stay local. A destroyed leaf leaves a dead slot in
+// place; dead root slots are reused by the next node created. Reparenting,
+// or destroying a node that has children, only re-sorts the root ranges
+// involved: their nodes are laid out again at the end of the arrays. Dead
+// slots are compacted away once they outnumber the live ones.
+class TransformSystem {
+public:
+    static constexpr uint32_t INVALID_NODE = 0xFFFFFFFFu;
+
+    static TransformSystem& getInstance() {
+        static TransformSystem instance;
+        return instance;
+    }
+
+    // Node ids are stable; the slot a node occupies changes when the
+    // hierarchy is re-sorted
+    uint32_t createNode(Transform* owner);
+    void destroyNode(uint32_t node);
+    void setOwner(uint32_t node, Transform* owner) { owners[idToSlot[node]] = owner; }
+
+    // Returns false if the link would create a cycle
+    bool setParent(uint32_t node, uint32_t parent);
+    Transform* getParent(uint32_t node) const;
+
+    glm::vec3& localPosition(uint32_t node) { return positions[idToSlot[node]]; }
+    glm::quat& localRotation(uint32_t node) { return rotations[idToSlot[node]]; }
+    glm::vec3& localScale(uint32_t node) { return scales[idToSlot[node]]; }
+    const glm::mat4& getWorldMatrix(uint32_t node) const { return worldMatrices[idToSlot[node]]; }
+
+    void markDirty(uint32_t node) { dirty[idToSlot[node]] = 1; }
+
+    // True if the node's world matrix changed during the last update()
+    bool hasWorldChanged(uint32_t node) const { return worldChanged[idToSlot[node]] != 0; }
+
+    // Re-sorts the trees whose hierarchy changed, then recomputes the world matrix of
+    // every dirty node and its descendants. Independent subtrees are spread
+    // across the JobSystem.
+    void update();
+
+    // Render interpolation for fixed-timestep loops: call savePreviousState()
+    // before each simulation tick, then interpolate() once per rendered frame
+    // to blend the last two ticks. Until interpolate() runs after an update,
+    // render matrices are the world matrices.
+    void savePreviousState();
+    void interpolate(float alpha);
+    const glm::mat4& getRenderMatrix(uint32_t node) const {
+        uint32_t slot = idToSlot[node];
+        return renderMatricesValid ? renderMatrices[slot] : worldMatrices[slot];
+    }
+
+    // Renders the node at its current state until the next tick, e.g. after a teleport
+    void snap(uint32_t node) { hasPrevious[idToSlot[node]] = 0; }
+
+    size_t getNodeCount() const { return liveNodes; }
+
+    // T * R * S built directly from the quaternion, without matrix products
+    static glm::mat4 composeMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+
+private:
+    TransformSystem() = default;
+    ~TransformSystem() = default;
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    // Per-slot data, depth-first order
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+    std::vector<glm::mat4> worldMatrices;
+    std::vector<int32_t> parents;        // Parent slot, -1 for roots
+    std::vector<uint8_t> dirty;          // Local TRS or parent link changed
+    std::vector<uint8_t> worldChanged;   // Written by the last update()
+    std::vector<uint32_t> slotToId;      // INVALID_NODE for destroyed slots
+    std::vector<Transform*> owners;
+
+    // Local TRS as of the start of the current tick, and the blended result
+    std::vector<glm::vec3> previousPositions;
+    std::vector<glm::quat> previousRotations;
+    std::vector<glm::vec3> previousScales;
+    std::vector<uint8_t> hasPrevious;    // 0 for nodes created or snapped since the last save
+    std::vector<uint8_t> renderChanged;  // Written by the last interpolate()
+    std::vector<glm::mat4> renderMatrices;
+
+    // Stable id -> slot; ids of destroyed nodes are recycled
+    std::vector<uint32_t> idToSlot;
+    std::vector<uint32_t> freeIds;
+
+    // Contiguous [begin, end) slot range of each root's subtree, in slot
+    // order and covering every slot, dead ones included
+    std::vector<std::pair<uint32_t, uint32_t>> rootRanges;
+    std::vector<uint8_t> rangeNeedsRelayout;
+    std::vector<uint32_t> relayoutRanges;  // Indices of the flagged ranges
+    std::vector<uint32_t> freeRootSlots;   // Dead slots that are a range of their own
+    size_t deadSlots = 0;
+
+    // Scratch for relayout() and compact(), kept so capacity is reused
+    std::vector<int32_t> slotRemap;
+    std::vector<uint32_t> gathered;
+    std::vector<uint32_t> childStart;
+    std::vector<uint32_t> children;
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> stack;
+
+    size_t liveNodes = 0;
+    bool renderMatricesValid = false;
+
+    bool isAlive(int32_t slot) const { return slot >= 0 && slotToId[slot] != INVALID_NODE; }
+    uint32_t findRange(uint32_t slot) const;
+    void flagRange(uint32_t slot);
+    void killSlot(uint32_t slot);
+    void relayout();
+    void compact();
+    void updateRange(uint32_t begin, uint32_t end);
+    void interpolateRange(uint32_t begin, uint32_t end, float alpha);
+};
@@ -0,0 +1,227 @@
+#include "AllocationTracker.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> allocationCount{ 0 };
+    std::atomic<uint64_t> freeCount{ 0 };
+    std::atomic<uint64_t> bytesAllocated{ 0 };
+
+    constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::Count);
+
+    const char* const TAG_NAMES[TAG_COUNT] = {
+        "Untagged", "Scene", "Physics", "Sculpt", "Painting", "Resources", "Effects"
+    };
+}
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+
+bool AllocationTracker::isEnabled() { return true; }
+
+namespace {
+    struct TagCounters {
+        std::atomic<uint64_t> currentBytes{ 0 };
+        std::atomic<uint64_t> peakBytes{ 0 };
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> frees{ 0 };
+        std::atomic<uint64_t> frameAllocations{ 0 };
+        std::atomic<uint64_t> frameStartAllocations{ 0 };
+    };
+
+    // Constant-initialised, so usable by allocations made during static init
+    TagCounters tagCounters[TAG_COUNT];
+    thread_local MemoryTag currentTag = MemoryTag::Untagged;
+    std::atomic<uint64_t> frameIndex{ 0 };
+    std::atomic<uint64_t> dumpInterval{ 0 };
+
+    // Sits directly in front of every pointer handed out. `offset` is the
+    // distance back to the start of the underlying block.
+    struct alignas(16) AllocationHeader {
+        uint64_t size;
+        uint32_t offset;
+        MemoryTag tag;
+    };
+    static_assert(sizeof(AllocationHeader) == 16, "Header must keep 16-byte alignment");
+
+    void* track(void* block, size_t size, size_t offset) {
+        if (!block) return nullptr;
+
+        MemoryTag tag = currentTag;
+        auto* user = static_cast<unsigned char*>(block) + offset;
+        auto* header = reinterpret_cast<AllocationHeader*>(user) - 1;
+        header->size = size;
+        header->offset = static_cast<uint32_t>(offset);
+        header->tag = tag;
+
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+        TagCounters& counters = tagCounters[static_cast<size_t>(tag)];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        uint64_t current = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+        while (current > peak && !counters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+        return user;
+    }
+
+    // Returns the start of the underlying block
+    void* untrack(void* ptr) {
+        auto* header = static_cast<AllocationHeader*>(ptr) - 1;
+        freeCount.fetch_add(1, std::memory_order_relaxed);
+
+        TagCounters& counters = tagCounters[static_cast<size_t>(header->tag)];
+        counters.frees.fetch_add(1, std::memory_order_relaxed);
+        counters.currentBytes.fetch_sub(header->size, std::memory_order_relaxed);
+        return static_cast<unsigned char*>(ptr) - header->offset;
+    }
+
+    void* trackedAllocate(size_t size) {
+        return track(std::malloc(size + sizeof(AllocationHeader)), size, sizeof(AllocationHeader));
+    }
+
+    void* trackedAllocateAligned(size_t size, size_t alignment) {
+        // The header takes a whole alignment step so the user pointer stays aligned
+        size_t offset = alignment > sizeof(AllocationHeader) ? alignment : sizeof(AllocationHeader);
+#ifdef _MSC_VER
+        void* block = _aligned_malloc(size + offset, alignment);
+#else
+        // aligned_alloc needs the size to be a multiple of the alignment
+        size_t padded = (size + offset + alignment - 1) & ~(alignment - 1);
+        void* block = std::aligned_alloc(alignment, padded);
+#endif
+        return track(block, size, offset);
+    }
+
+    void trackedFree(void* ptr) {
+        if (!ptr) return;
+        std::free(untrack(ptr));
+    }
+
+    void trackedFreeAligned(void* ptr) {
+        if (!ptr) return;
+#ifdef _MSC_VER
+        _aligned_free(untrack(ptr));
+#else
+        std::free(untrack(ptr));
+#endif
+    }
+
+    void* throwIfNull(void* ptr) {
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+}
+
+void* operator new(size_t size) { return throwIfNull(trackedAllocate(size)); }
+void* operator new[](size_t size) { return throwIfNull(trackedAllocate(size)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return throwIfNull(trackedAllocateAligned(size, static_cast<size_t>(alignment)));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return throwIfNull(trackedAllocateAligned(size, static_cast<size_t>(alignment)));
+}
+
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { trackedFreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { trackedFreeAligned(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { trackedFreeAligned(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { trackedFreeAligned(ptr); }
+
+AllocationTracker::TagStats AllocationTracker::getTagStats(MemoryTag tag) {
+    const TagCounters& counters = tagCounters[static_cast<size_t>(tag)];
+    TagStats stats;
+    stats.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.frees = counters.frees.load(std::memory_order_relaxed);
+    stats.frameAllocations = counters.frameAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AllocationTracker::resetPeaks() {
+    for (TagCounters& counters : tagCounters) {
+        counters.peakBytes.store(counters.currentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void AllocationTracker::endFrame() {
+    for (TagCounters& counters : tagCounters) {
+        uint64_t allocations = counters.allocations.load(std::memory_order_relaxed);
+        uint64_t start = counters.frameStartAllocations.exchange(allocations, std::memory_order_relaxed);
+        counters.frameAllocations.store(allocations - start, std::memory_order_relaxed);
+    }
+
+    uint64_t frame = frameIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t interval = dumpInterval.load(std::memory_order_relaxed);
+    if (interval && frame % interval == 0) {
+        dump(std::cout);
+    }
+}
+
+void AllocationTracker::setDumpInterval(uint64_t frames) {
+    dumpInterval.store(frames, std::memory_order_relaxed);
+}
+
+MemoryTag AllocationTracker::getCurrentTag() { return currentTag; }
+void AllocationTracker::setCurrentTag(MemoryTag tag) { currentTag = tag; }
+
+#else
+
+bool AllocationTracker::isEnabled() { return false; }
+
+AllocationTracker::TagStats AllocationTracker::getTagStats(MemoryTag) { return TagStats(); }
+void AllocationTracker::resetPeaks() {}
+void AllocationTracker::endFrame() {}
+void AllocationTracker::setDumpInterval(uint64_t) {}
+MemoryTag AllocationTracker::getCurrentTag() { return MemoryTag::Untagged; }
+void AllocationTracker::setCurrentTag(MemoryTag) {}
+
+#endif
+
+uint64_t AllocationTracker::getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationTracker::getFreeCount() {
+    return freeCount.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationTracker::getBytesAllocated() {
+    return bytesAllocated.load(std::memory_order_relaxed);
+}
+
+const char* AllocationTracker::getTagName(MemoryTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return index < TAG_COUNT ? TAG_NAMES[index] : "Unknown";
+}
+
+void AllocationTracker::dump(std::ostream& out) {
+    if (!isEnabled()) {
+        out << "Memory tracking disabled: build with ENGINE_TRACK_ALLOCATIONS=ON" << std::endl;
+        return;
+    }
+
+    out << std::left << std::setw(12) << "subsystem"
+        << std::right << std::setw(14) << "live KiB"
+        << std::setw(14) << "peak KiB"
+        << std::setw(14) << "live allocs"
+        << std::setw(14) << "frame allocs" << std::endl;
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        TagStats stats = getTagStats(static_cast<MemoryTag>(i));
+        out << std::left << std::setw(12) << TAG_NAMES[i]
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(14) << stats.currentBytes / 1024.0
+            << std::setw(14) << stats.peakBytes / 1024.0
+            << std::setw(14) << stats.getLiveAllocations()
+            << std::setw(14) << stats.frameAllocations << std::endl;
+    }
+}
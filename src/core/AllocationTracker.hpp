@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Subsystems heap allocations are charged to. The tag is per thread and set
+// with MEMORY_TAG; jobs inherit the tag of the thread that scheduled them.
+enum class MemoryTag : uint8_t {
+    Untagged,
+    Scene,
+    Physics,
+    Sculpt,
+    Painting,
+    Resources,
+    Effects,
+    Count
+};
+
+// Counts every global operator new when the engine is built with
+// ENGINE_TRACK_ALLOCATIONS. Without it the counters always read zero and
+// isEnabled() is false, so checks can be left in place.
+//
+// Tracked allocations carry a small header recording their size and tag, so
+// frees are charged back to the subsystem that allocated, wherever they
+// happen. That gives live bytes and a high-water mark per tag.
+class AllocationTracker {
+public:
+    struct TagStats {
+        uint64_t currentBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t allocations = 0;       // Since startup
+        uint64_t frees = 0;
+        uint64_t frameAllocations = 0;  // During the last completed frame
+
+        uint64_t getLiveAllocations() const { return allocations - frees; }
+    };
+
+    static bool isEnabled();
+
+    static uint64_t getAllocationCount();
+    static uint64_t getFreeCount();
+    static uint64_t getBytesAllocated();
+
+    static TagStats getTagStats(MemoryTag tag);
+    static const char* getTagName(MemoryTag tag);
+
+    // Peaks restart from the current live bytes, e.g. after loading a level
+    static void resetPeaks();
+
+    // Closes a frame for the per-frame counts, and dumps every
+    // `dumpInterval` frames when one is set
+    static void endFrame();
+    static void setDumpInterval(uint64_t frames);
+
+    // One line per tag: live, peak, live allocation count, last frame's allocations
+    static void dump(std::ostream& out);
+
+    static MemoryTag getCurrentTag();
+    static void setCurrentTag(MemoryTag tag);
+};
+
+// Charges allocations on this thread to `tag` until the end of the scope
+class MemoryTagScope {
+public:
+    explicit MemoryTagScope(MemoryTag tag)
+        : previous(AllocationTracker::getCurrentTag())
+    {
+        AllocationTracker::setCurrentTag(tag);
+    }
+
+    ~MemoryTagScope() {
+        AllocationTracker::setCurrentTag(previous);
+    }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+    MemoryTag previous;
+};
+
+// Allocations made on any thread between construction and getCount()
+class ScopedAllocationCounter {
+public:
+    ScopedAllocationCounter()
+        : startCount(AllocationTracker::getAllocationCount())
+        , startBytes(AllocationTracker::getBytesAllocated())
+    {}
+
+    uint64_t getCount() const { return AllocationTracker::getAllocationCount() - startCount; }
+    uint64_t getBytes() const { return AllocationTracker::getBytesAllocated() - startBytes; }
+
+private:
+    uint64_t startCount;
+    uint64_t startBytes;
+};
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+#define MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define MEMORY_TAG_CONCAT(a, b) MEMORY_TAG_CONCAT_INNER(a, b)
+#define MEMORY_TAG(tag) MemoryTagScope MEMORY_TAG_CONCAT(memoryTagScope, __LINE__)(MemoryTag::tag)
+#define MEMORY_FRAME() AllocationTracker::endFrame()
+#else
+#define MEMORY_TAG(tag) ((void)0)
+#define MEMORY_FRAME() ((void)0)
+#endif
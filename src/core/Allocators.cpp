@@ -0,0 +1,153 @@
+#include "Allocators.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+namespace {
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Every live thread arena, so the frame boundary can reset them all
+    std::mutex arenaRegistryMutex;
+    std::vector<FrameArena*>& arenaRegistry() {
+        static std::vector<FrameArena*> arenas;
+        return arenas;
+    }
+
+    struct ThreadArena {
+        std::unique_ptr<FrameArena> arena;
+
+        ThreadArena() : arena(new FrameArena()) {
+            std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+            arenaRegistry().push_back(arena.get());
+        }
+
+        ~ThreadArena() {
+            std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+            auto& arenas = arenaRegistry();
+            arenas.erase(std::remove(arenas.begin(), arenas.end(), arena.get()), arenas.end());
+        }
+    };
+}
+
+// BlockPool implementation
+BlockPool::BlockPool(size_t size, size_t align, size_t perSlab)
+    : blockSize(alignUp(std::max(size, sizeof(FreeBlock)), align))
+    , alignment(std::max(align, alignof(FreeBlock)))
+    , blocksPerSlab(std::max<size_t>(1, perSlab))
+    , liveBlocks(0)
+    , freeList(nullptr)
+{}
+
+BlockPool::~BlockPool() {
+    for (std::byte* slab : slabs) {
+        ::operator delete(slab, std::align_val_t(alignment));
+    }
+}
+
+void* BlockPool::allocate() {
+    if (!freeList) {
+        addSlab();
+    }
+
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    liveBlocks++;
+    return block;
+}
+
+void BlockPool::deallocate(void* block) {
+    if (!block) return;
+
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeList;
+    freeList = freed;
+    liveBlocks--;
+}
+
+void BlockPool::addSlab() {
+    std::byte* slab = static_cast<std::byte*>(::operator new(blockSize * blocksPerSlab, std::align_val_t(alignment)));
+    slabs.push_back(slab);
+
+    // Thread the new blocks onto the free list in address order
+    for (size_t i = blocksPerSlab; i > 0; --i) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * blockSize);
+        block->next = freeList;
+        freeList = block;
+    }
+}
+
+// FrameArena implementation
+FrameArena::FrameArena(size_t initialCapacity)
+    : buffer(nullptr)
+    , capacity(initialCapacity)
+    , used(0)
+    , overflowBytes(0)
+{
+    buffer = static_cast<std::byte*>(::operator new(capacity, std::align_val_t(alignof(std::max_align_t))));
+}
+
+FrameArena::~FrameArena() {
+    reset();
+    ::operator delete(buffer, std::align_val_t(alignof(std::max_align_t)));
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+    size_t offset = alignUp(base + used, alignment) - base;
+    if (offset + size <= capacity) {
+        used = offset + size;
+        return buffer + offset;
+    }
+
+    // Out of room this frame: serve from a dedicated block and remember the
+    // demand so the next reset can grow the main buffer
+    size_t blockAlignment = std::max(alignment, alignof(std::max_align_t));
+    std::byte* block = static_cast<std::byte*>(::operator new(size, std::align_val_t(blockAlignment)));
+    overflowBlocks.emplace_back(block, blockAlignment);
+    overflowBytes += size + alignment;
+    return block;
+}
+
+void FrameArena::reset() {
+    if (!overflowBlocks.empty()) {
+        for (const auto& block : overflowBlocks) {
+            ::operator delete(block.first, std::align_val_t(block.second));
+        }
+        overflowBlocks.clear();
+
+        size_t required = used + overflowBytes;
+        ::operator delete(buffer, std::align_val_t(alignof(std::max_align_t)));
+        capacity = std::max(capacity * 2, required);
+        buffer = static_cast<std::byte*>(::operator new(capacity, std::align_val_t(alignof(std::max_align_t))));
+    }
+
+    used = 0;
+    overflowBytes = 0;
+}
+
+void FrameArena::reserve(size_t bytes) {
+    if (bytes <= capacity) return;
+
+    ::operator delete(buffer, std::align_val_t(alignof(std::max_align_t)));
+    capacity = std::max(capacity * 2, bytes);
+    buffer = static_cast<std::byte*>(::operator new(capacity, std::align_val_t(alignof(std::max_align_t))));
+}
+
+FrameArena& FrameArena::getThreadArena() {
+    thread_local ThreadArena threadArena;
+    return *threadArena.arena;
+}
+
+void FrameArena::resetAll() {
+    std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+    size_t frameBytes = 0;
+    for (FrameArena* arena : arenaRegistry()) {
+        frameBytes += arena->getUsed();
+    }
+    for (FrameArena* arena : arenaRegistry()) {
+        arena->reset();
+        arena->reserve(frameBytes);
+    }
+}
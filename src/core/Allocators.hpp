@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Fixed-size blocks carved out of larger slabs. Freed blocks go onto an
+// intrusive free list and are reused before any new slab is allocated, so a
+// pool that has reached its high-water mark never touches the heap again.
+// Not thread-safe.
+class BlockPool {
+public:
+    BlockPool(size_t blockSize, size_t alignment, size_t blocksPerSlab);
+    ~BlockPool();
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    void* allocate();
+    void deallocate(void* block);
+
+    size_t getBlockSize() const { return blockSize; }
+    size_t getLiveCount() const { return liveBlocks; }
+    size_t getCapacity() const { return slabs.size() * blocksPerSlab; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    size_t blockSize;
+    size_t alignment;
+    size_t blocksPerSlab;
+    size_t liveBlocks;
+    FreeBlock* freeList;
+    std::vector<std::byte*> slabs;
+
+    void addSlab();
+};
+
+// Typed object pool on top of a BlockPool
+template<typename T>
+class ObjectPool {
+public:
+    explicit ObjectPool(size_t objectsPerSlab = 256)
+        : pool(sizeof(T) < sizeof(void*) ? sizeof(void*) : sizeof(T), alignof(T), objectsPerSlab)
+    {}
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        return new (pool.allocate()) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* object) {
+        if (!object) return;
+        object->~T();
+        pool.deallocate(object);
+    }
+
+    size_t getLiveCount() const { return pool.getLiveCount(); }
+
+private:
+    BlockPool pool;
+};
+
+// Linear allocator for data that only lives until the end of the frame.
+// Allocation is a pointer bump; individual frees are no-ops and reset()
+// releases everything at once. If a frame overflows the current block, the
+// arena grows to fit on the next reset so steady-state frames stay in one
+// block. resetAll() also sizes every thread's arena for the whole previous
+// frame, since work stealing can hand all of it to any one thread.
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    void reset();
+
+    // Grows the main buffer to at least `bytes`. Only valid while the arena is empty.
+    void reserve(size_t bytes);
+
+    size_t getUsed() const { return used + overflowBytes; }
+    size_t getCapacity() const { return capacity; }
+
+    // Arena of the calling thread, created on first use
+    static FrameArena& getThreadArena();
+
+    // Resets every thread's arena. Call once per frame while no jobs are running.
+    static void resetAll();
+
+private:
+    std::byte* buffer;
+    size_t capacity;
+    size_t used;
+
+    // Blocks (and their alignment) allocated after the main buffer filled up; freed on reset
+    std::vector<std::pair<std::byte*, size_t>> overflowBlocks;
+    size_t overflowBytes;
+};
+
+// Standard allocator that bumps the calling thread's FrameArena. Containers
+// using it must not outlive the frame they were filled in.
+template<typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator() = default;
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(FrameArena::getThreadArena().allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>&) const { return false; }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
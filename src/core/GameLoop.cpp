@@ -0,0 +1,91 @@
+#include "GameLoop.hpp"
+#include "Profiler.hpp"
+#include "AllocationTracker.hpp"
+#include "../components/TransformSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+
+namespace {
+    double nowMs() {
+        using namespace std::chrono;
+        return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+GameLoop::GameLoop()
+    : GameLoop(Settings())
+{}
+
+GameLoop::GameLoop(const Settings& loopSettings)
+    : settings(loopSettings)
+    , fixedDeltaTime(1.0 / std::max(1.0, loopSettings.tickRate))
+    , accumulator(0.0)
+{
+    settings.maxTicksPerFrame = std::max(1, settings.maxTicksPerFrame);
+}
+
+void GameLoop::frame(double elapsedSeconds, const TickFunction& tick, const RenderFunction& render) {
+    double frameStart = nowMs();
+    TransformSystem& transforms = TransformSystem::getInstance();
+
+    // Whole ticks are counted up front so rounding in the accumulator never
+    // costs a tick. After a hitch, simulate at most the catch-up budget and
+    // let the game fall behind real time instead of spiralling into ever
+    // longer frames.
+    accumulator += std::max(0.0, elapsedSeconds);
+    int64_t due = static_cast<int64_t>(accumulator / fixedDeltaTime);
+    int ticks = static_cast<int>(std::min<int64_t>(due, settings.maxTicksPerFrame));
+    timings.droppedMs = static_cast<double>(due - ticks) * fixedDeltaTime * 1000.0;
+    accumulator = std::max(0.0, accumulator - static_cast<double>(due) * fixedDeltaTime);
+
+    timings.ticks = ticks;
+    for (int i = 0; i < ticks; ++i) {
+        PROFILE_SCOPE("GameLoop::tick");
+        double tickStart = nowMs();
+        if (settings.interpolate) {
+            transforms.savePreviousState();
+        }
+        tick(static_cast<float>(fixedDeltaTime));
+        double tickMs = nowMs() - tickStart;
+
+        timings.totalTicks++;
+        timings.totalTickMs += tickMs;
+        timings.maxTickMs = std::max(timings.maxTickMs, tickMs);
+    }
+
+    double renderStart = nowMs();
+    timings.simulationMs = renderStart - frameStart;
+    timings.alpha = static_cast<float>(accumulator / fixedDeltaTime);
+    {
+        PROFILE_SCOPE("GameLoop::render");
+        if (settings.interpolate) {
+            transforms.interpolate(timings.alpha);
+        }
+        render(timings.alpha);
+    }
+
+    double frameEnd = nowMs();
+    timings.renderMs = frameEnd - renderStart;
+    timings.frameMs = frameEnd - frameStart;
+    timings.totalFrames++;
+    timings.totalFrameMs += timings.frameMs;
+    timings.maxFrameMs = std::max(timings.maxFrameMs, timings.frameMs);
+    timings.totalDroppedMs += timings.droppedMs;
+
+    PROFILE_FRAME();
+    MEMORY_FRAME();
+}
+
+void GameLoop::printTimings(std::ostream& out) const {
+    double tickBudgetMs = fixedDeltaTime * 1000.0;
+    out << std::fixed << std::setprecision(3)
+        << "Ticks: " << timings.totalTicks << " @ " << settings.tickRate << " Hz, avg "
+        << timings.averageTickMs() << " ms, max " << timings.maxTickMs << " ms ("
+        << std::setprecision(1) << 100.0 * timings.averageTickMs() / tickBudgetMs << "% of budget)"
+        << std::setprecision(3)
+        << " | Frames: " << timings.totalFrames << ", avg " << timings.averageFrameMs()
+        << " ms, max " << timings.maxFrameMs << " ms"
+        << " | Dropped: " << timings.totalDroppedMs << " ms\n";
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+
+// Fixed-timestep frame driver. Real elapsed time is banked in an
+// accumulator and spent in whole simulation ticks of 1/tickRate seconds, so
+// physics and gameplay always see the same deltaTime regardless of the render
+// rate. The leftover fraction of a tick becomes the alpha used to blend
+// Transform state for rendering.
+class GameLoop {
+public:
+    struct Settings {
+        double tickRate = 60.0;     // Simulation ticks per second
+        int maxTicksPerFrame = 5;   // Catch-up budget; time beyond it is dropped
+        bool interpolate = true;    // Off when nothing renders (headless runs)
+    };
+
+    struct Timings {
+        // Last frame
+        int ticks = 0;
+        double frameMs = 0.0;       // Ticks plus render
+        double simulationMs = 0.0;  // All ticks of the frame
+        double renderMs = 0.0;
+        double droppedMs = 0.0;     // Simulated time skipped by the catch-up cap
+        float alpha = 0.0f;
+
+        // Since the last reset
+        uint64_t totalTicks = 0;
+        uint64_t totalFrames = 0;
+        double totalTickMs = 0.0;
+        double maxTickMs = 0.0;
+        double totalFrameMs = 0.0;
+        double maxFrameMs = 0.0;
+        double totalDroppedMs = 0.0;
+
+        double averageTickMs() const { return totalTicks ? totalTickMs / totalTicks : 0.0; }
+        double averageFrameMs() const { return totalFrames ? totalFrameMs / totalFrames : 0.0; }
+    };
+
+    using TickFunction = std::function<void(float deltaTime)>;
+    using RenderFunction = std::function<void(float alpha)>;
+
+    GameLoop();
+    explicit GameLoop(const Settings& settings);
+
+    // Banks `elapsedSeconds` of real time, runs the ticks it pays for, then
+    // interpolates transforms and renders once
+    void frame(double elapsedSeconds, const TickFunction& tick, const RenderFunction& render);
+
+    float getFixedDeltaTime() const { return static_cast<float>(fixedDeltaTime); }
+    const Settings& getSettings() const { return settings; }
+
+    const Timings& getTimings() const { return timings; }
+    void resetTimings() { timings = Timings(); }
+
+    // One-line summary: tick and frame averages/maxima and the tick budget used
+    void printTimings(std::ostream& out) const;
+
+private:
+    Settings settings;
+    double fixedDeltaTime;
+    double accumulator;
+    Timings timings;
+};
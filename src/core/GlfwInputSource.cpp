@@ -0,0 +1,69 @@
+#include "GlfwInputSource.hpp"
+#include "Input.hpp"
+
+GlfwInputSource::GlfwInputSource(GLFWwindow* window)
+    : window(window)
+    , mousePosition(0.0f)
+    , pendingScroll(0.0f)
+{
+    mouseState.fill(false);
+
+    // Set callbacks
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetScrollCallback(window, scrollCallback);
+
+    double x, y;
+    glfwGetCursorPos(window, &x, &y);
+    mousePosition = glm::vec2(x, y);
+}
+
+GlfwInputSource::~GlfwInputSource() {
+    glfwSetKeyCallback(window, nullptr);
+    glfwSetMouseButtonCallback(window, nullptr);
+    glfwSetCursorPosCallback(window, nullptr);
+    glfwSetScrollCallback(window, nullptr);
+    glfwSetWindowUserPointer(window, nullptr);
+}
+
+void GlfwInputSource::poll(Input& input) {
+    for (const auto& [key, pressed] : keyState) {
+        input.setKey(key, pressed);
+    }
+    for (int button = 0; button < MouseButton::Count; ++button) {
+        input.setMouseButton(button, mouseState[button]);
+    }
+    input.setMousePosition(mousePosition);
+    input.addScroll(pendingScroll);
+    pendingScroll = 0.0f;
+}
+
+void GlfwInputSource::setCursorLocked(bool locked) {
+    glfwSetInputMode(window, GLFW_CURSOR,
+                     locked ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+}
+
+void GlfwInputSource::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    auto source = static_cast<GlfwInputSource*>(glfwGetWindowUserPointer(window));
+    if (key == GLFW_KEY_UNKNOWN || action == GLFW_REPEAT) return;
+    source->keyState[key] = (action == GLFW_PRESS);
+}
+
+void GlfwInputSource::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    auto source = static_cast<GlfwInputSource*>(glfwGetWindowUserPointer(window));
+    if (button < MouseButton::Count) {
+        source->mouseState[button] = (action == GLFW_PRESS);
+    }
+}
+
+void GlfwInputSource::cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
+    auto source = static_cast<GlfwInputSource*>(glfwGetWindowUserPointer(window));
+    source->mousePosition = glm::vec2(xpos, ypos);
+}
+
+void GlfwInputSource::scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
+    auto source = static_cast<GlfwInputSource*>(glfwGetWindowUserPointer(window));
+    source->pendingScroll += static_cast<float>(yoffset);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <unordered_map>
+#include "InputSource.hpp"
+#include "KeyCodes.hpp"
+
+// Window input. GLFW callbacks collect events between ticks and poll()
+// hands the latest state to Input.
+class GlfwInputSource : public InputSource {
+public:
+    explicit GlfwInputSource(GLFWwindow* window);
+    ~GlfwInputSource() override;
+
+    void poll(Input& input) override;
+    void setCursorLocked(bool locked) override;
+
+private:
+    GLFWwindow* window;
+
+    std::unordered_map<int, bool> keyState;
+    std::array<bool, MouseButton::Count> mouseState;
+    glm::vec2 mousePosition;
+    float pendingScroll;
+
+    // Callback functions
+    static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
+    static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+};
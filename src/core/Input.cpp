@@ -1,34 +1,61 @@
 #include "Input.hpp"
+#include "Random.hpp"
+#include "ReplayInputSource.hpp"
+
+Input::Input()
+    : replay(nullptr)
+    , recordingTick(0)
+    , mousePosition(0.0f)
+    , previousMousePosition(0.0f)
+    , mouseDelta(0.0f)
+    , scrollDelta(0.0f)
+{
+    currentMouseState.fill(false);
+    previousMouseState.fill(false);
+}
 
-void Input::initialize(GLFWwindow* window) {
-    this->window = window;
+void Input::setSource(std::unique_ptr<InputSource> newSource) {
+    // Held keys are dropped below; a recording has to see them released
+    if (recording) {
+        for (const auto& [key, pressed] : currentKeyState) {
+            if (pressed) record(InputRecording::EventType::KeyUp, key);
+        }
+        for (int button = 0; button < MouseButton::Count; ++button) {
+            if (currentMouseState[button]) record(InputRecording::EventType::ButtonUp, button);
+        }
+    }
 
-    // Set callbacks
-    glfwSetWindowUserPointer(window, this);
-    glfwSetMouseButtonCallback(window, mouseButtonCallback);
-    glfwSetCursorPosCallback(window, cursorPosCallback);
-    glfwSetScrollCallback(window, scrollCallback);
+    source = std::move(newSource);
+    replay = nullptr;
 
-    // Initialize mouse state
+    // Nothing carries over from the previous device
+    currentKeyState.clear();
+    previousKeyState.clear();
     currentMouseState.fill(false);
     previousMouseState.fill(false);
-    mousePosition = glm::vec2(0.0f);
-    previousMousePosition = glm::vec2(0.0f);
-    mouseDelta = glm::vec2(0.0f);
     scrollDelta = 0.0f;
+    mouseDelta = glm::vec2(0.0f);
 }
 
 void Input::update() {
     // Update keyboard state
     previousKeyState = currentKeyState;
-    
+
     // Update mouse state
     previousMouseState = currentMouseState;
     previousMousePosition = mousePosition;
     scrollDelta = 0.0f; // Reset scroll delta each frame
 
+    if (source) {
+        source->poll(*this);
+    }
+
     // Calculate mouse delta
     mouseDelta = mousePosition - previousMousePosition;
+
+    if (recording) {
+        recording->setTickCount(++recordingTick);
+    }
 }
 
 bool Input::isKeyPressed(int key) const {
@@ -49,16 +76,16 @@ bool Input::isKeyReleased(int key) const {
 }
 
 bool Input::isMouseButtonPressed(int button) const {
-    return button < GLFW_MOUSE_BUTTON_LAST && currentMouseState[button];
+    return button >= 0 && button < MouseButton::Count && currentMouseState[button];
 }
 
 bool Input::isMouseButtonJustPressed(int button) const {
-    return button < GLFW_MOUSE_BUTTON_LAST &&
+    return button >= 0 && button < MouseButton::Count &&
            currentMouseState[button] && !previousMouseState[button];
 }
 
 bool Input::isMouseButtonReleased(int button) const {
-    return button < GLFW_MOUSE_BUTTON_LAST && !currentMouseState[button];
+    return button >= 0 && button < MouseButton::Count && !currentMouseState[button];
 }
 
 const glm::vec2& Input::getMousePosition() const {
@@ -74,23 +101,76 @@ float Input::getMouseScrollDelta() const {
 }
 
 void Input::setCursorMode(bool locked) {
-    glfwSetInputMode(window, GLFW_CURSOR,
-                     locked ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+    if (source) {
+        source->setCursorLocked(locked);
+    }
 }
 
-void Input::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
-    auto input = static_cast<Input*>(glfwGetWindowUserPointer(window));
-    if (button < GLFW_MOUSE_BUTTON_LAST) {
-        input->currentMouseState[button] = (action == GLFW_PRESS);
+void Input::startRecording(double tickRate) {
+    recording = std::make_unique<InputRecording>();
+    recording->setSeed(Random::getSeed());
+    recording->setTickRate(tickRate);
+    recording->setInitialCursor(mousePosition);
+    recordingTick = 0;
+
+    for (const auto& [key, pressed] : currentKeyState) {
+        if (pressed) record(InputRecording::EventType::KeyDown, key);
+    }
+    for (int button = 0; button < MouseButton::Count; ++button) {
+        if (currentMouseState[button]) record(InputRecording::EventType::ButtonDown, button);
     }
 }
 
-void Input::cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
-    auto input = static_cast<Input*>(glfwGetWindowUserPointer(window));
-    input->mousePosition = glm::vec2(xpos, ypos);
+std::unique_ptr<InputRecording> Input::stopRecording() {
+    return std::move(recording);
 }
 
-void Input::scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
-    auto input = static_cast<Input*>(glfwGetWindowUserPointer(window));
-    input->scrollDelta = static_cast<float>(yoffset);
+void Input::startReplay(std::unique_ptr<InputRecording> replayed) {
+    glm::vec2 cursor = replayed->getInitialCursor();
+    auto replaySource = std::make_unique<ReplayInputSource>(std::move(replayed));
+    ReplayInputSource* started = replaySource.get();
+    setSource(std::move(replaySource));
+    replay = started;
+
+    mousePosition = cursor;
+    previousMousePosition = cursor;
+}
+
+bool Input::isReplayFinished() const {
+    return replay && replay->isFinished();
+}
+
+void Input::record(InputRecording::EventType type, int code, const glm::vec2& value) {
+    recording->addEvent({ recordingTick, type, code, value });
+}
+
+// Sources write their whole state every tick; only changes are recorded
+void Input::setKey(int key, bool pressed) {
+    if (recording && isKeyPressed(key) != pressed) {
+        record(pressed ? InputRecording::EventType::KeyDown : InputRecording::EventType::KeyUp, key);
+    }
+    currentKeyState[key] = pressed;
+}
+
+void Input::setMouseButton(int button, bool pressed) {
+    if (button >= 0 && button < MouseButton::Count) {
+        if (recording && currentMouseState[button] != pressed) {
+            record(pressed ? InputRecording::EventType::ButtonDown : InputRecording::EventType::ButtonUp, button);
+        }
+        currentMouseState[button] = pressed;
+    }
+}
+
+void Input::setMousePosition(const glm::vec2& position) {
+    if (recording && position != mousePosition) {
+        record(InputRecording::EventType::CursorMove, -1, position);
+    }
+    mousePosition = position;
+}
+
+void Input::addScroll(float delta) {
+    if (recording && delta != 0.0f) {
+        record(InputRecording::EventType::Scroll, -1, glm::vec2(0.0f, delta));
+    }
+    scrollDelta += delta;
 }
@@ -1,9 +1,20 @@
 #pragma once
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <unordered_map>
 #include <array>
+#include <memory>
+#include "KeyCodes.hpp"
+#include "InputRecording.hpp"
+#include "InputSource.hpp"
 
+class ReplayInputSource;
+
+// Per-tick keyboard and mouse state. Device access lives in the InputSource
+// (GlfwInputSource for windowed builds, ScriptedInputSource for headless
+// runs); without a source every key reads as released.
+//
+// Whatever the source, the state changes can be recorded tick by tick and
+// replayed later through a ReplayInputSource, for reproducible sessions.
 class Input {
 public:
     static Input& getInstance() {
@@ -11,7 +22,11 @@ public:
         return instance;
     }
 
-    void initialize(GLFWwindow* window);
+    void setSource(std::unique_ptr<InputSource> newSource);
+    InputSource* getSource() const { return source.get(); }
+
+    // Latches last tick's state and polls the source. Call once per tick
+    // before anything reads input.
     void update();
 
     // Keyboard input
@@ -30,28 +45,48 @@ public:
     // Utility functions
     void setCursorMode(bool locked);
 
+    // Records every state change from the next update() on. The current
+    // state is captured first, so keys already held are part of the recording.
+    void startRecording(double tickRate);
+    // Ends the recording; null if none was running
+    std::unique_ptr<InputRecording> stopRecording();
+    bool isRecording() const { return recording != nullptr; }
+
+    // Replaces the source with a replay of `recording`. Seed Random and set
+    // the tick rate from the recording before building the scene.
+    void startReplay(std::unique_ptr<InputRecording> replayed);
+    bool isReplaying() const { return replay != nullptr; }
+    bool isReplayFinished() const;
+
+    // Written by input sources from poll()
+    void setKey(int key, bool pressed);
+    void setMouseButton(int button, bool pressed);
+    void setMousePosition(const glm::vec2& position);
+    void addScroll(float delta);
+
 private:
-    Input() = default;
+    Input();
     ~Input() = default;
     Input(const Input&) = delete;
     Input& operator=(const Input&) = delete;
 
-    GLFWwindow* window;
-    
+    std::unique_ptr<InputSource> source;
+    ReplayInputSource* replay;  // `source`, while a replay is running
+
+    std::unique_ptr<InputRecording> recording;
+    uint64_t recordingTick;
+
+    void record(InputRecording::EventType type, int code, const glm::vec2& value = glm::vec2(0.0f));
+
     // Keyboard state
     std::unordered_map<int, bool> currentKeyState;
     std::unordered_map<int, bool> previousKeyState;
 
     // Mouse state
-    std::array<bool, GLFW_MOUSE_BUTTON_LAST> currentMouseState;
-    std::array<bool, GLFW_MOUSE_BUTTON_LAST> previousMouseState;
+    std::array<bool, MouseButton::Count> currentMouseState;
+    std::array<bool, MouseButton::Count> previousMouseState;
     glm::vec2 mousePosition;
     glm::vec2 previousMousePosition;
     glm::vec2 mouseDelta;
     float scrollDelta;
-
-    // Callback functions
-    static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
-    static void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
-    static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
 };
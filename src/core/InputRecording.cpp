@@ -0,0 +1,235 @@
+#include "InputRecording.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char MAGIC[4] = { 'E', 'I', 'N', 'P' };
+    const uint32_t VERSION = 1;
+
+    // Fixed-width values are written byte by byte so files are portable
+    // between little- and big-endian hosts
+    class Writer {
+    public:
+        explicit Writer(std::ostream& out) : out(out) {}
+
+        void u8(uint8_t value) { out.put(static_cast<char>(value)); }
+
+        void u32(uint32_t value) {
+            for (int i = 0; i < 4; ++i) u8(static_cast<uint8_t>(value >> (i * 8)));
+        }
+
+        void u64(uint64_t value) {
+            for (int i = 0; i < 8; ++i) u8(static_cast<uint8_t>(value >> (i * 8)));
+        }
+
+        void f32(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            u32(bits);
+        }
+
+        void f64(double value) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            u64(bits);
+        }
+
+        // LEB128: seven bits per byte, high bit set while more follow
+        void varint(uint64_t value) {
+            while (value >= 0x80) {
+                u8(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            u8(static_cast<uint8_t>(value));
+        }
+
+    private:
+        std::ostream& out;
+    };
+
+    // Reads fail soft: once the stream runs dry every value reads as zero and
+    // ok() turns false, so callers check once at the end of a block
+    class Reader {
+    public:
+        explicit Reader(std::istream& in) : in(in) {}
+
+        bool ok() const { return static_cast<bool>(in); }
+
+        uint8_t u8() {
+            int c = in.get();
+            return c == std::char_traits<char>::eof() ? 0 : static_cast<uint8_t>(c);
+        }
+
+        uint32_t u32() {
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(u8()) << (i * 8);
+            return value;
+        }
+
+        uint64_t u64() {
+            uint64_t value = 0;
+            for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(u8()) << (i * 8);
+            return value;
+        }
+
+        float f32() {
+            uint32_t bits = u32();
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        double f64() {
+            uint64_t bits = u64();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = u8();
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) break;
+            }
+            return value;
+        }
+
+    private:
+        std::istream& in;
+    };
+
+    bool hasCode(InputRecording::EventType type) {
+        return type == InputRecording::EventType::KeyDown || type == InputRecording::EventType::KeyUp ||
+               type == InputRecording::EventType::ButtonDown || type == InputRecording::EventType::ButtonUp;
+    }
+}
+
+InputRecording::InputRecording()
+    : seed(0)
+    , tickRate(60.0)
+    , tickCount(0)
+    , initialCursor(0.0f)
+{}
+
+bool InputRecording::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open input recording for writing: " << path << std::endl;
+        return false;
+    }
+
+    Writer writer(file);
+    file.write(MAGIC, sizeof(MAGIC));
+    writer.u32(VERSION);
+    writer.u64(seed);
+    writer.f64(tickRate);
+    writer.u64(tickCount);
+    writer.f32(initialCursor.x);
+    writer.f32(initialCursor.y);
+    writer.u64(events.size());
+
+    uint64_t previousTick = 0;
+    for (const Event& event : events) {
+        writer.varint(event.tick - previousTick);
+        previousTick = event.tick;
+        writer.u8(static_cast<uint8_t>(event.type));
+
+        if (hasCode(event.type)) {
+            writer.varint(static_cast<uint64_t>(event.code));
+        } else if (event.type == EventType::CursorMove) {
+            writer.f32(event.value.x);
+            writer.f32(event.value.y);
+        } else {
+            writer.f32(event.value.y);
+        }
+    }
+
+    if (!file.good()) {
+        std::cerr << "Failed to write input recording: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputRecording::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open input recording: " << path << std::endl;
+        return false;
+    }
+
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
+    Reader reader(file);
+    uint32_t version = reader.u32();
+    if (!reader.ok() || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << path << ": not an input recording" << std::endl;
+        return false;
+    }
+    if (version != VERSION) {
+        std::cerr << path << ": unsupported input recording version " << version << std::endl;
+        return false;
+    }
+
+    // Parse into locals so a truncated file leaves this recording untouched
+    uint64_t fileSeed = reader.u64();
+    double fileTickRate = reader.f64();
+    uint64_t fileTickCount = reader.u64();
+    glm::vec2 fileCursor;
+    fileCursor.x = reader.f32();
+    fileCursor.y = reader.f32();
+    uint64_t eventCount = reader.u64();
+    if (!reader.ok() || fileTickRate <= 0.0) {
+        std::cerr << path << ": corrupt input recording header" << std::endl;
+        return false;
+    }
+
+    std::vector<Event> fileEvents;
+    uint64_t tick = 0;
+    for (uint64_t i = 0; i < eventCount; ++i) {
+        Event event{ 0, EventType::KeyDown, -1, glm::vec2(0.0f) };
+        tick += reader.varint();
+        event.tick = tick;
+
+        uint8_t type = reader.u8();
+        if (type > static_cast<uint8_t>(EventType::Scroll)) {
+            std::cerr << path << ": unknown event type " << static_cast<int>(type) << std::endl;
+            return false;
+        }
+        event.type = static_cast<EventType>(type);
+
+        if (hasCode(event.type)) {
+            event.code = static_cast<int>(reader.varint());
+        } else if (event.type == EventType::CursorMove) {
+            event.value.x = reader.f32();
+            event.value.y = reader.f32();
+        } else {
+            event.value.y = reader.f32();
+        }
+
+        if (!reader.ok()) {
+            std::cerr << path << ": truncated after " << i << " of " << eventCount << " events" << std::endl;
+            return false;
+        }
+        fileEvents.push_back(event);
+    }
+
+    events = std::move(fileEvents);
+    seed = fileSeed;
+    tickRate = fileTickRate;
+    tickCount = fileTickCount;
+    initialCursor = fileCursor;
+    return true;
+}
+
+void InputRecording::addEvent(const Event& event) {
+    events.push_back(event);
+}
+
+void InputRecording::clear() {
+    events.clear();
+    tickCount = 0;
+}
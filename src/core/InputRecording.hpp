@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Every key, button, cursor and scroll change Input saw, keyed by the tick it
+// happened on, plus what a replay needs to reproduce the run exactly: the
+// simulation tick rate and the Random seed.
+//
+// Files are little-endian binary. Ticks are stored as deltas and codes as
+// varints, so an hour of play is typically a few hundred KiB:
+//
+//   "EINP" u32 version, u64 seed, f64 tickRate, u64 tickCount,
+//   f32 cursorX, f32 cursorY, u64 eventCount, then per event:
+//   varint tickDelta, u8 type, payload (varint code | f32 x f32 y | f32 amount)
+class InputRecording {
+public:
+    enum class EventType : uint8_t {
+        KeyDown,
+        KeyUp,
+        ButtonDown,
+        ButtonUp,
+        CursorMove,  // value: absolute cursor position
+        Scroll       // value.y: amount
+    };
+
+    struct Event {
+        uint64_t tick;
+        EventType type;
+        int code;        // Key or mouse button
+        glm::vec2 value;
+    };
+
+    InputRecording();
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    // Events must arrive in tick order
+    void addEvent(const Event& event);
+    const std::vector<Event>& getEvents() const { return events; }
+    void clear();
+
+    uint64_t getSeed() const { return seed; }
+    void setSeed(uint64_t value) { seed = value; }
+    double getTickRate() const { return tickRate; }
+    void setTickRate(double value) { tickRate = value; }
+
+    // Ticks covered, including trailing ones with no events
+    uint64_t getTickCount() const { return tickCount; }
+    void setTickCount(uint64_t value) { tickCount = value; }
+
+    // Cursor position when recording started; the first tick's mouse delta
+    // is measured from here
+    const glm::vec2& getInitialCursor() const { return initialCursor; }
+    void setInitialCursor(const glm::vec2& position) { initialCursor = position; }
+
+private:
+    std::vector<Event> events;
+    uint64_t seed;
+    double tickRate;
+    uint64_t tickCount;
+    glm::vec2 initialCursor;
+};
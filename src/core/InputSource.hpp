@@ -0,0 +1,17 @@
+#pragma once
+
+class Input;
+
+// Where Input's device state comes from. Input::update() asks the active
+// source to write this tick's keys, buttons and cursor into it, so gameplay
+// code reads the same Input whether the state came from a window, a script
+// or a recording.
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+
+    // Writes the current device state through Input's set* functions
+    virtual void poll(Input& input) = 0;
+
+    virtual void setCursorLocked([[maybe_unused]] bool locked) {}
+};
@@ -0,0 +1,388 @@
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    // Deque owned by the calling thread, -1 for threads the job system did not start
+    thread_local int threadQueueIndex = -1;
+}
+
+// WorkStealingDeque implementation
+WorkStealingDeque::WorkStealingDeque()
+    : top(0)
+    , bottom(0)
+    , buffer(new std::atomic<Job*>[CAPACITY])
+{}
+
+bool WorkStealingDeque::push(Job* job) {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY) return false;
+
+    buffer[b & MASK].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+Job* WorkStealingDeque::pop() {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        // Empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = buffer[b & MASK].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last item: race any thief for it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* WorkStealingDeque::steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+
+    Job* job = buffer[t & MASK].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+
+bool WorkStealingDeque::isEmpty() const {
+    return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire);
+}
+
+// JobPool implementation
+JobPool::JobPool()
+    : blocks(sizeof(Job), alignof(Job), 256)
+    , returned(nullptr)
+{}
+
+Job* JobPool::create(const std::function<void()>& function, JobCounter* counter) {
+    if (blocks.getLiveCount() == blocks.getCapacity()) {
+        drainReturned();
+    }
+
+    Job* job = new (blocks.allocate()) Job{ function, counter };
+    job->pool = this;
+    return job;
+}
+
+void JobPool::destroy(Job* job, bool onOwner) {
+    job->~Job();
+    if (onOwner) {
+        blocks.deallocate(job);
+        return;
+    }
+
+    // Only the owner takes entries off, and always the whole list at once, so a plain push is ABA-safe
+    ReturnedJob* node = new (job) ReturnedJob{ returned.load(std::memory_order_relaxed) };
+    while (!returned.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void JobPool::drainReturned() {
+    ReturnedJob* node = returned.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        ReturnedJob* next = node->next;
+        blocks.deallocate(node);
+        node = next;
+    }
+}
+
+// JobSystem implementation
+JobSystem::JobSystem()
+    : running(false)
+    , queuedJobs(0)
+{}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+void JobSystem::initialize(unsigned workerCount) {
+    if (running) return;
+
+    if (workerCount == 0) {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    mainThreadId = std::this_thread::get_id();
+    threadQueueIndex = 0;
+    PROFILE_THREAD("Main");
+
+    queues.clear();
+    jobPools.clear();
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkStealingDeque>());
+        jobPools.push_back(std::make_unique<JobPool>());
+    }
+
+    running = true;
+    for (unsigned i = 1; i <= workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::shutdown() {
+    if (!running) return;
+
+    running = false;
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // Anything still queued runs here so no counter is left hanging
+    while (runPendingJob()) {}
+    processMainThreadJobs();
+
+    queues.clear();
+    jobPools.clear();
+    threadQueueIndex = -1;
+}
+
+bool JobSystem::isMainThread() const {
+    return std::this_thread::get_id() == mainThreadId;
+}
+
+int JobSystem::getThreadIndex() const {
+    return threadQueueIndex;
+}
+
+void JobSystem::run(const std::function<void()>& function, JobCounter* counter, JobCounter* dependency) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job* job = createJob(function, counter);
+
+    if (dependency) {
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (!dependency->isDone()) {
+            dependency->continuations.push_back(job);
+            return;
+        }
+    }
+
+    schedule(job);
+}
+
+void JobSystem::runOnMainThread(const std::function<void()>& function, JobCounter* counter) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job* job = createJob(function, counter);
+    if (!running || isMainThread()) {
+        execute(job);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mainThreadMutex);
+    mainThreadQueue.push_back(job);
+}
+
+void JobSystem::processMainThreadJobs() {
+    {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        mainThreadPending.swap(mainThreadQueue);
+    }
+
+    for (Job* job : mainThreadPending) {
+        execute(job);
+    }
+    mainThreadPending.clear();
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Let the finishing thread leave finish() before the counter can go away
+    std::lock_guard<std::mutex> lock(counter.continuationMutex);
+}
+
+void JobSystem::parallelForRanges(size_t begin, size_t end, size_t grainSize, void* context, RangeFunction invoke) {
+    if (end <= begin) return;
+
+    size_t count = end - begin;
+    if (grainSize == 0) {
+        size_t ranges = (workers.size() + 1) * RANGES_PER_THREAD;
+        grainSize = std::max<size_t>(1, (count + ranges - 1) / ranges);
+    }
+
+    if (!running || count <= grainSize) {
+        invoke(context, begin, end);
+        return;
+    }
+
+    // Jobs capture only a pointer to this and their start index, which fits
+    // std::function's inline storage
+    struct Task {
+        void* context;
+        RangeFunction invoke;
+        size_t grainSize;
+        size_t end;
+    } task{ context, invoke, grainSize, end };
+    const Task* taskPtr = &task;
+
+    // The first range runs on the calling thread, the rest are up for grabs
+    JobCounter counter;
+    for (size_t rangeBegin = begin + grainSize; rangeBegin < end; rangeBegin += grainSize) {
+        run([taskPtr, rangeBegin]() {
+            size_t rangeEnd = std::min(rangeBegin + taskPtr->grainSize, taskPtr->end);
+            taskPtr->invoke(taskPtr->context, rangeBegin, rangeEnd);
+        }, &counter);
+    }
+
+    invoke(context, begin, begin + grainSize);
+    wait(counter);
+}
+
+Job* JobSystem::createJob(const std::function<void()>& function, JobCounter* counter) {
+    Job* job;
+    int index = threadQueueIndex;
+    if (index >= 0 && static_cast<size_t>(index) < jobPools.size()) {
+        job = jobPools[index]->create(function, counter);
+    } else {
+        std::lock_guard<std::mutex> lock(sharedJobPoolMutex);
+        job = sharedJobPool.create(function, counter);
+    }
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    job->memoryTag = AllocationTracker::getCurrentTag();
+#endif
+    return job;
+}
+
+void JobSystem::workerLoop(unsigned index) {
+    threadQueueIndex = static_cast<int>(index);
+    PROFILE_THREAD("Worker " + std::to_string(index));
+
+    // Created up front so FrameArena::resetAll() sizes it before the first job allocates
+    FrameArena::getThreadArena();
+
+    while (running) {
+        if (runPendingJob()) continue;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+            return queuedJobs.load() > 0 || !running;
+        });
+    }
+}
+
+void JobSystem::schedule(Job* job) {
+    if (!running) {
+        execute(job);
+        return;
+    }
+
+    queuedJobs.fetch_add(1);
+
+    int index = threadQueueIndex;
+    bool pushed = index >= 0 && static_cast<size_t>(index) < queues.size() && queues[index]->push(job);
+    if (!pushed) {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        sharedQueue.push_back(job);
+    }
+
+    wakeCondition.notify_one();
+}
+
+void JobSystem::execute(Job* job) {
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    {
+        MemoryTagScope tag(job->memoryTag);
+        job->function();
+    }
+#else
+    job->function();
+#endif
+    JobCounter* counter = job->counter;
+    int index = threadQueueIndex;
+    bool onOwner = index >= 0 && static_cast<size_t>(index) < jobPools.size() && jobPools[index].get() == job->pool;
+    job->pool->destroy(job, onOwner);
+    finish(counter);
+}
+
+void JobSystem::finish(JobCounter* counter) {
+    if (!counter) return;
+
+    // Decrement under the lock so a waiter that sees zero and then takes the
+    // lock knows we are done touching the counter
+    std::vector<Job*> released;
+    {
+        std::lock_guard<std::mutex> lock(counter->continuationMutex);
+        if (counter->value.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        released.swap(counter->continuations);
+    }
+
+    for (Job* job : released) {
+        schedule(job);
+    }
+}
+
+Job* JobSystem::findJob(unsigned index) {
+    if (index < queues.size()) {
+        if (Job* job = queues[index]->pop()) return job;
+    }
+
+    // Steal, starting after our own queue so thieves spread across victims
+    size_t queueCount = queues.size();
+    for (size_t i = 1; i <= queueCount; ++i) {
+        size_t victim = (index + i) % queueCount;
+        if (victim == index) continue;
+        if (Job* job = queues[victim]->steal()) return job;
+    }
+
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (sharedQueue.empty()) return nullptr;
+    Job* job = sharedQueue.front();
+    sharedQueue.pop_front();
+    return job;
+}
+
+bool JobSystem::runPendingJob() {
+    if (queuedJobs.load() > 0 && !queues.empty()) {
+        int index = threadQueueIndex;
+        unsigned queueIndex = index >= 0 ? static_cast<unsigned>(index) : static_cast<unsigned>(queues.size());
+        if (Job* job = findJob(queueIndex)) {
+            queuedJobs.fetch_sub(1);
+            execute(job);
+            return true;
+        }
+    }
+
+    if (isMainThread()) {
+        std::unique_lock<std::mutex> lock(mainThreadMutex);
+        if (!mainThreadQueue.empty()) {
+            Job* job = mainThreadQueue.front();
+            mainThreadQueue.pop_front();
+            lock.unlock();
+            execute(job);
+            return true;
+        }
+    }
+
+    return false;
+}
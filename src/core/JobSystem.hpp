@@ -0,0 +1,185 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "AllocationTracker.hpp"
+#include "Allocators.hpp"
+
+class JobSystem;
+class JobPool;
+struct Job;
+
+// Tracks a group of outstanding jobs. Reaches zero once every job submitted
+// against it has finished; jobs can be made to wait on a counter instead of
+// blocking a thread.
+class JobCounter {
+public:
+    JobCounter() : value(0) {}
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return value.load(std::memory_order_acquire) == 0; }
+    int getValue() const { return value.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<int> value;
+    std::mutex continuationMutex;
+    std::vector<Job*> continuations; // Jobs released when value hits zero
+
+    friend class JobSystem;
+};
+
+struct Job {
+    std::function<void()> function;
+    JobCounter* counter = nullptr;
+    JobPool* pool = nullptr; // Where the record goes back to once the job has run
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    MemoryTag memoryTag = MemoryTag::Untagged; // Tag of the thread that scheduled it
+#endif
+};
+
+// Recycles Job records for one thread. Only the owner creates, without
+// locking. A job that finishes on another thread is pushed onto a lock-free
+// return list, which the owner drains once its own free blocks run out.
+class JobPool {
+public:
+    JobPool();
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    Job* create(const std::function<void()>& function, JobCounter* counter); // Owner only
+    void destroy(Job* job, bool onOwner);
+
+private:
+    struct ReturnedJob {
+        ReturnedJob* next;
+    };
+
+    BlockPool blocks;
+    alignas(64) std::atomic<ReturnedJob*> returned;
+
+    void drainReturned();
+};
+
+// Chase-Lev deque: the owning worker pushes and pops at the bottom without
+// locking, other workers steal from the top.
+class WorkStealingDeque {
+public:
+    static constexpr int64_t CAPACITY = 4096;
+
+    WorkStealingDeque();
+
+    bool push(Job* job);   // Owner only; false when full
+    Job* pop();            // Owner only
+    Job* steal();          // Any thread
+
+    bool isEmpty() const;
+
+private:
+    static constexpr int64_t MASK = CAPACITY - 1;
+
+    alignas(64) std::atomic<int64_t> top;
+    alignas(64) std::atomic<int64_t> bottom;
+    std::unique_ptr<std::atomic<Job*>[]> buffer;
+};
+
+class JobSystem {
+public:
+    static JobSystem& getInstance() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    // The calling thread becomes the main thread. 0 workers picks
+    // hardware_concurrency - 1; the main thread always helps while waiting.
+    void initialize(unsigned workerCount = 0);
+    void shutdown();
+
+    bool isInitialized() const { return running.load(); }
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+    bool isMainThread() const;
+
+    // 0 for the main thread, 1..N for workers, -1 for any other thread
+    int getThreadIndex() const;
+
+    // Schedules `function`. If `dependency` is given the job is only released
+    // once that counter reaches zero.
+    void run(const std::function<void()>& function, JobCounter* counter = nullptr,
+             JobCounter* dependency = nullptr);
+
+    // For work that must happen on the main thread (GL calls). Executed by
+    // processMainThreadJobs() or while the main thread waits.
+    void runOnMainThread(const std::function<void()>& function, JobCounter* counter = nullptr);
+    void processMainThreadJobs();
+
+    // Blocks until the counter reaches zero, executing other jobs meanwhile
+    void wait(JobCounter& counter);
+
+    // Splits [begin, end) into ranges of at most `grainSize` items and runs
+    // body(rangeBegin, rangeEnd) across the workers. A grain size of 0 picks
+    // one that gives each thread a few ranges to balance uneven work. The
+    // body is called through a plain function pointer, never copied, so
+    // large captures cost no allocation.
+    template<typename Body>
+    void parallelFor(size_t begin, size_t end, Body&& body, size_t grainSize = 0) {
+        using BodyType = std::remove_reference_t<Body>;
+        void* context = const_cast<void*>(static_cast<const void*>(&body));
+        parallelForRanges(begin, end, grainSize, context, [](void* target, size_t rangeBegin, size_t rangeEnd) {
+            (*static_cast<BodyType*>(target))(rangeBegin, rangeEnd);
+        });
+    }
+
+private:
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    static constexpr size_t RANGES_PER_THREAD = 4;
+
+    using RangeFunction = void (*)(void* context, size_t begin, size_t end);
+
+    // Index 0 belongs to the main thread, 1..N to workers
+    std::vector<std::unique_ptr<WorkStealingDeque>> queues;
+    std::vector<std::thread> workers;
+    std::thread::id mainThreadId;
+    std::atomic<bool> running;
+
+    // Submissions from threads that own no deque
+    std::mutex sharedMutex;
+    std::deque<Job*> sharedQueue;
+
+    std::mutex mainThreadMutex;
+    std::deque<Job*> mainThreadQueue;
+    std::deque<Job*> mainThreadPending;  // Swapped with the queue, so neither reallocates each frame
+
+    // Job records are recycled instead of hitting the heap per job: one
+    // pool per deque, indexed like `queues`. Threads that own no deque
+    // share the last one under a mutex.
+    std::vector<std::unique_ptr<JobPool>> jobPools;
+    std::mutex sharedJobPoolMutex;
+    JobPool sharedJobPool;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<int> queuedJobs;
+
+    void parallelForRanges(size_t begin, size_t end, size_t grainSize, void* context, RangeFunction invoke);
+    Job* createJob(const std::function<void()>& function, JobCounter* counter);
+    void workerLoop(unsigned index);
+    void schedule(Job* job);
+    void execute(Job* job);
+    void finish(JobCounter* counter);
+    Job* findJob(unsigned index);
+    bool runPendingJob();
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+// Engine key and mouse button codes. Values match GLFW's so the GLFW input
+// source passes codes through unchanged, but nothing here needs GLFW: headless
+// builds and scripted input use these names directly.
+namespace Key {
+    constexpr int Space = 32;
+
+    constexpr int Num0 = 48;
+    constexpr int Num1 = 49;
+    constexpr int Num2 = 50;
+    constexpr int Num3 = 51;
+    constexpr int Num4 = 52;
+    constexpr int Num5 = 53;
+    constexpr int Num6 = 54;
+    constexpr int Num7 = 55;
+    constexpr int Num8 = 56;
+    constexpr int Num9 = 57;
+
+    constexpr int A = 65;
+    constexpr int B = 66;
+    constexpr int C = 67;
+    constexpr int D = 68;
+    constexpr int E = 69;
+    constexpr int F = 70;
+    constexpr int G = 71;
+    constexpr int H = 72;
+    constexpr int I = 73;
+    constexpr int J = 74;
+    constexpr int K = 75;
+    constexpr int L = 76;
+    constexpr int M = 77;
+    constexpr int N = 78;
+    constexpr int O = 79;
+    constexpr int P = 80;
+    constexpr int Q = 81;
+    constexpr int R = 82;
+    constexpr int S = 83;
+    constexpr int T = 84;
+    constexpr int U = 85;
+    constexpr int V = 86;
+    constexpr int W = 87;
+    constexpr int X = 88;
+    constexpr int Y = 89;
+    constexpr int Z = 90;
+
+    constexpr int Escape = 256;
+    constexpr int Enter = 257;
+    constexpr int Tab = 258;
+    constexpr int Backspace = 259;
+    constexpr int Right = 262;
+    constexpr int Left = 263;
+    constexpr int Down = 264;
+    constexpr int Up = 265;
+
+    constexpr int LeftShift = 340;
+    constexpr int LeftControl = 341;
+    constexpr int LeftAlt = 342;
+    constexpr int RightShift = 344;
+    constexpr int RightControl = 345;
+    constexpr int RightAlt = 346;
+
+    constexpr int Last = 348;
+}
+
+namespace MouseButton {
+    constexpr int Left = 0;
+    constexpr int Right = 1;
+    constexpr int Middle = 2;
+
+    constexpr int Count = 8;
+}
@@ -1,5 +1,7 @@
 #include "ModelLoader.hpp"
 #include "../renderer/Mesh.hpp"
+#include "AllocationTracker.hpp"
+#include "Profiler.hpp"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -7,6 +9,8 @@
 
 bool ModelLoader::loadOBJ(const std::string& path, 
                          std::vector<std::shared_ptr<Mesh>>& outMeshes) {
+    PROFILE_SCOPE("ModelLoader::loadOBJ");
+    MEMORY_TAG(Resources);
     OBJData data;
     if (!parseOBJFile(path, data)) {
         return false;
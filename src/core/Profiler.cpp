@@ -0,0 +1,244 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    thread_local uint32_t scopeDepth = 0;
+
+    void writeJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            switch (c) {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                            << static_cast<int>(c) << std::dec << std::setfill(' ');
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+}
+
+#ifdef ENGINE_PROFILING
+bool Profiler::isCompiledIn() { return true; }
+#else
+bool Profiler::isCompiledIn() { return false; }
+#endif
+
+Profiler::Profiler()
+    : epoch(std::chrono::steady_clock::now())
+    , enabled(true)
+    , frameCapacity(120)
+    , retainedFrames(0)
+    , nextFrame(0)
+    , frameCount(0)
+    , frameStart(0.0)
+{
+    frames.resize(frameCapacity);
+    for (Frame& frame : frames) {
+        frame.events.reserve(RESERVED_EVENTS);
+    }
+}
+
+uint32_t& Profiler::threadDepth() {
+    return scopeDepth;
+}
+
+double Profiler::now() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer) return *buffer;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.push_back(std::make_unique<ThreadBuffer>());
+    buffer = threads.back().get();
+    buffer->events.reserve(RESERVED_EVENTS);
+    buffer->id = static_cast<uint32_t>(threads.size() - 1);
+    buffer->name = "Thread " + std::to_string(buffer->id);
+    return *buffer;
+}
+
+void Profiler::record(const Event& event) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(event);
+    buffer.events.back().thread = buffer.id;
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(mutex);
+    buffer.name = name;
+}
+
+const char* Profiler::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return internedNames.insert(name).first->c_str();
+}
+
+void Profiler::endFrame() {
+    double frameEnd = now();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Overwrite the oldest slot, reusing its event storage
+    Frame& frame = frames[nextFrame];
+    frame.events.clear();
+    frame.startUs = frameStart;
+    frame.endUs = frameEnd;
+    frameStart = frameEnd;
+
+    for (auto& thread : threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        frame.events.insert(frame.events.end(), thread->events.begin(), thread->events.end());
+        thread->events.clear();
+    }
+
+    // Scopes are recorded as they close, so children come before their
+    // parents; sort back into start order with parents first on ties
+    std::sort(frame.events.begin(), frame.events.end(), [](const Event& a, const Event& b) {
+        if (a.thread != b.thread) return a.thread < b.thread;
+        if (a.startUs != b.startUs) return a.startUs < b.startUs;
+        return a.depth < b.depth;
+    });
+
+    frame.index = frameCount++;
+    nextFrame = (nextFrame + 1) % frameCapacity;
+    retainedFrames = std::min(retainedFrames + 1, frameCapacity);
+}
+
+const Profiler::Frame& Profiler::retainedFrame(size_t age) const {
+    return frames[(nextFrame + frameCapacity - retainedFrames + age) % frameCapacity];
+}
+
+void Profiler::setFrameCapacity(size_t capacity) {
+    capacity = std::max<size_t>(capacity, 1);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Unroll the ring oldest first and keep the newest `capacity` frames
+    std::vector<Frame> ordered(capacity);
+    size_t kept = std::min(retainedFrames, capacity);
+    for (size_t i = 0; i < kept; ++i) {
+        ordered[i] = std::move(frames[(nextFrame + frameCapacity - kept + i) % frameCapacity]);
+    }
+    for (size_t i = kept; i < capacity; ++i) {
+        ordered[i].events.reserve(RESERVED_EVENTS);
+    }
+
+    frames = std::move(ordered);
+    frameCapacity = capacity;
+    retainedFrames = kept;
+    nextFrame = kept % frameCapacity;
+}
+
+size_t Profiler::getFrameCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return frameCapacity;
+}
+
+std::vector<Profiler::Frame> Profiler::getFrames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Frame> ordered;
+    ordered.reserve(retainedFrames);
+    for (size_t i = 0; i < retainedFrames; ++i) {
+        ordered.push_back(retainedFrame(i));
+    }
+    return ordered;
+}
+
+uint64_t Profiler::getFrameCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return frameCount;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    retainedFrames = 0;
+    nextFrame = 0;
+    for (auto& thread : threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        thread->events.clear();
+    }
+}
+
+std::string Profiler::getThreadName(uint32_t thread) const {
+    return thread < threads.size() ? threads[thread]->name : "Thread " + std::to_string(thread);
+}
+
+void Profiler::printLastFrame(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (retainedFrames == 0) {
+        out << "No profiled frames" << (isCompiledIn() ? "" : " (build with ENGINE_PROFILING)") << "\n";
+        return;
+    }
+
+    const Frame& frame = retainedFrame(retainedFrames - 1);
+    out << std::fixed << std::setprecision(3);
+    out << "Frame " << frame.index << ": " << (frame.endUs - frame.startUs) / 1000.0 << " ms\n";
+
+    uint32_t currentThread = UINT32_MAX;
+    for (const Event& event : frame.events) {
+        if (event.thread != currentThread) {
+            currentThread = event.thread;
+            out << "  [" << getThreadName(currentThread) << "]\n";
+        }
+        out << std::string(4 + event.depth * 2, ' ') << event.name << "  "
+            << event.durationUs / 1000.0 << " ms\n";
+    }
+}
+
+void Profiler::writeChromeTrace(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Complete ("X") events in microseconds; the viewer nests them by time
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for (size_t t = 0; t < threads.size(); ++t) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t << ",\"args\":{\"name\":";
+        writeJsonString(out, threads[t]->name);
+        out << "}}";
+    }
+
+    for (size_t i = 0; i < retainedFrames; ++i) {
+        const Frame& frame = retainedFrame(i);
+        for (const Event& event : frame.events) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"cat\":\"engine\",\"ph\":\"X\",\"ts\":" << event.startUs
+                << ",\"dur\":" << event.durationUs
+                << ",\"pid\":1,\"tid\":" << event.thread
+                << ",\"args\":{\"frame\":" << frame.index << "}}";
+        }
+    }
+
+    out << "\n]}\n";
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+
+    writeChromeTrace(file);
+    return static_cast<bool>(file);
+}
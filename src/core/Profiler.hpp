@@ -0,0 +1,155 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Hierarchical CPU profiler. PROFILE_SCOPE("Name") times the enclosing block
+// on the calling thread; nesting on a thread gives the hierarchy. PROFILE_FRAME()
+// closes the frame: every thread's finished scopes move into a ring of the
+// last N frames, which can be printed or written as a Chrome trace
+// (chrome://tracing or ui.perfetto.dev).
+//
+// The macros compile to nothing unless the engine is built with
+// ENGINE_PROFILING, so instrumentation can stay in hot code.
+class Profiler {
+public:
+    struct Event {
+        const char* name;  // String literal or intern()ed, never freed
+        double startUs;    // Since the profiler was created
+        double durationUs;
+        uint32_t thread;   // Profiler thread id, in order of first use
+        uint32_t depth;    // Nesting level on its thread, 0 is outermost
+    };
+
+    struct Frame {
+        uint64_t index = 0;
+        double startUs = 0.0;
+        double endUs = 0.0;
+        std::vector<Event> events; // By thread, then start time: a pre-order walk of each thread's tree
+    };
+
+    static Profiler& getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    // True when built with ENGINE_PROFILING
+    static bool isCompiledIn();
+
+    // Runtime switch on top of the compile flag; on by default
+    void setEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Event storage reserved for every ring slot and every thread up front,
+    // so steady-state frames record without allocating. Busier frames grow
+    // their slot once and keep the capacity.
+    static constexpr size_t RESERVED_EVENTS = 512;
+
+    // Frames kept in the ring. Shrinking drops the oldest.
+    void setFrameCapacity(size_t frames);
+    size_t getFrameCapacity() const;
+
+    // Ends the current frame and starts the next one
+    void endFrame();
+
+    // Retained frames, oldest first
+    std::vector<Frame> getFrames() const;
+    uint64_t getFrameCount() const;
+    void clear();
+
+    // Shown as the thread's name in traces and printouts
+    void setThreadName(const std::string& name);
+
+    // Stable copy of a runtime string for use as a scope name
+    const char* intern(const std::string& name);
+
+    // Indented tree of the last frame, one block per thread
+    void printLastFrame(std::ostream& out) const;
+
+    // Chrome trace event JSON of every retained frame
+    void writeChromeTrace(std::ostream& out) const;
+    bool writeChromeTrace(const std::string& path) const;
+
+    double now() const;
+    void record(const Event& event);
+
+    // Nesting depth of the calling thread's open scopes
+    static uint32_t& threadDepth();
+
+private:
+    struct ThreadBuffer {
+        uint32_t id;
+        std::string name;
+        std::mutex mutex; // Only contended while endFrame() collects
+        std::vector<Event> events;
+    };
+
+    Profiler();
+    ~Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    std::chrono::steady_clock::time_point epoch;
+    std::atomic<bool> enabled;
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads; // Outlive their threads so late events still land
+    std::unordered_set<std::string> internedNames;
+
+    std::vector<Frame> frames; // Ring buffer, frameCapacity slots reused in place
+    size_t frameCapacity;
+    size_t retainedFrames;
+    size_t nextFrame;
+    uint64_t frameCount;
+    double frameStart;
+
+    ThreadBuffer& getThreadBuffer();
+    const Frame& retainedFrame(size_t age) const; // 0 is the oldest
+    std::string getThreadName(uint32_t thread) const;
+};
+
+// Times its own lifetime into the profiler
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(Profiler::getInstance().isEnabled() ? name : nullptr)
+        , start(0.0)
+    {
+        if (this->name) {
+            start = Profiler::getInstance().now();
+            ++Profiler::threadDepth();
+        }
+    }
+
+    ~ProfileScope() {
+        if (!name) return;
+        Profiler& profiler = Profiler::getInstance();
+        uint32_t depth = --Profiler::threadDepth();
+        profiler.record({ name, start, profiler.now() - start, 0, depth });
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    double start;
+};
+
+#ifdef ENGINE_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::getInstance().endFrame()
+#define PROFILE_THREAD(name) Profiler::getInstance().setThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
@@ -0,0 +1,43 @@
+#include "Random.hpp"
+#include <atomic>
+
+namespace {
+    std::atomic<uint64_t> globalSeed{ 0 };
+    std::atomic<uint64_t> nextStream{ 0 };
+}
+
+Random::Random(uint64_t seed, uint64_t stream)
+    : state(0)
+    , increment((stream << 1) | 1)
+{
+    // Reference PCG seeding: step once, mix in the seed, step again
+    nextUInt();
+    state += seed;
+    nextUInt();
+}
+
+uint32_t Random::nextUInt() {
+    uint64_t old = state;
+    state = old * 6364136223846793005ULL + increment;
+    uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+    uint32_t rotation = static_cast<uint32_t>(old >> 59);
+    return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+}
+
+float Random::nextFloat() {
+    // Top 24 bits fill the float mantissa exactly, so 1.0 is never returned
+    return static_cast<float>(nextUInt() >> 8) * (1.0f / 16777216.0f);
+}
+
+void Random::setSeed(uint64_t seed) {
+    globalSeed.store(seed, std::memory_order_relaxed);
+    nextStream.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Random::getSeed() {
+    return globalSeed.load(std::memory_order_relaxed);
+}
+
+Random Random::createStream() {
+    return Random(getSeed(), nextStream.fetch_add(1, std::memory_order_relaxed));
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+// PCG32 generator. Unlike rand() or the <random> distributions, the sequence
+// is the same on every platform and standard library, so a run seeded with
+// setSeed() and fed recorded input replays exactly.
+//
+// Systems may run on several threads at once, so there is no shared
+// generator: each user owns a stream from createStream(). Streams are handed
+// out in creation order, which is deterministic for the same seed and input.
+class Random {
+public:
+    explicit Random(uint64_t seed = 0, uint64_t stream = 0);
+
+    uint32_t nextUInt();
+    // Uniform in [0, 1)
+    float nextFloat();
+    // Uniform in [min, max)
+    float range(float min, float max) { return min + (max - min) * nextFloat(); }
+
+    // Reseeds the engine and restarts stream numbering. Call before creating
+    // the scene.
+    static void setSeed(uint64_t seed);
+    static uint64_t getSeed();
+    static Random createStream();
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
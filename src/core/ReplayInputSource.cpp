@@ -0,0 +1,29 @@
+#include "ReplayInputSource.hpp"
+#include "Input.hpp"
+
+ReplayInputSource::ReplayInputSource(std::unique_ptr<InputRecording> replayed)
+    : recording(std::move(replayed))
+    , nextEvent(0)
+    , tick(0)
+    , cursor(recording->getInitialCursor())
+{}
+
+void ReplayInputSource::poll(Input& input) {
+    using EventType = InputRecording::EventType;
+
+    const auto& events = recording->getEvents();
+    while (nextEvent < events.size() && events[nextEvent].tick <= tick) {
+        const InputRecording::Event& event = events[nextEvent++];
+        switch (event.type) {
+            case EventType::KeyDown:    input.setKey(event.code, true); break;
+            case EventType::KeyUp:      input.setKey(event.code, false); break;
+            case EventType::ButtonDown: input.setMouseButton(event.code, true); break;
+            case EventType::ButtonUp:   input.setMouseButton(event.code, false); break;
+            case EventType::CursorMove: cursor = event.value; break;
+            case EventType::Scroll:     input.addScroll(event.value.y); break;
+        }
+    }
+
+    input.setMousePosition(cursor);
+    ++tick;
+}
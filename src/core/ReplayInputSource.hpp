@@ -0,0 +1,27 @@
+#pragma once
+#include <memory>
+#include <glm/glm.hpp>
+#include "InputRecording.hpp"
+#include "InputSource.hpp"
+
+// Plays an InputRecording back tick by tick. Start it with
+// Input::startReplay, which also restores the recorded cursor so the first
+// tick's mouse delta matches. Together with the recording's seed and tick
+// rate this reproduces the original run.
+class ReplayInputSource : public InputSource {
+public:
+    explicit ReplayInputSource(std::unique_ptr<InputRecording> recording);
+
+    void poll(Input& input) override;
+
+    const InputRecording& getRecording() const { return *recording; }
+    uint64_t getTick() const { return tick; }
+    // True once every recorded tick has been played
+    bool isFinished() const { return tick >= recording->getTickCount(); }
+
+private:
+    std::unique_ptr<InputRecording> recording;
+    size_t nextEvent;
+    uint64_t tick;
+    glm::vec2 cursor;
+};
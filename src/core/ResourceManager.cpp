@@ -1,4 +1,5 @@
 #include "ResourceManager.hpp"
+#include "AllocationTracker.hpp"
 #include "ModelLoader.hpp"
 #include "../renderer/Shader.hpp"
 #include "../renderer/Texture.hpp"
@@ -9,6 +10,7 @@
 std::shared_ptr<Shader> ResourceManager::loadShader(const std::string& name,
                                                   const std::string& vertexPath,
                                                   const std::string& fragmentPath) {
+    MEMORY_TAG(Resources);
     // Check if shader already exists
     if (shaders.find(name) != shaders.end()) {
         return shaders[name];
@@ -32,6 +34,7 @@ std::shared_ptr<Shader> ResourceManager::getShader(const std::string& name) {
 
 std::shared_ptr<Texture> ResourceManager::loadTexture(const std::string& name,
                                                     const std::string& path) {
+    MEMORY_TAG(Resources);
     // Check if texture already exists
     if (textures.find(name) != textures.end()) {
         return textures[name];
@@ -55,6 +58,7 @@ std::shared_ptr<Texture> ResourceManager::getTexture(const std::string& name) {
 
 std::shared_ptr<Mesh> ResourceManager::loadMesh(const std::string& name,
                                               const std::string& path) {
+    MEMORY_TAG(Resources);
     // Check if mesh already exists
     if (meshes.find(name) != meshes.end()) {
         return meshes[name];
@@ -85,6 +89,7 @@ std::shared_ptr<Mesh> ResourceManager::getMesh(const std::string& name) {
 
 std::shared_ptr<Material> ResourceManager::createMaterial(const std::string& name,
                                                         std::shared_ptr<Shader> shader) {
+    MEMORY_TAG(Resources);
     // Check if material already exists
     if (materials.find(name) != materials.end()) {
         return materials[name];
@@ -101,6 +106,20 @@ std::shared_ptr<Material> ResourceManager::getMaterial(const std::string& name)
     return (it != materials.end()) ? it->second : nullptr;
 }
 
+std::string ResourceManager::findMeshName(const Mesh* mesh) const {
+    for (const auto& entry : meshes) {
+        if (entry.second.get() == mesh) return entry.first;
+    }
+    return std::string();
+}
+
+std::string ResourceManager::findMaterialName(const Material* material) const {
+    for (const auto& entry : materials) {
+        if (entry.second.get() == material) return entry.first;
+    }
+    return std::string();
+}
+
 void ResourceManager::cleanup() {
     shaders.clear();
     textures.clear();
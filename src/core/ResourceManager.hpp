@@ -36,6 +36,10 @@ public:
                                            std::shared_ptr<Shader> shader);
     std::shared_ptr<Material> getMaterial(const std::string& name);
 
+    // Reverse lookups for serialization; empty if the resource is not registered
+    std::string findMeshName(const Mesh* mesh) const;
+    std::string findMaterialName(const Material* material) const;
+
     // Resource cleanup
     void cleanup();
 
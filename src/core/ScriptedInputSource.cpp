@@ -0,0 +1,195 @@
+#include "ScriptedInputSource.hpp"
+#include "Input.hpp"
+#include "KeyCodes.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+    const std::unordered_map<std::string, int>& namedKeys() {
+        static const std::unordered_map<std::string, int> keys = {
+            { "Space", Key::Space },
+            { "Escape", Key::Escape },
+            { "Enter", Key::Enter },
+            { "Tab", Key::Tab },
+            { "Backspace", Key::Backspace },
+            { "Right", Key::Right },
+            { "Left", Key::Left },
+            { "Down", Key::Down },
+            { "Up", Key::Up },
+            { "LeftShift", Key::LeftShift },
+            { "LeftControl", Key::LeftControl },
+            { "LeftAlt", Key::LeftAlt },
+            { "RightShift", Key::RightShift },
+            { "RightControl", Key::RightControl },
+            { "RightAlt", Key::RightAlt }
+        };
+        return keys;
+    }
+
+    bool parseInt(const std::string& text, int& value) {
+        char* end = nullptr;
+        long parsed = std::strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0') return false;
+        value = static_cast<int>(parsed);
+        return true;
+    }
+}
+
+ScriptedInputSource::ScriptedInputSource()
+    : nextEvent(0)
+    , tick(0)
+    , cursor(0.0f)
+{}
+
+bool ScriptedInputSource::loadFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open input script: " << path << std::endl;
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parse(buffer.str(), path);
+}
+
+bool ScriptedInputSource::parse(const std::string& text, const std::string& sourceName) {
+    // Parse everything first so a bad line leaves the source untouched
+    std::vector<Event> parsed;
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream fields(line);
+        long long eventTick;
+        std::string action;
+        if (!(fields >> eventTick)) {
+            // Blank and comment-only lines
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+            std::cerr << sourceName << ":" << lineNumber << ": expected a tick number" << std::endl;
+            return false;
+        }
+        if (eventTick < 0 || !(fields >> action)) {
+            std::cerr << sourceName << ":" << lineNumber << ": expected <tick> <action>" << std::endl;
+            return false;
+        }
+
+        Event event{ static_cast<uint64_t>(eventTick), EventType::Loop, -1, glm::vec2(0.0f) };
+
+        if (action == "press" || action == "release") {
+            std::string name;
+            fields >> name;
+            bool press = action == "press";
+            int button = findMouseButton(name);
+            if (button >= 0) {
+                event.type = press ? EventType::ButtonDown : EventType::ButtonUp;
+                event.code = button;
+            } else {
+                event.type = press ? EventType::KeyDown : EventType::KeyUp;
+                event.code = findKeyCode(name);
+            }
+            if (event.code < 0) {
+                std::cerr << sourceName << ":" << lineNumber << ": unknown key '" << name << "'" << std::endl;
+                return false;
+            }
+        } else if (action == "move") {
+            event.type = EventType::Move;
+            if (!(fields >> event.value.x >> event.value.y)) {
+                std::cerr << sourceName << ":" << lineNumber << ": move needs dx dy" << std::endl;
+                return false;
+            }
+        } else if (action == "scroll") {
+            event.type = EventType::Scroll;
+            if (!(fields >> event.value.y)) {
+                std::cerr << sourceName << ":" << lineNumber << ": scroll needs an amount" << std::endl;
+                return false;
+            }
+        } else if (action == "loop") {
+            if (event.tick == 0) {
+                std::cerr << sourceName << ":" << lineNumber << ": loop must come after tick 0" << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << sourceName << ":" << lineNumber << ": unknown action '" << action << "'" << std::endl;
+            return false;
+        }
+
+        parsed.push_back(event);
+    }
+
+    for (const Event& event : parsed) {
+        addEvent(event);
+    }
+    return true;
+}
+
+void ScriptedInputSource::addEvent(const Event& event) {
+    auto position = std::upper_bound(events.begin(), events.end(), event.tick,
+        [](uint64_t value, const Event& other) { return value < other.tick; });
+    events.insert(position, event);
+}
+
+void ScriptedInputSource::clear() {
+    events.clear();
+    nextEvent = 0;
+    tick = 0;
+    cursor = glm::vec2(0.0f);
+}
+
+void ScriptedInputSource::poll(Input& input) {
+    while (nextEvent < events.size() && events[nextEvent].tick <= tick) {
+        const Event& event = events[nextEvent++];
+        switch (event.type) {
+            case EventType::KeyDown:    input.setKey(event.code, true); break;
+            case EventType::KeyUp:      input.setKey(event.code, false); break;
+            case EventType::ButtonDown: input.setMouseButton(event.code, true); break;
+            case EventType::ButtonUp:   input.setMouseButton(event.code, false); break;
+            case EventType::Move:       cursor += event.value; break;
+            case EventType::Scroll:     input.addScroll(event.value.y); break;
+            case EventType::Loop:
+                // This tick becomes tick 0 of the next pass
+                tick = 0;
+                nextEvent = 0;
+                break;
+        }
+    }
+
+    input.setMousePosition(cursor);
+    ++tick;
+}
+
+int ScriptedInputSource::findKeyCode(const std::string& name) {
+    // Letters and digits map straight to their ASCII codes
+    if (name.size() == 1 && ((name[0] >= 'A' && name[0] <= 'Z') || (name[0] >= '0' && name[0] <= '9'))) {
+        return name[0];
+    }
+    if (name.size() == 4 && name.compare(0, 3, "Num") == 0 && name[3] >= '0' && name[3] <= '9') {
+        return name[3];
+    }
+
+    auto it = namedKeys().find(name);
+    if (it != namedKeys().end()) {
+        return it->second;
+    }
+
+    int code;
+    if (parseInt(name, code) && code >= 0 && code <= Key::Last) {
+        return code;
+    }
+    return -1;
+}
+
+int ScriptedInputSource::findMouseButton(const std::string& name) {
+    if (name == "MouseLeft") return MouseButton::Left;
+    if (name == "MouseRight") return MouseButton::Right;
+    if (name == "MouseMiddle") return MouseButton::Middle;
+    return -1;
+}
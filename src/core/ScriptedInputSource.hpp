@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "InputSource.hpp"
+
+// Input driven by a timeline of events keyed by simulation tick, for headless
+// runs and repeatable tests. Scripts are text, one event per line:
+//
+//   # tick  action   args
+//   0       press    W
+//   90      release  W
+//   90      move     40 0      (cursor moves by dx dy)
+//   120     press    MouseLeft
+//   200     scroll   1
+//   600     loop               (restart from tick 0)
+//
+// Keys use the KeyCodes.hpp names (W, Space, LeftShift, Num1, ...) or a raw
+// key code. Held keys stay down until released.
+class ScriptedInputSource : public InputSource {
+public:
+    enum class EventType {
+        KeyDown,
+        KeyUp,
+        ButtonDown,
+        ButtonUp,
+        Move,
+        Scroll,
+        Loop
+    };
+
+    struct Event {
+        uint64_t tick;
+        EventType type;
+        int code;        // Key or mouse button
+        glm::vec2 value; // Move: cursor delta. Scroll: x unused, y amount.
+    };
+
+    ScriptedInputSource();
+
+    bool loadFile(const std::string& path);
+    bool parse(const std::string& text, const std::string& sourceName = "script");
+    void addEvent(const Event& event);
+    void clear();
+
+    void poll(Input& input) override;
+
+    // Ticks polled since the start (or the last loop)
+    uint64_t getTick() const { return tick; }
+    // True once every event has been applied and the script does not loop
+    bool isFinished() const { return nextEvent >= events.size(); }
+    size_t getEventCount() const { return events.size(); }
+
+    // Key code for a KeyCodes.hpp name or a number, -1 if unknown
+    static int findKeyCode(const std::string& name);
+    // Mouse button for MouseLeft/MouseRight/MouseMiddle, -1 otherwise
+    static int findMouseButton(const std::string& name);
+
+private:
+    std::vector<Event> events; // Sorted by tick, stable
+    size_t nextEvent;
+    uint64_t tick;
+    glm::vec2 cursor;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <memory>
+
+// Immutable value shared between copies. Copying the holder only bumps a
+// reference count; the first edit() through a holder whose value is still
+// shared detaches a private copy (copy-on-write). Components cloned from a
+// Prefab reference their template's configuration this way instead of
+// duplicating it per instance.
+//
+// Reading is safe from any thread. edit() must not race with copies of the
+// same holder, which Prefab instantiation guarantees by running outside
+// Scene::update.
+template<typename T>
+class SharedData {
+public:
+    SharedData() = default;
+    explicit SharedData(T value) : data(std::make_shared<T>(std::move(value))) {}
+
+    const T& get() const { return data ? *data : empty(); }
+    const T& operator*() const { return get(); }
+    const T* operator->() const { return &get(); }
+
+    // Writable value, owned by this holder alone after the call
+    T& edit() {
+        if (!data) {
+            data = std::make_shared<T>();
+        } else if (data.use_count() > 1) {
+            data = std::make_shared<T>(*data);
+        }
+        return *data;
+    }
+
+    bool isShared() const { return data.use_count() > 1; }
+
+private:
+    // Null until the first edit; reads see a default-constructed T
+    std::shared_ptr<T> data;
+
+    static const T& empty() {
+        static const T value{};
+        return value;
+    }
+};
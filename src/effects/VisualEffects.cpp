@@ -1,21 +1,43 @@
 #include "VisualEffects.hpp"
 #include "ParticleSystem.hpp"
 #include "LineRenderer.hpp"
+#include "../core/AllocationTracker.hpp"
+#include "../core/Allocators.hpp"
 #include <algorithm>
 
+namespace {
+    // Shared by every VisualEffects component; effects are only spawned from
+    // the main thread or the VisualEffects system
+    ObjectPool<ParticleSystem>& particlePool() {
+        static ObjectPool<ParticleSystem> pool(64);
+        return pool;
+    }
+
+    // Typical number of concurrent effects per component, reserved up front
+    constexpr size_t EXPECTED_ACTIVE_EFFECTS = 32;
+}
+
 VisualEffects::VisualEffects() {
+    MEMORY_TAG(Effects);
+    activeEffects.reserve(EXPECTED_ACTIVE_EFFECTS);
     initializeBulletTrailRenderer();
 }
 
-VisualEffects::~VisualEffects() {}
+VisualEffects::~VisualEffects() {
+    for (auto& effect : activeEffects) {
+        particlePool().destroy(effect.particles);
+    }
+}
 
 void VisualEffects::update(float deltaTime) {
+    MEMORY_TAG(Effects);
     updateActiveEffects(deltaTime);
     removeFinishedEffects();
 }
 
 void VisualEffects::createMuzzleFlash(const glm::vec3& position, const glm::vec3& direction) {
-    auto particles = std::make_shared<ParticleSystem>();
+    MEMORY_TAG(Effects);
+    ParticleSystem* particles = particlePool().create();
     
     // Configure muzzle flash particles
     ParticleSystem::Settings settings;
@@ -41,11 +63,12 @@ void VisualEffects::createMuzzleFlash(const glm::vec3& position, const glm::vec3
 }
 
 void VisualEffects::createBulletTrail(const glm::vec3& start, const glm::vec3& end) {
+    MEMORY_TAG(Effects);
     // Add trail to renderer
     bulletTrailRenderer->addLine(start, end, glm::vec4(1.0f, 1.0f, 0.5f, 0.5f), 0.2f);
 
     // Add subtle particle trail
-    auto particles = std::make_shared<ParticleSystem>();
+    ParticleSystem* particles = particlePool().create();
     
     ParticleSystem::Settings settings;
     settings.startSize = 0.05f;
@@ -78,7 +101,8 @@ void VisualEffects::createBulletTrail(const glm::vec3& start, const glm::vec3& e
 }
 
 void VisualEffects::createImpactEffect(const glm::vec3& position, const glm::vec3& normal) {
-    auto particles = std::make_shared<ParticleSystem>();
+    MEMORY_TAG(Effects);
+    ParticleSystem* particles = particlePool().create();
     
     ParticleSystem::Settings settings;
     settings.startSize = 0.1f;
@@ -103,7 +127,8 @@ void VisualEffects::createImpactEffect(const glm::vec3& position, const glm::vec
 }
 
 void VisualEffects::createBloodSplatter(const glm::vec3& position, const glm::vec3& direction) {
-    auto particles = std::make_shared<ParticleSystem>();
+    MEMORY_TAG(Effects);
+    ParticleSystem* particles = particlePool().create();
     
     ParticleSystem::Settings settings;
     settings.startSize = 0.1f;
@@ -144,10 +169,13 @@ void VisualEffects::updateActiveEffects(float deltaTime) {
 }
 
 void VisualEffects::removeFinishedEffects() {
-    activeEffects.erase(
-        std::remove_if(activeEffects.begin(), activeEffects.end(),
-            [](const ActiveEffect& effect) {
-                return effect.lifetime >= effect.duration;
-            }),
-        activeEffects.end());
+    auto finished = std::partition(activeEffects.begin(), activeEffects.end(),
+        [](const ActiveEffect& effect) {
+            return effect.lifetime < effect.duration;
+        });
+
+    for (auto it = finished; it != activeEffects.end(); ++it) {
+        particlePool().destroy(it->particles);
+    }
+    activeEffects.erase(finished, activeEffects.end());
 }
@@ -12,6 +12,11 @@ public:
     VisualEffects();
     ~VisualEffects();
 
+    // Effects are owned through raw pool pointers, so only moves are allowed
+    VisualEffects(VisualEffects&& other) noexcept = default;
+    VisualEffects(const VisualEffects&) = delete;
+    VisualEffects& operator=(const VisualEffects&) = delete;
+
     void update(float deltaTime) override;
 
     // Weapon effects
@@ -31,7 +36,7 @@ public:
 
 private:
     struct ActiveEffect {
-        std::shared_ptr<ParticleSystem> particles;
+        ParticleSystem* particles; // Owned; returned to the particle pool when finished
         float lifetime;
         float duration;
     };
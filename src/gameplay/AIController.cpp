@@ -1,15 +1,85 @@
 #include "AIController.hpp"
 #include "../components/Transform.hpp"
 #include "../physics/PhysicsSystem.hpp"
+#include "../physics/Collider.hpp"
+#include "../physics/RigidBody.hpp"
+#include "../scene/Scene.hpp"
 #include "WeaponSystem.hpp"
 #include "HealthSystem.hpp"
 #include <algorithm>
 
+AIController::AIController()
+    : moveSpeed(3.0f)
+    , rotationSpeed(180.0f)
+    , aggressionRange(15.0f)
+    , attackRange(10.0f)
+    , accuracy(0.7f)
+    , currentState(State::Idle)
+    , stateTimer(0.0f)
+    , attackCooldown(0.0f)
+    , canSeeTarget(false)
+    , currentPatrolPoint(0)
+    , random(Random::createStream())
+{}
+
+AIController::AIController(const AIController& other)
+    : Component(other)
+    , moveSpeed(other.moveSpeed)
+    , rotationSpeed(other.rotationSpeed)
+    , aggressionRange(other.aggressionRange)
+    , attackRange(other.attackRange)
+    , accuracy(other.accuracy)
+    , currentState(other.currentState)
+    , stateTimer(other.stateTimer)
+    , attackCooldown(other.attackCooldown)
+    , canSeeTarget(other.canSeeTarget)
+    , currentTarget(other.currentTarget)
+    , patrolPoints(other.patrolPoints)
+    , currentPatrolPoint(other.currentPatrolPoint)
+    , random(Random::createStream())
+{}
+
+void AIController::update(float deltaTime) {
+    stateTimer += deltaTime;
+    if (attackCooldown > 0.0f) {
+        attackCooldown -= deltaTime;
+    }
+
+    canSeeTarget = checkTargetVisibility();
+
+    // Engage once the target is in sight
+    if (canSeeTarget && (currentState == State::Idle || currentState == State::Patrol)) {
+        setState(State::Chase);
+    }
+    if (canSeeTarget && currentState == State::Chase) {
+        Entity* target = getTargetEntity();
+        float distance = glm::length(target->getComponent<Transform>()->getPosition() -
+                                     getEntity()->getComponent<Transform>()->getPosition());
+        if (distance <= attackRange) {
+            setState(State::Attack);
+        }
+    }
+
+    switch (currentState) {
+        case State::Idle: updateIdleState(deltaTime); break;
+        case State::Patrol: updatePatrolState(deltaTime); break;
+        case State::Chase: updateChaseState(deltaTime); break;
+        case State::Attack: updateAttackState(deltaTime); break;
+        case State::Cover: updateCoverState(deltaTime); break;
+        case State::Flee: updateFleeState(deltaTime); break;
+    }
+}
+
+Entity* AIController::getTargetEntity() const {
+    return currentTarget ? entity->getScene()->getEntity(currentTarget) : nullptr;
+}
+
 bool AIController::checkTargetVisibility() {
-    if (!currentTarget) return false;
+    Entity* target = getTargetEntity();
+    if (!target) return false;
 
     auto transform = getEntity()->getComponent<Transform>();
-    auto targetTransform = currentTarget->getComponent<Transform>();
+    auto targetTransform = target->getComponent<Transform>();
 
     if (!transform || !targetTransform) return false;
 
@@ -20,12 +90,13 @@ bool AIController::checkTargetVisibility() {
 
     // Raycast to check for obstacles
     PhysicsSystem::RaycastHit hit;
-    if (PhysicsSystem::getInstance().raycast(transform->getPosition(), 
+    if (PhysicsSystem::getInstance().raycast(*entity->getScene(),
+                                           transform->getPosition(),
                                            glm::normalize(toTarget), 
                                            hit, 
                                            distance)) {
         // Check if we hit the target
-        return hit.collider->getEntity() == currentTarget;
+        return hit.collider->getEntity() == target;
     }
 
     return false;
@@ -58,12 +129,13 @@ void AIController::updatePatrolState(float deltaTime) {
 }
 
 void AIController::updateChaseState(float deltaTime) {
-    if (!currentTarget) {
+    Entity* target = getTargetEntity();
+    if (!target) {
         setState(State::Patrol);
         return;
     }
 
-    auto targetTransform = currentTarget->getComponent<Transform>();
+    auto targetTransform = target->getComponent<Transform>();
     if (!targetTransform) return;
 
     // Move towards target while maintaining some distance
@@ -84,12 +156,13 @@ void AIController::updateChaseState(float deltaTime) {
 }
 
 void AIController::updateAttackState(float deltaTime) {
-    if (!currentTarget) {
+    Entity* target = getTargetEntity();
+    if (!target) {
         setState(State::Patrol);
         return;
     }
 
-    auto targetTransform = currentTarget->getComponent<Transform>();
+    auto targetTransform = target->getComponent<Transform>();
     if (!targetTransform) return;
 
     // Face target
@@ -141,14 +214,15 @@ void AIController::updateCoverState(float deltaTime) {
 }
 
 void AIController::updateFleeState(float deltaTime) {
-    if (!currentTarget) {
+    Entity* target = getTargetEntity();
+    if (!target) {
         setState(State::Patrol);
         return;
     }
 
     // Run away from target
     auto transform = getEntity()->getComponent<Transform>();
-    auto targetTransform = currentTarget->getComponent<Transform>();
+    auto targetTransform = target->getComponent<Transform>();
 
     if (!transform || !targetTransform) return;
 
@@ -206,10 +280,10 @@ void AIController::rotateTowards(const glm::vec3& target, float deltaTime) {
 
 void AIController::performAttack() {
     auto weapons = getEntity()->getComponent<WeaponSystem>();
-    if (!weapons) return;
+    if (!weapons || !weapons->hasWeapon()) return;
 
     // Add some inaccuracy
-    float hitChance = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    float hitChance = random.nextFloat();
     if (hitChance <= accuracy) {
         weapons->startFiring();
     }
@@ -218,16 +292,28 @@ void AIController::performAttack() {
 }
 
 bool AIController::findCoverPosition(glm::vec3& coverPos) {
-    if (!currentTarget) return false;
+    Entity* target = getTargetEntity();
+    if (!target) return false;
 
     auto transform = getEntity()->getComponent<Transform>();
-    auto targetTransform = currentTarget->getComponent<Transform>();
+    auto targetTransform = target->getComponent<Transform>();
 
     if (!transform || !targetTransform) return false;
 
     // Sample points in a radius around the AI
     const int numSamples = 16;
     const float radius = 5.0f;
+    const float probeLength = 2.0f;
+
+    // Every probe starts within `radius` and ends within `probeLength` of
+    // that, so with no other collider in reach none of them can hit
+    bool anyCover = false;
+    Entity* self = getEntity();
+    self->getScene()->getSpatialIndex().querySphere(SpatialIndex::Layer::Colliders,
+        transform->getPosition(), radius + probeLength, [&anyCover, self](Entity* candidate) {
+            anyCover = anyCover || candidate != self;
+        });
+    if (!anyCover) return false;
 
     for (int i = 0; i < numSamples; i++) {
         float angle = (i / float(numSamples)) * 2.0f * 3.14159f;
@@ -237,7 +323,8 @@ bool AIController::findCoverPosition(glm::vec3& coverPos) {
         // Check if this point is behind cover relative to the target
         PhysicsSystem::RaycastHit hit;
         glm::vec3 toTarget = targetTransform->getPosition() - samplePoint;
-        if (PhysicsSystem::getInstance().raycast(samplePoint, glm::normalize(toTarget), hit, 2.0f)) {
+        if (PhysicsSystem::getInstance().raycast(*self->getScene(), samplePoint, glm::normalize(toTarget), hit,
+                                                 probeLength)) {
             // Point is behind cover
             coverPos = samplePoint;
             return true;
@@ -0,0 +1,81 @@
+#pragma once
+#include "../components/Component.hpp"
+#include "../core/Random.hpp"
+#include "../scene/EntityHandle.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+
+class AIController : public Component {
+public:
+    enum class State {
+        Idle,
+        Patrol,
+        Chase,
+        Attack,
+        Cover,
+        Flee
+    };
+
+    AIController();
+
+    // Copies roll accuracy from a stream of their own; relocation keeps it
+    AIController(const AIController& other);
+    AIController(AIController&&) noexcept = default;
+    AIController& operator=(const AIController&) = delete;
+
+    void update(float deltaTime) override;
+
+    // Behaviour settings
+    void setMoveSpeed(float speed) { moveSpeed = speed; }
+    void setRotationSpeed(float speed) { rotationSpeed = speed; }
+    void setAggressionRange(float range) { aggressionRange = range; }
+    void setAttackRange(float range) { attackRange = range; }
+    void setAccuracy(float value) { accuracy = value; }
+    void setPatrolPoints(const std::vector<glm::vec3>& points) { patrolPoints = points; }
+
+    // Targeting. Held as a handle so a destroyed target simply reads as none.
+    void setTarget(EntityHandle target) { currentTarget = target; }
+    EntityHandle getTarget() const { return currentTarget; }
+
+    // State
+    void setState(State newState);
+    State getState() const { return currentState; }
+
+private:
+    // Behaviour parameters
+    float moveSpeed;
+    float rotationSpeed;
+    float aggressionRange;
+    float attackRange;
+    float accuracy;
+
+    // State
+    State currentState;
+    float stateTimer;
+    float attackCooldown;
+    bool canSeeTarget;
+    EntityHandle currentTarget;
+
+    // Patrol
+    std::vector<glm::vec3> patrolPoints;
+    size_t currentPatrolPoint;
+
+    // Accuracy rolls
+    Random random;
+
+    // State handlers
+    void updateIdleState(float deltaTime);
+    void updatePatrolState(float deltaTime);
+    void updateChaseState(float deltaTime);
+    void updateAttackState(float deltaTime);
+    void updateCoverState(float deltaTime);
+    void updateFleeState(float deltaTime);
+
+    // Internal methods
+    Entity* getTargetEntity() const;
+    bool checkTargetVisibility();
+    void moveToPosition(const glm::vec3& position, float deltaTime);
+    void rotateTowards(const glm::vec3& target, float deltaTime);
+    void performAttack();
+    bool findCoverPosition(glm::vec3& coverPos);
+};
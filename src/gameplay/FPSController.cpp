@@ -4,7 +4,9 @@
 #include "../components/Camera.hpp"
 #include "../physics/RigidBody.hpp"
 #include "../physics/CapsuleCollider.hpp"
-#include <GLFW/glfw3.h>
+#include "../physics/PhysicsSystem.hpp"
+#include "../scene/Entity.hpp"
+#include "../scene/Scene.hpp"
 
 FPSController::FPSController()
     : moveSpeed(5.0f)
@@ -35,10 +37,10 @@ void FPSController::handleMovementInput(float deltaTime) {
     
     // Get movement input
     glm::vec3 inputDir(0.0f);
-    if (input.isKeyPressed(GLFW_KEY_W)) inputDir.z += 1.0f;
-    if (input.isKeyPressed(GLFW_KEY_S)) inputDir.z -= 1.0f;
-    if (input.isKeyPressed(GLFW_KEY_A)) inputDir.x -= 1.0f;
-    if (input.isKeyPressed(GLFW_KEY_D)) inputDir.x += 1.0f;
+    if (input.isKeyPressed(Key::W)) inputDir.z += 1.0f;
+    if (input.isKeyPressed(Key::S)) inputDir.z -= 1.0f;
+    if (input.isKeyPressed(Key::A)) inputDir.x -= 1.0f;
+    if (input.isKeyPressed(Key::D)) inputDir.x += 1.0f;
 
     // Normalize input direction
     if (glm::length(inputDir) > 0.0f) {
@@ -54,21 +56,21 @@ void FPSController::handleMovementInput(float deltaTime) {
     moveDirection = forward * inputDir.z + right * inputDir.x;
 
     // Handle sprint
-    if (input.isKeyPressed(GLFW_KEY_LEFT_SHIFT)) {
+    if (input.isKeyPressed(Key::LeftShift)) {
         startSprint();
     } else {
         stopSprint();
     }
 
     // Handle crouch
-    if (input.isKeyPressed(GLFW_KEY_LEFT_CONTROL)) {
+    if (input.isKeyPressed(Key::LeftControl)) {
         startCrouch();
     } else {
         stopCrouch();
     }
 
     // Handle jump
-    if (input.isKeyPressed(GLFW_KEY_SPACE) && grounded) {
+    if (input.isKeyPressed(Key::Space) && grounded) {
         jump();
     }
 }
@@ -125,7 +127,7 @@ void FPSController::checkGrounded() {
     glm::vec3 start = transform->getPosition();
     glm::vec3 end = start - glm::vec3(0.0f, 0.1f, 0.0f);
 
-    grounded = PhysicsSystem::getInstance().raycast(start, end - start, hit);
+    grounded = PhysicsSystem::getInstance().raycast(*getEntity()->getScene(), start, end - start, hit);
 }
 
 void FPSController::jump() {
@@ -162,7 +164,7 @@ void FPSController::stopCrouch() {
         glm::vec3 start = transform->getPosition();
         glm::vec3 end = start + glm::vec3(0.0f, standingHeight - crouchHeight, 0.0f);
 
-        if (!PhysicsSystem::getInstance().raycast(start, end - start, hit)) {
+        if (!PhysicsSystem::getInstance().raycast(*getEntity()->getScene(), start, end - start, hit)) {
             crouching = false;
         }
     }
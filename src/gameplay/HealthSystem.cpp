@@ -1,4 +1,6 @@
 #include "HealthSystem.hpp"
+#include "../scene/Scene.hpp"
+#include <glm/glm.hpp>
 
 HealthSystem::HealthSystem()
     : maxHealth(100.0f)
@@ -6,6 +8,7 @@ HealthSystem::HealthSystem()
     , damageMultiplier(1.0f)
     , regenAmount(0.0f)
     , invulnerable(false)
+    , destroyOnDeath(false)
 {}
 
 void HealthSystem::setMaxHealth(float max) {
@@ -19,7 +22,7 @@ void HealthSystem::setHealth(float current) {
     currentHealth = glm::clamp(current, 0.0f, maxHealth);
 }
 
-void HealthSystem::takeDamage(float amount, Entity* damager) {
+void HealthSystem::takeDamage(float amount, EntityHandle damager) {
     if (invulnerable || amount <= 0 || !isAlive()) return;
 
     float actualDamage = amount * damageMultiplier;
@@ -29,8 +32,14 @@ void HealthSystem::takeDamage(float amount, Entity* damager) {
         damageCallback(actualDamage, damager);
     }
 
-    if (currentHealth <= 0 && deathCallback) {
-        deathCallback(damager);
+    if (currentHealth <= 0) {
+        if (deathCallback) {
+            deathCallback(damager);
+        }
+        if (destroyOnDeath && getEntity()) {
+            Entity* owner = getEntity();
+            owner->getScene()->getCommandBuffer().destroyEntity(owner->getHandle());
+        }
     }
 }
 
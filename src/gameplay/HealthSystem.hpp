@@ -1,5 +1,6 @@
 #pragma once
 #include "../components/Component.hpp"
+#include "../scene/EntityHandle.hpp"
 #include <functional>
 
 class HealthSystem : public Component {
@@ -8,23 +9,27 @@ public:
 
     void setMaxHealth(float max);
     void setHealth(float current);
-    void takeDamage(float amount, Entity* damager = nullptr);
+    void takeDamage(float amount, EntityHandle damager = EntityHandle());
     void heal(float amount);
 
     float getHealth() const { return currentHealth; }
     float getMaxHealth() const { return maxHealth; }
     bool isAlive() const { return currentHealth > 0; }
 
-    // Event callbacks
-    void onDamage(const std::function<void(float, Entity*)>& callback) { damageCallback = callback; }
+    // Event callbacks. The damager is passed as a handle since it may be
+    // destroyed before the callback's owner looks at it again.
+    void onDamage(const std::function<void(float, EntityHandle)>& callback) { damageCallback = callback; }
     void onHeal(const std::function<void(float)>& callback) { healCallback = callback; }
-    void onDeath(const std::function<void(Entity*)>& callback) { deathCallback = callback; }
+    void onDeath(const std::function<void(EntityHandle)>& callback) { deathCallback = callback; }
 
     // Damage modifiers
     void setDamageMultiplier(float multiplier) { damageMultiplier = multiplier; }
     void setInvulnerable(bool invuln) { invulnerable = invuln; }
     void setRegeneration(float amountPerSecond) { regenAmount = amountPerSecond; }
 
+    // Queue the owning entity for destruction at the next sync point on death
+    void setDestroyOnDeath(bool destroy) { destroyOnDeath = destroy; }
+
     void update(float deltaTime) override;
 
 private:
@@ -33,8 +38,9 @@ private:
     float damageMultiplier;
     float regenAmount;
     bool invulnerable;
+    bool destroyOnDeath;
 
-    std::function<void(float, Entity*)> damageCallback;
+    std::function<void(float, EntityHandle)> damageCallback;
     std::function<void(float)> healCallback;
-    std::function<void(Entity*)> deathCallback;
+    std::function<void(EntityHandle)> deathCallback;
 };
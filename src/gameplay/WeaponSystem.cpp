@@ -1,8 +1,10 @@
 #include "WeaponSystem.hpp"
-#include "../core/Input.hpp"
 #include "../components/Transform.hpp"
 #include "../physics/PhysicsSystem.hpp"
-#include <GLFW/glfw3.h>
+#include "../physics/Collider.hpp"
+#include "../scene/Scene.hpp"
+#include "HealthSystem.hpp"
+#include <cmath>
 
 WeaponSystem::WeaponSystem()
     : currentWeapon(0)
@@ -14,10 +16,26 @@ WeaponSystem::WeaponSystem()
     , totalAmmo(0)
     , currentRecoil(0.0f)
     , recoilVelocity(0.0f)
+    , random(Random::createStream())
+{}
+
+WeaponSystem::WeaponSystem(const WeaponSystem& other)
+    : Component(other)
+    , weapons(other.weapons)
+    , currentWeapon(other.currentWeapon)
+    , firing(other.firing)
+    , reloading(other.reloading)
+    , fireTimer(other.fireTimer)
+    , reloadTimer(other.reloadTimer)
+    , currentAmmo(other.currentAmmo)
+    , totalAmmo(other.totalAmmo)
+    , currentRecoil(other.currentRecoil)
+    , recoilVelocity(other.recoilVelocity)
+    , random(Random::createStream())
 {}
 
 void WeaponSystem::update(float deltaTime) {
-    if (weapons.empty()) return;
+    if (weapons->empty()) return;
 
     // Update timers
     if (fireTimer > 0.0f) {
@@ -29,7 +47,7 @@ void WeaponSystem::update(float deltaTime) {
         if (reloadTimer <= 0.0f) {
             // Finish reloading
             reloading = false;
-            const auto& weapon = weapons[currentWeapon];
+            const auto& weapon = (*weapons)[currentWeapon];
             int ammoNeeded = weapon.magazineSize - currentAmmo;
             int ammoAvailable = std::min(ammoNeeded, totalAmmo);
             currentAmmo += ammoAvailable;
@@ -45,8 +63,8 @@ void WeaponSystem::update(float deltaTime) {
 }
 
 void WeaponSystem::addWeapon(const WeaponData& data) {
-    weapons.push_back(data);
-    if (weapons.size() == 1) {
+    weapons.edit().push_back(data);
+    if (weapons->size() == 1) {
         // First weapon added, initialize ammo
         currentAmmo = data.magazineSize;
         totalAmmo = data.magazineSize * 3;
@@ -54,7 +72,7 @@ void WeaponSystem::addWeapon(const WeaponData& data) {
 }
 
 void WeaponSystem::switchWeapon(int index) {
-    if (index >= 0 && index < weapons.size() && index != currentWeapon) {
+    if (index >= 0 && index < weapons->size() && index != currentWeapon) {
         currentWeapon = index;
         firing = false;
         reloading = false;
@@ -64,11 +82,11 @@ void WeaponSystem::switchWeapon(int index) {
 }
 
 void WeaponSystem::nextWeapon() {
-    switchWeapon((currentWeapon + 1) % weapons.size());
+    switchWeapon((currentWeapon + 1) % weapons->size());
 }
 
 void WeaponSystem::previousWeapon() {
-    switchWeapon((currentWeapon - 1 + weapons.size()) % weapons.size());
+    switchWeapon((currentWeapon - 1 + weapons->size()) % weapons->size());
 }
 
 void WeaponSystem::startFiring() {
@@ -83,9 +101,9 @@ void WeaponSystem::stopFiring() {
 }
 
 void WeaponSystem::reload() {
-    if (!reloading && currentAmmo < weapons[currentWeapon].magazineSize && totalAmmo > 0) {
+    if (!reloading && currentAmmo < (*weapons)[currentWeapon].magazineSize && totalAmmo > 0) {
         reloading = true;
-        reloadTimer = weapons[currentWeapon].reloadTime;
+        reloadTimer = (*weapons)[currentWeapon].reloadTime;
         firing = false;
     }
 }
@@ -97,7 +115,7 @@ void WeaponSystem::handleFiring(float deltaTime) {
 }
 
 void WeaponSystem::handleRecoil(float deltaTime) {
-    const auto& weapon = weapons[currentWeapon];
+    const auto& weapon = (*weapons)[currentWeapon];
     float recovery = weapon.recoilRecovery * deltaTime;
 
     // Apply spring-like recovery
@@ -117,7 +135,7 @@ void WeaponSystem::handleRecoil(float deltaTime) {
 }
 
 void WeaponSystem::fire() {
-    const auto& weapon = weapons[currentWeapon];
+    const auto& weapon = (*weapons)[currentWeapon];
     
     // Consume ammo
     currentAmmo--;
@@ -125,13 +143,14 @@ void WeaponSystem::fire() {
 
     // Calculate spread
     float spreadAngle = weapon.spread * (3.14159f / 180.0f);
-    float randomAngle = static_cast<float>(rand()) / RAND_MAX * 2.0f * 3.14159f;
-    float randomRadius = static_cast<float>(rand()) / RAND_MAX * spreadAngle;
+    float randomAngle = random.nextFloat() * 2.0f * 3.14159f;
+    float randomRadius = random.nextFloat() * spreadAngle;
 
+    // Cone around -Z, the shooter's forward as Transform::getForward() defines it
     glm::vec3 spreadDir(
         cos(randomAngle) * sin(randomRadius),
         sin(randomAngle) * sin(randomRadius),
-        cos(randomRadius)
+        -cos(randomRadius)
     );
 
     // Transform spread direction to world space
@@ -142,9 +161,21 @@ void WeaponSystem::fire() {
     // Perform raycast
     PhysicsSystem::RaycastHit hit;
     glm::vec3 start = transform->getPosition();
-    if (PhysicsSystem::getInstance().raycast(start, spreadDir, hit, weapon.range)) {
-        // Handle hit
-        // TODO: Apply damage to hit entity
+    if (PhysicsSystem::getInstance().raycast(*getEntity()->getScene(), start, spreadDir, hit, weapon.range)) {
+        // Damage is deferred: the target's death handlers may destroy
+        // entities, which must not happen while the scene is iterating
+        Entity* target = hit.collider ? hit.collider->getEntity() : nullptr;
+        if (target) {
+            Entity* shooter = getEntity();
+            EntityHandle shooterHandle = shooter->getHandle();
+            float damage = weapon.damage;
+            shooter->getScene()->getCommandBuffer().record(target->getHandle(),
+                [damage, shooterHandle](Entity& victim) {
+                    if (auto health = victim.getComponent<HealthSystem>()) {
+                        health->takeDamage(damage, shooterHandle);
+                    }
+                });
+        }
     }
 
     // Apply recoil
@@ -152,10 +183,10 @@ void WeaponSystem::fire() {
 }
 
 void WeaponSystem::applyRecoil() {
-    const auto& weapon = weapons[currentWeapon];
+    const auto& weapon = (*weapons)[currentWeapon];
     
     // Calculate random recoil
-    float horizontalRecoil = (static_cast<float>(rand()) / RAND_MAX - 0.5f) * weapon.recoilHorizontal;
+    float horizontalRecoil = random.range(-0.5f, 0.5f) * weapon.recoilHorizontal;
     float verticalRecoil = weapon.recoilVertical;
 
     // Add recoil impulse
@@ -163,9 +194,9 @@ void WeaponSystem::applyRecoil() {
 }
 
 bool WeaponSystem::canFire() const {
-    return !weapons.empty() &&
+    return !weapons->empty() &&
            !reloading &&
            fireTimer <= 0.0f &&
            currentAmmo > 0 &&
-           (weapons[currentWeapon].automatic || !firing);
+           ((*weapons)[currentWeapon].automatic || !firing);
 }
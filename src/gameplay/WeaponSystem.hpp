@@ -1,5 +1,8 @@
 #pragma once
 #include "../components/Component.hpp"
+#include "../core/Random.hpp"
+#include "../core/SharedData.hpp"
+#include <glm/glm.hpp>
 #include <string>
 #include <vector>
 #include <memory>
@@ -28,6 +31,13 @@ struct WeaponData {
 class WeaponSystem : public Component {
 public:
     WeaponSystem();
+
+    // Copies share the loadout until either side adds a weapon, and roll
+    // spread from a stream of their own. Relocation keeps the stream.
+    WeaponSystem(const WeaponSystem& other);
+    WeaponSystem(WeaponSystem&&) noexcept = default;
+    WeaponSystem& operator=(const WeaponSystem&) = delete;
+
     void update(float deltaTime) override;
 
     // Weapon management
@@ -42,13 +52,16 @@ public:
     void reload();
 
     // State getters
+    bool hasWeapon() const { return !weapons->empty(); }
+    const WeaponData& getActiveWeapon() const { return (*weapons)[currentWeapon]; }
     bool isFiring() const { return firing; }
     bool isReloading() const { return reloading; }
     int getCurrentAmmo() const { return currentAmmo; }
     int getTotalAmmo() const { return totalAmmo; }
 
 private:
-    std::vector<WeaponData> weapons;
+    // Read-only after setup, so bots spawned from one prefab share it
+    SharedData<std::vector<WeaponData>> weapons;
     int currentWeapon;
     
     // Weapon state
@@ -63,6 +76,9 @@ private:
     glm::vec2 currentRecoil;
     glm::vec2 recoilVelocity;
 
+    // Spread and recoil rolls
+    Random random;
+
     // Internal methods
     void handleFiring(float deltaTime);
     void handleRecoil(float deltaTime);
@@ -0,0 +1,392 @@
+// Headless simulation: Scene, physics and the gameplay components with no
+// window, GL context or input device. Input comes from a ScriptedInputSource
+// and ticks run back to back, so the tick timings printed at the end are the
+// simulation's throughput on this machine.
+//
+// --record saves the input the run saw; --replay plays a recording back with
+// its seed and tick rate, reproducing that run given the same --bots.
+//
+//   engine_headless [--ticks N] [--bots N] [--script file] [--threads N] [--tick-rate Hz]
+//                   [--trace file] [--memory-interval N] [--seed N]
+//                   [--record file] [--replay file]
+#include "../core/AllocationTracker.hpp"
+#include "../core/Allocators.hpp"
+#include "../core/GameLoop.hpp"
+#include "../core/Input.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/Random.hpp"
+#include "../core/ScriptedInputSource.hpp"
+#include "../components/Transform.hpp"
+#include "../gameplay/AIController.hpp"
+#include "../gameplay/FPSController.hpp"
+#include "../gameplay/HealthSystem.hpp"
+#include "../gameplay/WeaponSystem.hpp"
+#include "../physics/CapsuleCollider.hpp"
+#include "../physics/Collider.hpp"
+#include "../physics/PhysicsSystem.hpp"
+#include "../physics/RigidBody.hpp"
+#include "../scene/Prefab.hpp"
+#include "../scene/Scene.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        uint64_t ticks = 0;   // 0: 3600, or the whole recording with --replay
+        int bots = 64;
+        std::string script;
+        int threads = 0;      // Including the main thread; 0 for the JobSystem default
+        double tickRate = 60.0;
+        std::string trace;    // Chrome trace of the last profiled ticks
+        uint64_t memoryInterval = 0;  // Ticks between memory dumps; 0 for only at the end
+        uint64_t seed = 1;
+        std::string record;
+        std::string replay;
+    };
+
+    struct Stats {
+        uint64_t botKills = 0;
+        uint64_t playerDeaths = 0;
+    };
+
+    // Used when no --script is given: strafe a square, turn, fire in bursts
+    const char* DEFAULT_SCRIPT = R"(
+        0    press   W
+        0    press   MouseLeft
+        30   release MouseLeft
+        60   move    120 0
+        90   release W
+        90   press   D
+        120  press   MouseLeft
+        150  release MouseLeft
+        180  release D
+        180  press   S
+        200  press   R
+        201  release R
+        270  release S
+        270  press   A
+        300  move    -120 0
+        360  release A
+        360  loop
+    )";
+
+    void printUsage() {
+        std::cout << "Usage: engine_headless [--ticks N] [--bots N] [--script file] "
+                     "[--threads N] [--tick-rate Hz] [--trace file] [--memory-interval N] [--seed N] "
+                     "[--record file] [--replay file]" << std::endl;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return false;
+            }
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+
+            std::string value = argv[++i];
+            if (arg == "--ticks") {
+                options.ticks = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (arg == "--bots") {
+                options.bots = std::max(0, std::atoi(value.c_str()));
+            } else if (arg == "--script") {
+                options.script = value;
+            } else if (arg == "--threads") {
+                options.threads = std::max(0, std::atoi(value.c_str()));
+            } else if (arg == "--tick-rate") {
+                options.tickRate = std::atof(value.c_str());
+            } else if (arg == "--trace") {
+                options.trace = value;
+            } else if (arg == "--memory-interval") {
+                options.memoryInterval = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (arg == "--seed") {
+                options.seed = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (arg == "--record") {
+                options.record = value;
+            } else if (arg == "--replay") {
+                options.replay = value;
+            } else {
+                std::cerr << "Unknown option " << arg << std::endl;
+                printUsage();
+                return false;
+            }
+        }
+
+        if (!options.trace.empty() && !Profiler::isCompiledIn()) {
+            std::cerr << "--trace needs a build with ENGINE_PROFILING" << std::endl;
+            return false;
+        }
+        if (options.memoryInterval > 0 && !AllocationTracker::isEnabled()) {
+            std::cerr << "--memory-interval needs a build with ENGINE_TRACK_ALLOCATIONS" << std::endl;
+            return false;
+        }
+        if (!options.replay.empty() && !options.script.empty()) {
+            std::cerr << "--replay and --script are exclusive" << std::endl;
+            return false;
+        }
+        if (options.tickRate <= 0.0) {
+            std::cerr << "Tick rate must be positive" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    WeaponData makeRifle(float damage, float fireRate) {
+        WeaponData rifle;
+        rifle.name = "Rifle";
+        rifle.damage = damage;
+        rifle.fireRate = fireRate;
+        rifle.reloadTime = 2.0f;
+        rifle.magazineSize = 30;
+        rifle.range = 100.0f;
+        rifle.spread = 2.0f;
+        rifle.automatic = true;
+        rifle.recoilVertical = 0.1f;
+        rifle.recoilHorizontal = 0.05f;
+        rifle.recoilRecovery = 5.0f;
+        return rifle;
+    }
+
+    void createGround(Scene& scene) {
+        Entity* ground = scene.createEntity("Ground");
+        ground->addComponent<Transform>()->setPosition(glm::vec3(0.0f, -0.5f, 0.0f));
+        ground->addComponent<BoxCollider>()->setSize(glm::vec3(200.0f, 1.0f, 200.0f));
+    }
+
+    EntityHandle createPlayer(Scene& scene, Stats& stats) {
+        Entity* player = scene.createEntity("Player");
+        player->addComponent<Transform>()->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+        player->addComponent<RigidBody>()->setMass(80.0f);
+
+        auto capsule = player->addComponent<CapsuleCollider>();
+        capsule->setRadius(0.3f);
+        capsule->setHeight(1.8f);
+
+        player->addComponent<FPSController>();
+        player->addComponent<WeaponSystem>()->addWeapon(makeRifle(25.0f, 10.0f));
+
+        // The player never leaves the run; death just restores health
+        auto health = player->addComponent<HealthSystem>();
+        health->setMaxHealth(100.0f);
+        health->setRegeneration(1.0f);
+        EntityHandle handle = player->getHandle();
+        Scene* owner = &scene;
+        health->onDeath([owner, handle, &stats](EntityHandle) {
+            stats.playerDeaths++;
+            if (Entity* entity = owner->getEntity(handle)) {
+                entity->getComponent<HealthSystem>()->setHealth(100.0f);
+            }
+        });
+        return handle;
+    }
+
+    void createBots(Scene& scene, int count, EntityHandle player, Stats& stats) {
+        // Spawns on a ring around the player, patrolling between neighbours.
+        // The ring sits inside AIController's default 15 m aggression range,
+        // so bots engage from the start.
+        const float radius = 12.0f;
+        std::vector<glm::vec3> spawnPoints;
+        for (int i = 0; i < count; ++i) {
+            float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(count);
+            spawnPoints.push_back(glm::vec3(std::cos(angle) * radius, 1.0f, std::sin(angle) * radius));
+        }
+
+        // Everything the bots have in common is set up once on the prefab;
+        // instances share its weapon loadout
+        Prefab prefab("Bot");
+        prefab.addComponent<Transform>();
+        prefab.addComponent<RigidBody>()->setMass(70.0f);
+
+        auto capsule = prefab.addComponent<CapsuleCollider>();
+        capsule->setRadius(0.3f);
+        capsule->setHeight(1.8f);
+
+        auto prototypeAI = prefab.addComponent<AIController>();
+        prototypeAI->setTarget(player);
+        prototypeAI->setState(AIController::State::Patrol);
+
+        prefab.addComponent<WeaponSystem>()->addWeapon(makeRifle(10.0f, 5.0f));
+        prefab.addComponent<HealthSystem>()->setMaxHealth(100.0f);
+
+        std::vector<Entity*> bots = prefab.instantiate(scene, static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            Entity* bot = bots[i];
+            glm::vec3 spawn = spawnPoints[i];
+            bot->getComponent<Transform>()->setPosition(spawn);
+            bot->getComponent<AIController>()->setPatrolPoints({ spawn, spawnPoints[(i + 1) % count] });
+
+            // Dead bots respawn in place so the population stays constant
+            EntityHandle handle = bot->getHandle();
+            Scene* owner = &scene;
+            bot->getComponent<HealthSystem>()->onDeath([owner, handle, spawn, &stats](EntityHandle) {
+                stats.botKills++;
+                if (Entity* entity = owner->getEntity(handle)) {
+                    entity->getComponent<Transform>()->teleport(spawn);
+                    entity->getComponent<HealthSystem>()->setHealth(100.0f);
+                    entity->getComponent<AIController>()->setState(AIController::State::Patrol);
+                }
+            });
+        }
+    }
+
+    // Weapon buttons; movement and look are read by FPSController itself
+    void applyPlayerInput(Scene& scene, EntityHandle player) {
+        Entity* entity = scene.getEntity(player);
+        if (!entity) return;
+
+        Input& input = Input::getInstance();
+        auto weapons = entity->getComponent<WeaponSystem>();
+        if (input.isMouseButtonJustPressed(MouseButton::Left)) weapons->startFiring();
+        if (input.isMouseButtonReleased(MouseButton::Left) && weapons->isFiring()) weapons->stopFiring();
+        if (input.isKeyJustPressed(Key::R)) weapons->reload();
+    }
+
+    // FNV-1a over every entity position. Equal across a recording and its
+    // replays when the simulation is deterministic.
+    uint64_t stateChecksum(Scene& scene) {
+        uint64_t hash = 14695981039346656037ULL;
+        scene.view<Transform>().each([&hash](Entity*, Transform& transform) {
+            glm::vec3 position = transform.getPosition();
+            uint32_t bits[3];
+            std::memcpy(bits, &position, sizeof(bits));
+            for (uint32_t word : bits) {
+                hash = (hash ^ word) * 1099511628211ULL;
+            }
+        });
+        return hash;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return -1;
+    }
+
+    Input& input = Input::getInstance();
+    if (!options.replay.empty()) {
+        auto recording = std::make_unique<InputRecording>();
+        if (!recording->load(options.replay)) {
+            return -1;
+        }
+        options.seed = recording->getSeed();
+        options.tickRate = recording->getTickRate();
+        if (options.ticks == 0) {
+            options.ticks = recording->getTickCount();
+        }
+        input.startReplay(std::move(recording));
+    } else {
+        auto script = std::make_unique<ScriptedInputSource>();
+        bool loaded = options.script.empty()
+            ? script->parse(DEFAULT_SCRIPT, "default script")
+            : script->loadFile(options.script);
+        if (!loaded) {
+            return -1;
+        }
+        input.setSource(std::move(script));
+    }
+    if (options.ticks == 0) {
+        options.ticks = 3600;
+    }
+
+    // A single thread leaves the JobSystem off and systems run in order
+    if (options.threads != 1) {
+        JobSystem::getInstance().initialize(options.threads > 1 ? static_cast<unsigned>(options.threads - 1) : 0u);
+    }
+    PhysicsSystem::getInstance().initialize();
+    AllocationTracker::setDumpInterval(options.memoryInterval);
+
+    // Seeded before the scene exists: components take their Random streams
+    // on construction
+    Random::setSeed(options.seed);
+    if (!options.record.empty()) {
+        input.startRecording(options.tickRate);
+    }
+
+    Stats stats;
+    int exitCode = 0;
+    {
+        Scene scene;
+        createGround(scene);
+        EntityHandle player = createPlayer(scene, stats);
+        createBots(scene, options.bots, player, stats);
+
+        // One tick per frame, as fast as the machine allows. Nothing renders,
+        // so transform interpolation is skipped.
+        GameLoop::Settings settings;
+        settings.tickRate = options.tickRate;
+        settings.maxTicksPerFrame = 1;
+        settings.interpolate = false;
+        GameLoop loop(settings);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t tick = 0; tick < options.ticks; ++tick) {
+            loop.frame(loop.getFixedDeltaTime(),
+                [&scene, player](float deltaTime) {
+                    Input::getInstance().update();
+                    applyPlayerInput(scene, player);
+                    scene.update(deltaTime);
+                    PhysicsSystem::getInstance().update(deltaTime);
+                    JobSystem::getInstance().processMainThreadJobs();
+                },
+                [](float) {});
+
+            FrameArena::resetAll();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double simulated = static_cast<double>(options.ticks) / options.tickRate;
+        std::cout << "Simulated " << simulated << " s (" << options.ticks << " ticks, "
+                  << scene.getEntities().size() << " entities, "
+                  << JobSystem::getInstance().getWorkerCount() + 1 << " threads) in " << seconds << " s: "
+                  << (seconds > 0.0 ? static_cast<double>(options.ticks) / seconds : 0.0) << " ticks/s, "
+                  << (seconds > 0.0 ? simulated / seconds : 0.0) << "x real time" << std::endl;
+        std::cout << "Bot kills: " << stats.botKills << ", player deaths: " << stats.playerDeaths
+                  << ", state checksum: " << std::hex << stateChecksum(scene) << std::dec << std::endl;
+        loop.printTimings(std::cout);
+        if (AllocationTracker::isEnabled()) {
+            AllocationTracker::dump(std::cout);
+        }
+
+        if (!options.trace.empty() && !Profiler::getInstance().writeChromeTrace(options.trace)) {
+            exitCode = -1;
+        }
+
+        if (!scene.isValid(player)) {
+            std::cerr << "Player entity was destroyed during the run" << std::endl;
+            exitCode = -1;
+        }
+
+        // A soak where nobody dies measured idle bots, not combat
+        if (options.bots > 0 && stats.botKills == 0) {
+            std::cerr << "No bot was killed during the run" << std::endl;
+            exitCode = -1;
+        }
+    }
+
+    if (!options.record.empty()) {
+        auto recording = input.stopRecording();
+        if (recording->save(options.record)) {
+            std::cout << "Recorded " << recording->getEvents().size() << " input events to "
+                      << options.record << std::endl;
+        } else {
+            exitCode = -1;
+        }
+    }
+
+    input.setSource(nullptr);
+    JobSystem::getInstance().shutdown();
+    return exitCode;
+}
@@ -1,7 +1,57 @@
 #include "examples/DemoScene.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/Allocators.hpp"
+#include "core/GameLoop.hpp"
+#include "core/Input.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include "core/Random.hpp"
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <string>
+
+// Game [--seed N] [--record file] [--replay file]
+//
+// --record saves every input event of the session. --replay plays one back
+// with its seed and tick rate, one tick per frame, and exits at the end, so
+// the same session can be profiled build after build.
+int main(int argc, char** argv) {
+    if (argc % 2 == 0) {
+        std::cerr << "Usage: " << argv[0] << " [--seed N] [--record file] [--replay file]" << std::endl;
+        return -1;
+    }
+
+    uint64_t seed = 0;
+    std::string recordPath;
+    std::unique_ptr<InputRecording> replay;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--seed") {
+            seed = std::strtoull(argv[i + 1], nullptr, 10);
+        } else if (arg == "--record") {
+            recordPath = argv[i + 1];
+        } else if (arg == "--replay") {
+            replay = std::make_unique<InputRecording>();
+            if (!replay->load(argv[i + 1])) {
+                return -1;
+            }
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return -1;
+        }
+    }
+
+    GameLoop::Settings settings;
+    if (replay) {
+        seed = replay->getSeed();
+        settings.tickRate = replay->getTickRate();
+    }
+    // Before the scene exists: components take their Random streams on construction
+    Random::setSeed(seed);
+
+    JobSystem::getInstance().initialize();
 
-int main() {
     DemoScene demo;
 
     if (!demo.initialize()) {
@@ -9,15 +59,41 @@ int main() {
         return -1;
     }
 
+    // Simulation runs at a fixed rate; rendering blends the last two ticks
+    GameLoop loop(settings);
+
+    // After initialize(), which installs the window's input source
+    Input& input = Input::getInstance();
+    if (replay) {
+        input.startReplay(std::move(replay));
+    } else if (!recordPath.empty()) {
+        input.startRecording(settings.tickRate);
+    }
+
     // Main game loop
-    float lastTime = 0.0f;
+    double lastTime = glfwGetTime();
     while (true) {
-        float currentTime = static_cast<float>(glfwGetTime());
-        float deltaTime = currentTime - lastTime;
+        double currentTime = glfwGetTime();
+        double elapsed = currentTime - lastTime;
         lastTime = currentTime;
 
-        demo.update(deltaTime);
-        demo.render();
+        // Replays step exactly one tick per frame regardless of frame time
+        if (input.isReplaying()) {
+            if (input.isReplayFinished()) break;
+            elapsed = loop.getFixedDeltaTime();
+        }
+
+        loop.frame(elapsed,
+            [&demo](float deltaTime) {
+                demo.update(deltaTime);
+                JobSystem::getInstance().processMainThreadJobs();
+            },
+            [&demo](float) {
+                demo.render();
+            });
+
+        // Per-frame scratch memory is released once the frame is done
+        FrameArena::resetAll();
 
         // Break the loop if the window should close
         if (glfwWindowShouldClose(glfwGetCurrentContext())) {
@@ -25,5 +101,21 @@ int main() {
         }
     }
 
+    if (input.isRecording()) {
+        auto recording = input.stopRecording();
+        if (recording->save(recordPath)) {
+            std::cout << "Recorded " << recording->getEvents().size() << " input events to "
+                      << recordPath << std::endl;
+        }
+    }
+
+    loop.printTimings(std::cout);
+    if (Profiler::isCompiledIn()) {
+        Profiler::getInstance().writeChromeTrace("frame_trace.json");
+    }
+    if (AllocationTracker::isEnabled()) {
+        AllocationTracker::dump(std::cout);
+    }
+    JobSystem::getInstance().shutdown();
     return 0;
 }
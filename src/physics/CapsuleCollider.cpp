@@ -1,5 +1,6 @@
 #include "CapsuleCollider.hpp"
 #include "../components/Transform.hpp"
+#include "../scene/Entity.hpp"
 #include <glm/gtx/closest_point.hpp>
 
 CapsuleCollider::CapsuleCollider()
@@ -133,14 +134,36 @@ bool CapsuleCollider::capsuleBox(const BoxCollider* box, glm::vec3& contactPoint
     glm::vec3 dist = closest - start;
     float distLen = glm::length(dist);
 
-    if (distLen < radius) {
-        depth = radius - distLen;
-        normal = distLen > 0.0001f ? dist / distLen : glm::vec3(0, 1, 0);
-        contactPoint = start + normal * radius;
-        return true;
+    if (distLen > 0.0001f) {
+        if (distLen < radius) {
+            depth = radius - distLen;
+            normal = dist / distLen;
+            contactPoint = start + normal * radius;
+            return true;
+        }
+        return false;
     }
 
-    return false;
+    // The segment end sank into the box: leave through the nearest face
+    glm::vec3 toMin = start - (boxPos - boxSize * 0.5f);
+    glm::vec3 toMax = (boxPos + boxSize * 0.5f) - start;
+    float nearest = toMax.y;
+    normal = glm::vec3(0, -1, 0);
+    for (int axis = 0; axis < 3; ++axis) {
+        if (toMin[axis] < nearest) {
+            nearest = toMin[axis];
+            normal = glm::vec3(0.0f);
+            normal[axis] = 1.0f;
+        }
+        if (toMax[axis] < nearest) {
+            nearest = toMax[axis];
+            normal = glm::vec3(0.0f);
+            normal[axis] = -1.0f;
+        }
+    }
+    depth = nearest + radius;
+    contactPoint = start - normal * nearest;
+    return true;
 }
 
 void CapsuleCollider::calculateBounds(glm::vec3& min, glm::vec3& max) const {
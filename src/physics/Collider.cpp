@@ -1,14 +1,46 @@
 #include "Collider.hpp"
+#include "CapsuleCollider.hpp"
+#include "PhysicsSystem.hpp"
 #include "../components/Transform.hpp"
+#include "../scene/Entity.hpp"
 
 Collider::Collider(Type type)
     : type(type)
     , trigger(false)
     , restitution(0.6f)
     , friction(0.5f)
-{}
+    , registryIndex(PhysicsSystem::NOT_REGISTERED)
+{
+    PhysicsSystem::getInstance().addCollider(this);
+}
+
+// Same relocation rule as RigidBody: a copy registers anew, a move takes
+// over the moved-from collider's slot
+Collider::Collider(const Collider& other)
+    : Component(other)
+    , type(other.type)
+    , trigger(other.trigger)
+    , restitution(other.restitution)
+    , friction(other.friction)
+    , registryIndex(PhysicsSystem::NOT_REGISTERED)
+{
+    PhysicsSystem::getInstance().addCollider(this);
+}
+
+Collider::Collider(Collider&& other) noexcept
+    : Component(other)
+    , type(other.type)
+    , trigger(other.trigger)
+    , restitution(other.restitution)
+    , friction(other.friction)
+    , registryIndex(PhysicsSystem::NOT_REGISTERED)
+{
+    PhysicsSystem::getInstance().relocateCollider(&other, this);
+}
 
-Collider::~Collider() {}
+Collider::~Collider() {
+    PhysicsSystem::getInstance().removeCollider(this);
+}
 
 // BoxCollider implementation
 BoxCollider::BoxCollider()
@@ -65,6 +97,13 @@ bool BoxCollider::checkCollision(const Collider* other, glm::vec3& contactPoint,
         // Box-Sphere collision
         // TODO: Implement Box-Sphere collision
     }
+    else if (auto capsule = dynamic_cast<const CapsuleCollider*>(other)) {
+        // Box-Capsule collision, from the capsule's side with the normal flipped
+        if (capsule->checkCollision(this, contactPoint, normal, depth)) {
+            normal = -normal;
+            return true;
+        }
+    }
 
     return false;
 }
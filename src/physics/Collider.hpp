@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <glm/glm.hpp>
 #include "../components/Component.hpp"
 
@@ -10,9 +11,16 @@ public:
         Capsule
     };
 
+    // Colliders register with the PhysicsSystem for collision and raycasts.
+    // A moved-to collider takes over the moved-from one's registry slot.
     Collider(Type type);
+    Collider(const Collider& other);
+    Collider(Collider&& other) noexcept;
+    Collider& operator=(const Collider&) = delete;
     virtual ~Collider();
 
+    Type getType() const { return type; }
+
     // Collision properties
     void setTrigger(bool isTrigger) { trigger = isTrigger; }
     bool isTrigger() const { return trigger; }
@@ -21,6 +29,8 @@ public:
         this->restitution = restitution;
         this->friction = friction;
     }
+    float getRestitution() const { return restitution; }
+    float getFriction() const { return friction; }
 
     // Collision checking
     virtual bool checkCollision(const Collider* other, glm::vec3& contactPoint, glm::vec3& normal, float& depth) const = 0;
@@ -33,6 +43,11 @@ protected:
     bool trigger;
     float restitution;
     float friction;
+
+private:
+    uint32_t registryIndex;  // Slot in PhysicsSystem's collider list
+
+    friend class PhysicsSystem;
 };
 
 class BoxCollider : public Collider {
@@ -1,7 +1,113 @@
 #include "PhysicsSystem.hpp"
 #include "RigidBody.hpp"
 #include "Collider.hpp"
+#include "CapsuleCollider.hpp"
+#include "../components/Transform.hpp"
+#include "../scene/Scene.hpp"
+#include "../core/AllocationTracker.hpp"
+#include "../core/Allocators.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Profiler.hpp"
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace {
+    // Prefab prototypes own colliders too, but belong to no scene
+    bool isSimulated(const Collider* collider) {
+        return collider && collider->getEntity() && collider->getEntity()->getScene();
+    }
+
+    // Ray tests for raycast(). `direction` is normalised; each test only
+    // accepts an entry point closer than `distance` and then narrows it.
+    // Rays starting inside a shape do not hit it, so a shooter's own
+    // collider never blocks its shots.
+    bool raySphere(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& center, float radius,
+                   float& distance, glm::vec3& normal) {
+        glm::vec3 oc = origin - center;
+        float b = glm::dot(oc, direction);
+        float c = glm::dot(oc, oc) - radius * radius;
+        float discriminant = b * b - c;
+        if (discriminant <= 0.0f) return false;
+
+        float t = -b - std::sqrt(discriminant);
+        if (t <= 0.0f || t >= distance) return false;
+
+        distance = t;
+        normal = glm::normalize(origin + direction * t - center);
+        return true;
+    }
+
+    // Side of the cylinder between `start` and `end`, then both end caps;
+    // the nearest of the three is where the ray enters the capsule
+    bool rayCapsule(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& start,
+                    const glm::vec3& end, float radius, float& distance, glm::vec3& normal) {
+        bool found = false;
+        glm::vec3 axis = end - start;
+        float axisLengthSq = glm::dot(axis, axis);
+        if (axisLengthSq > 1e-8f) {
+            // Distance to the axis line, with the axis component projected out
+            glm::vec3 offset = origin - start;
+            float directionAlong = glm::dot(direction, axis);
+            float offsetAlong = glm::dot(offset, axis);
+            float a = axisLengthSq - directionAlong * directionAlong;
+            float b = axisLengthSq * glm::dot(offset, direction) - offsetAlong * directionAlong;
+            float c = axisLengthSq * (glm::dot(offset, offset) - radius * radius) - offsetAlong * offsetAlong;
+            float discriminant = b * b - a * c;
+            if (a > 1e-8f && discriminant > 0.0f) {
+                float t = (-b - std::sqrt(discriminant)) / a;
+                float along = offsetAlong + t * directionAlong;
+                if (t > 0.0f && t < distance && along >= 0.0f && along <= axisLengthSq) {
+                    glm::vec3 point = origin + direction * t;
+                    distance = t;
+                    normal = glm::normalize(point - (start + axis * (along / axisLengthSq)));
+                    found = true;
+                }
+            }
+        }
+
+        found |= raySphere(origin, direction, start, radius, distance, normal);
+        found |= raySphere(origin, direction, end, radius, distance, normal);
+        return found;
+    }
+
+    // Slab test against an axis-aligned box, matching BoxCollider's bounds
+    bool rayBox(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& min, const glm::vec3& max,
+                float& distance, glm::vec3& normal) {
+        float entry = -std::numeric_limits<float>::max();
+        float exit = distance;
+        int entryAxis = -1;
+        float entrySign = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (std::abs(direction[axis]) < 1e-8f) {
+                if (origin[axis] < min[axis] || origin[axis] > max[axis]) return false;
+                continue;
+            }
+
+            float near = (min[axis] - origin[axis]) / direction[axis];
+            float far = (max[axis] - origin[axis]) / direction[axis];
+            float sign = -1.0f;
+            if (near > far) {
+                std::swap(near, far);
+                sign = 1.0f;
+            }
+            if (near > entry) {
+                entry = near;
+                entryAxis = axis;
+                entrySign = sign;
+            }
+            exit = std::min(exit, far);
+            if (entry > exit) return false;
+        }
+        if (entryAxis < 0 || entry <= 0.0f || entry >= distance) return false;
+
+        distance = entry;
+        normal = glm::vec3(0.0f);
+        normal[entryAxis] = entrySign;
+        return true;
+    }
+}
 
 struct CollisionPair {
     Collider* colliderA;
@@ -17,80 +123,147 @@ void PhysicsSystem::initialize() {
 }
 
 void PhysicsSystem::update(float deltaTime) {
-    // Update rigidbodies
-    updateRigidbodies(deltaTime);
-
-    // Handle collisions
+    MEMORY_TAG(Physics);
     detectCollisions();
     resolveCollisions();
 }
 
-void PhysicsSystem::addRigidBody(RigidBody* body) {
-    if (body && std::find(rigidBodies.begin(), rigidBodies.end(), body) == rigidBodies.end()) {
-        rigidBodies.push_back(body);
+void PhysicsSystem::integrate(Scene& scene, float deltaTime) {
+    MEMORY_TAG(Physics);
+    scene.view<RigidBody, Transform>().each([this, deltaTime](Entity*, RigidBody& body, Transform& transform) {
+        body.integrate(transform, gravity, deltaTime);
+    });
+}
+
+// The registries store each object's slot in the object itself
+template<typename T>
+void PhysicsSystem::registerObject(std::vector<T*>& registry, T* object) {
+    if (!object || object->registryIndex != NOT_REGISTERED) return;
+    object->registryIndex = static_cast<uint32_t>(registry.size());
+    registry.push_back(object);
+}
+
+template<typename T>
+void PhysicsSystem::unregisterObject(std::vector<T*>& registry, T* object) {
+    if (!object || object->registryIndex == NOT_REGISTERED) return;
+    T* last = registry.back();
+    registry[object->registryIndex] = last;
+    last->registryIndex = object->registryIndex;
+    registry.pop_back();
+    object->registryIndex = NOT_REGISTERED;
+}
+
+template<typename T>
+void PhysicsSystem::relocateObject(std::vector<T*>& registry, T* from, T* to) {
+    if (from->registryIndex == NOT_REGISTERED) {
+        registerObject(registry, to);
+        return;
     }
+    to->registryIndex = from->registryIndex;
+    registry[to->registryIndex] = to;
+    from->registryIndex = NOT_REGISTERED;
+}
+
+void PhysicsSystem::addRigidBody(RigidBody* body) {
+    MEMORY_TAG(Physics);
+    registerObject(rigidBodies, body);
 }
 
 void PhysicsSystem::removeRigidBody(RigidBody* body) {
-    auto it = std::find(rigidBodies.begin(), rigidBodies.end(), body);
-    if (it != rigidBodies.end()) {
-        rigidBodies.erase(it);
-    }
+    unregisterObject(rigidBodies, body);
+}
+
+void PhysicsSystem::relocateRigidBody(RigidBody* from, RigidBody* to) {
+    MEMORY_TAG(Physics);
+    relocateObject(rigidBodies, from, to);
 }
 
 void PhysicsSystem::addCollider(Collider* collider) {
-    if (collider && std::find(colliders.begin(), colliders.end(), collider) == colliders.end()) {
-        colliders.push_back(collider);
-    }
+    MEMORY_TAG(Physics);
+    registerObject(colliders, collider);
 }
 
 void PhysicsSystem::removeCollider(Collider* collider) {
-    auto it = std::find(colliders.begin(), colliders.end(), collider);
-    if (it != colliders.end()) {
-        colliders.erase(it);
-    }
+    unregisterObject(colliders, collider);
 }
 
-void PhysicsSystem::updateRigidbodies(float deltaTime) {
-    for (auto body : rigidBodies) {
-        if (body && !body->isKinematic()) {
-            body->update(deltaTime);
-        }
-    }
+void PhysicsSystem::relocateCollider(Collider* from, Collider* to) {
+    MEMORY_TAG(Physics);
+    relocateObject(colliders, from, to);
 }
 
 void PhysicsSystem::detectCollisions() {
-    std::vector<CollisionPair> collisions;
+    PROFILE_SCOPE("PhysicsSystem::detectCollisions");
+    JobSystem& jobs = JobSystem::getInstance();
+    const size_t colliderCount = colliders.size();
+
+    // Bounds are computed once per collider rather than once per pair. All
+    // per-frame containers here live in the frame arena.
+    FrameVector<glm::vec3> boundsMin(colliderCount), boundsMax(colliderCount);
+    jobs.parallelFor(0, colliderCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (isSimulated(colliders[i])) {
+                colliders[i]->calculateBounds(boundsMin[i], boundsMax[i]);
+            } else {
+                // Inverted bounds overlap nothing, so the pair loop skips it
+                boundsMin[i] = glm::vec3(std::numeric_limits<float>::max());
+                boundsMax[i] = glm::vec3(-std::numeric_limits<float>::max());
+            }
+        }
+    });
 
-    // Broad phase - simple O(n²) for now, could be optimized with spatial partitioning
-    for (size_t i = 0; i < colliders.size(); ++i) {
-        for (size_t j = i + 1; j < colliders.size(); ++j) {
-            Collider* colliderA = colliders[i];
-            Collider* colliderB = colliders[j];
+    // Broad phase - simple O(n²) for now, could be optimized with spatial partitioning.
+    // Rows are split across workers; each range collects its own pairs, which are
+    // stitched back together in row order so resolution stays deterministic.
+    std::mutex rangeMutex;
+    FrameVector<std::pair<size_t, FrameVector<CollisionPair>>> rangeResults;
 
-            // Skip if either collider is null
-            if (!colliderA || !colliderB) continue;
+    jobs.parallelFor(0, colliderCount, [&](size_t begin, size_t end) {
+        FrameVector<CollisionPair> found;
+        for (size_t i = begin; i < end; ++i) {
+            Collider* colliderA = colliders[i];
+            if (!colliderA) continue;
+
+            const glm::vec3& minA = boundsMin[i];
+            const glm::vec3& maxA = boundsMax[i];
+            for (size_t j = i + 1; j < colliderCount; ++j) {
+                Collider* colliderB = colliders[j];
+
+                // Skip if either collider is null
+                if (!colliderB) continue;
+
+                // Check bounding boxes first
+                const glm::vec3& minB = boundsMin[j];
+                const glm::vec3& maxB = boundsMax[j];
+                if (maxA.x < minB.x || minA.x > maxB.x ||
+                    maxA.y < minB.y || minA.y > maxB.y ||
+                    maxA.z < minB.z || minA.z > maxB.z) {
+                    continue; // No collision possible
+                }
 
-            // Check bounding boxes first
-            glm::vec3 minA, maxA, minB, maxB;
-            colliderA->calculateBounds(minA, maxA);
-            colliderB->calculateBounds(minB, maxB);
+                // Narrow phase - detailed collision check
+                CollisionPair pair;
+                pair.colliderA = colliderA;
+                pair.colliderB = colliderB;
 
-            if (maxA.x < minB.x || minA.x > maxB.x ||
-                maxA.y < minB.y || minA.y > maxB.y ||
-                maxA.z < minB.z || minA.z > maxB.z) {
-                continue; // No collision possible
+                if (colliderA->checkCollision(colliderB, pair.contactPoint, pair.normal, pair.depth)) {
+                    found.push_back(pair);
+                }
             }
+        }
 
-            // Narrow phase - detailed collision check
-            CollisionPair pair;
-            pair.colliderA = colliderA;
-            pair.colliderB = colliderB;
-
-            if (colliderA->checkCollision(colliderB, pair.contactPoint, pair.normal, pair.depth)) {
-                collisions.push_back(pair);
-            }
+        if (!found.empty()) {
+            std::lock_guard<std::mutex> lock(rangeMutex);
+            rangeResults.emplace_back(begin, std::move(found));
         }
+    });
+
+    std::sort(rangeResults.begin(), rangeResults.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    FrameVector<CollisionPair> collisions;
+    for (auto& range : rangeResults) {
+        collisions.insert(collisions.end(), range.second.begin(), range.second.end());
     }
 
     // Resolve collisions
@@ -103,10 +276,10 @@ void PhysicsSystem::detectCollisions() {
 
         // Handle collision response
         if (rbA || rbB) {
-            // Calculate relative velocity
+            // Velocity of B relative to A; the normal points from A to B
             glm::vec3 relativeVel = glm::vec3(0.0f);
-            if (rbA) relativeVel += rbA->getVelocity();
-            if (rbB) relativeVel -= rbB->getVelocity();
+            if (rbB) relativeVel += rbB->getVelocity();
+            if (rbA) relativeVel -= rbA->getVelocity();
 
             float restitution = std::min(collision.colliderA->getRestitution(),
                                        collision.colliderB->getRestitution());
@@ -155,40 +328,49 @@ void PhysicsSystem::resolveCollisions() {
     // Additional collision response and constraint solving could be added here
 }
 
-bool PhysicsSystem::raycast(const glm::vec3& origin, const glm::vec3& direction, RaycastHit& hit, float maxDistance) {
-    // Simple raycast implementation
+bool PhysicsSystem::raycast(const Scene& scene, const glm::vec3& origin, const glm::vec3& direction,
+                            RaycastHit& hit, float maxDistance) {
     glm::vec3 normalizedDir = glm::normalize(direction);
-    float closestHit = maxDistance;
     bool foundHit = false;
 
-    for (auto collider : colliders) {
-        if (!collider) continue;
-
-        // Simple sphere test for now
-        if (auto sphere = dynamic_cast<SphereCollider*>(collider)) {
-            auto transform = collider->getEntity()->getComponent<Transform>();
-            glm::vec3 center = transform->getPosition();
-            float radius = sphere->getRadius();
-
-            glm::vec3 oc = origin - center;
-            float a = glm::dot(normalizedDir, normalizedDir);
-            float b = 2.0f * glm::dot(oc, normalizedDir);
-            float c = glm::dot(oc, oc) - radius * radius;
-            float discriminant = b * b - 4 * a * c;
-
-            if (discriminant > 0) {
-                float t = (-b - sqrt(discriminant)) / (2.0f * a);
-                if (t > 0 && t < closestHit) {
-                    closestHit = t;
-                    hit.collider = collider;
-                    hit.point = origin + normalizedDir * t;
-                    hit.normal = glm::normalize(hit.point - center);
-                    hit.distance = t;
-                    foundHit = true;
+    // The tree clips the ray to each hit, so later candidates must be closer
+    scene.getSpatialIndex().raycast(SpatialIndex::Layer::Colliders, origin, normalizedDir, maxDistance,
+        [&](Entity* entity, float closestHit) {
+            auto transform = entity->getComponent<Transform>();
+            if (!transform) return closestHit;
+
+            // Nearest of the entity's colliders
+            glm::vec3 position = transform->getPosition();
+            float distance = closestHit;
+            glm::vec3 normal(0.0f);
+            Collider* collider = nullptr;
+            if (auto sphere = entity->getComponent<SphereCollider>()) {
+                if (raySphere(origin, normalizedDir, position, sphere->getRadius(), distance, normal)) {
+                    collider = sphere;
                 }
             }
-        }
-    }
+            if (auto capsule = entity->getComponent<CapsuleCollider>()) {
+                glm::vec3 start, end;
+                capsule->getSegment(start, end);
+                if (rayCapsule(origin, normalizedDir, start, end, capsule->getRadius(), distance, normal)) {
+                    collider = capsule;
+                }
+            }
+            if (auto box = entity->getComponent<BoxCollider>()) {
+                glm::vec3 halfSize = box->getSize() * 0.5f;
+                if (rayBox(origin, normalizedDir, position - halfSize, position + halfSize, distance, normal)) {
+                    collider = box;
+                }
+            }
+            if (!collider) return closestHit;
+
+            hit.collider = collider;
+            hit.point = origin + normalizedDir * distance;
+            hit.normal = normal;
+            hit.distance = distance;
+            foundHit = true;
+            return distance;
+        });
 
     return foundHit;
 }
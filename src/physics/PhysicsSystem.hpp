@@ -1,10 +1,12 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 
 class RigidBody;
 class Collider;
+class Scene;
 
 class PhysicsSystem {
 public:
@@ -14,18 +16,33 @@ public:
     }
 
     void initialize();
+
+    // Collision detection and response between registered colliders
     void update(float deltaTime);
 
+    // Steps every RigidBody that has a Transform in the scene. Scene::update
+    // runs this as its "Physics" system.
+    void integrate(Scene& scene, float deltaTime);
+
     // Configuration
     void setGravity(const glm::vec3& gravity) { this->gravity = gravity; }
+    const glm::vec3& getGravity() const { return gravity; }
     void setIterations(int iterations) { this->solverIterations = iterations; }
 
-    // Object management
+    // Object management. Each object keeps its slot in the registry, so
+    // every call is O(1); removal swaps the last entry into the hole. Adding
+    // a registered object or removing an unregistered one does nothing.
+    static constexpr uint32_t NOT_REGISTERED = UINT32_MAX;
     void addRigidBody(RigidBody* body);
     void removeRigidBody(RigidBody* body);
     void addCollider(Collider* collider);
     void removeCollider(Collider* collider);
 
+    // For relocation by move: `to` takes over `from`'s slot and `from` is
+    // left unregistered
+    void relocateRigidBody(RigidBody* from, RigidBody* to);
+    void relocateCollider(Collider* from, Collider* to);
+
     // Raycasting
     struct RaycastHit {
         Collider* collider;
@@ -34,7 +51,10 @@ public:
         float distance;
     };
 
-    bool raycast(const glm::vec3& origin, const glm::vec3& direction, RaycastHit& hit, float maxDistance = 1000.0f);
+    // Closest hit among the scene's colliders. Candidates come from the
+    // scene's spatial index, so only colliders near the ray are tested.
+    bool raycast(const Scene& scene, const glm::vec3& origin, const glm::vec3& direction, RaycastHit& hit,
+                 float maxDistance = 1000.0f);
 
 private:
     PhysicsSystem() = default;
@@ -45,10 +65,14 @@ private:
     std::vector<RigidBody*> rigidBodies;
     std::vector<Collider*> colliders;
 
-    glm::vec3 gravity;
-    int solverIterations;
+    // Scenes integrate before initialize() may have been called
+    glm::vec3 gravity = glm::vec3(0.0f, -9.81f, 0.0f);
+    int solverIterations = 4;
 
-    void updateRigidbodies(float deltaTime);
     void detectCollisions();
     void resolveCollisions();
+
+    template<typename T> static void registerObject(std::vector<T*>& registry, T* object);
+    template<typename T> static void unregisterObject(std::vector<T*>& registry, T* object);
+    template<typename T> static void relocateObject(std::vector<T*>& registry, T* from, T* to);
 };
@@ -13,24 +13,59 @@ RigidBody::RigidBody()
     , angularVelocity(0.0f)
     , forces(0.0f)
     , torques(0.0f)
+    , registryIndex(PhysicsSystem::NOT_REGISTERED)
 {
     PhysicsSystem::getInstance().addRigidBody(this);
 }
 
+// Prefabs clone components by copy, which registers the new body.
+// Archetype storage relocates them by move, which hands the registry slot
+// over in O(1) and leaves nothing for the moved-from body to unregister.
+RigidBody::RigidBody(const RigidBody& other)
+    : Component(other)
+    , mass(other.mass)
+    , drag(other.drag)
+    , angularDrag(other.angularDrag)
+    , useGravity(other.useGravity)
+    , kinematic(other.kinematic)
+    , freezeRotation(other.freezeRotation)
+    , velocity(other.velocity)
+    , angularVelocity(other.angularVelocity)
+    , forces(other.forces)
+    , torques(other.torques)
+    , registryIndex(PhysicsSystem::NOT_REGISTERED)
+{
+    PhysicsSystem::getInstance().addRigidBody(this);
+}
+
+RigidBody::RigidBody(RigidBody&& other) noexcept
+    : Component(other)
+    , mass(other.mass)
+    , drag(other.drag)
+    , angularDrag(other.angularDrag)
+    , useGravity(other.useGravity)
+    , kinematic(other.kinematic)
+    , freezeRotation(other.freezeRotation)
+    , velocity(other.velocity)
+    , angularVelocity(other.angularVelocity)
+    , forces(other.forces)
+    , torques(other.torques)
+    , registryIndex(PhysicsSystem::NOT_REGISTERED)
+{
+    PhysicsSystem::getInstance().relocateRigidBody(&other, this);
+}
+
 RigidBody::~RigidBody() {
     PhysicsSystem::getInstance().removeRigidBody(this);
 }
 
-void RigidBody::update(float deltaTime) {
+void RigidBody::integrate(Transform& transform, const glm::vec3& gravity, float deltaTime) {
     if (kinematic) return;
 
-    auto transform = getEntity()->getComponent<Transform>();
-    if (!transform) return;
-
     // Apply forces
     glm::vec3 acceleration = forces / mass;
     if (useGravity) {
-        acceleration += PhysicsSystem::getInstance().getGravity();
+        acceleration += gravity;
     }
 
     // Update linear velocity
@@ -38,7 +73,7 @@ void RigidBody::update(float deltaTime) {
     velocity *= (1.0f - drag);
 
     // Update position
-    transform->setPosition(transform->getPosition() + velocity * deltaTime);
+    transform.setPosition(transform.getPosition() + velocity * deltaTime);
 
     // Handle rotation if not frozen
     if (!freezeRotation) {
@@ -46,10 +81,12 @@ void RigidBody::update(float deltaTime) {
         angularVelocity += torques * deltaTime;
         angularVelocity *= (1.0f - angularDrag);
 
-        // Update rotation
-        glm::quat rotation = transform->getRotation();
-        glm::quat deltaRotation = glm::quat(0.0f, angularVelocity * deltaTime);
-        transform->setRotation(rotation * deltaRotation);
+        // Update rotation. A resting body keeps the rotation other components set.
+        float speed = glm::length(angularVelocity);
+        if (speed > 0.0f) {
+            glm::quat deltaRotation = glm::angleAxis(speed * deltaTime, angularVelocity / speed);
+            transform.setRotation(glm::normalize(transform.getRotation() * deltaRotation));
+        }
     }
 
     // Clear forces and torques
@@ -1,13 +1,20 @@
 #pragma once
+#include <cstdint>
 #include <glm/glm.hpp>
 #include "../components/Component.hpp"
 
+class Transform;
+
 class RigidBody : public Component {
 public:
     RigidBody();
+    RigidBody(const RigidBody& other);
+    RigidBody(RigidBody&& other) noexcept;
+    RigidBody& operator=(const RigidBody&) = delete;
     ~RigidBody();
 
-    void update(float deltaTime) override;
+    // One integration step, driven by PhysicsSystem::integrate
+    void integrate(Transform& transform, const glm::vec3& gravity, float deltaTime);
 
     // Properties
     void setMass(float mass);
@@ -25,7 +32,7 @@ public:
 
     // Getters
     float getMass() const { return mass; }
-    bool isKinematic() const { return isKinematic; }
+    bool isKinematic() const { return kinematic; }
     const glm::vec3& getVelocity() const { return velocity; }
     const glm::vec3& getAngularVelocity() const { return angularVelocity; }
 
@@ -46,5 +53,7 @@ private:
     glm::vec3 forces;
     glm::vec3 torques;
 
+    uint32_t registryIndex;  // Slot in PhysicsSystem's rigid body list
+
     friend class PhysicsSystem;
 };
@@ -0,0 +1,38 @@
+#include "LightBuffer.hpp"
+#include <cassert>
+#include <cmath>
+
+void LightBuffer::clear() {
+    header = LightBufferHeader();
+    lights.clear();
+}
+
+void LightBuffer::add(const Light& light, const glm::vec3& position, const glm::vec3& direction) {
+    GpuLight packed;
+    float range = light.getRange();
+    packed.positionRange = glm::vec4(position, range);
+    packed.colorIntensity = glm::vec4(light.getColor(), light.getIntensity());
+    packed.directionCutOff = glm::vec4(direction, 0.0f);
+    packed.attenuation = glm::vec4(0.0f);
+
+    switch (light.getType()) {
+        case Light::Type::Directional:
+            assert(header.pointCount == 0 && header.spotCount == 0 && "Lights must be added grouped by type");
+            header.directionalCount++;
+            break;
+        case Light::Type::Point:
+            assert(header.spotCount == 0 && "Lights must be added grouped by type");
+            packed.attenuation = glm::vec4(1.0f, 2.0f / range, 1.0f / (range * range), 0.0f);
+            header.pointCount++;
+            break;
+        case Light::Type::Spot: {
+            // A 5 degree falloff band outside the cone
+            float angle = light.getSpotAngle();
+            packed.directionCutOff.w = std::cos(glm::radians(angle));
+            packed.attenuation.w = std::cos(glm::radians(angle + 5.0f));
+            header.spotCount++;
+            break;
+        }
+    }
+    lights.push_back(packed);
+}
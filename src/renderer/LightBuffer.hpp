@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../components/Light.hpp"
+
+// One light as lit.frag reads it. Members are all vec4, so the layout is the
+// same under std140 and std430 and matches the GLSL struct byte for byte.
+struct GpuLight {
+    glm::vec4 positionRange;    // xyz world position, w range
+    glm::vec4 directionCutOff;  // xyz world direction, w cos(inner cone)
+    glm::vec4 colorIntensity;   // rgb color, a intensity
+    glm::vec4 attenuation;      // constant, linear, quadratic, cos(outer cone)
+};
+static_assert(sizeof(GpuLight) == 64, "GpuLight must match the std430 struct in lit.frag");
+
+struct LightBufferHeader {
+    uint32_t directionalCount = 0;
+    uint32_t pointCount = 0;
+    uint32_t spotCount = 0;
+    uint32_t padding = 0;
+};
+static_assert(sizeof(LightBufferHeader) == 16, "LightBufferHeader must match the uvec4 in lit.frag");
+
+// A frame's lights packed for the shader storage buffer at BINDING: the
+// header, then every light in one array ordered directional, point, spot.
+// Shaders find each type's range from the counts. GL-free; LightManager
+// does the upload.
+class LightBuffer {
+public:
+    static constexpr uint32_t BINDING = 0;
+
+    void clear();
+    void reserve(size_t count) { lights.reserve(count); }
+
+    // Lights must arrive grouped by type, in Light::Type order
+    void add(const Light& light, const glm::vec3& position, const glm::vec3& direction);
+
+    const LightBufferHeader& getHeader() const { return header; }
+    const std::vector<GpuLight>& getLights() const { return lights; }
+
+    // Bytes the upload covers: header plus lights
+    size_t getByteSize() const { return sizeof(LightBufferHeader) + lights.size() * sizeof(GpuLight); }
+
+private:
+    LightBufferHeader header;
+    std::vector<GpuLight> lights;
+};
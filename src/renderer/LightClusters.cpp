@@ -0,0 +1,344 @@
+#include "LightClusters.hpp"
+#include "LightBuffer.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Profiler.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define LIGHT_CLUSTERS_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHT_CLUSTERS_SSE2 1
+#endif
+
+namespace {
+    // Slices are padded to a multiple of the widest register so the layout
+    // does not depend on the build
+    const uint32_t BLOCK = 8;
+
+    // The handful of operations the tests need, one cluster per lane
+#if defined(LIGHT_CLUSTERS_AVX)
+    const uint32_t WIDTH = 8;
+    using Lanes = __m256;
+    using Mask = __m256;
+    inline Lanes load(const float* values) { return _mm256_loadu_ps(values); }
+    inline Lanes splat(float value) { return _mm256_set1_ps(value); }
+    inline Lanes add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+    inline Lanes sub(Lanes a, Lanes b) { return _mm256_sub_ps(a, b); }
+    inline Lanes mul(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+    inline Lanes maximum(Lanes a, Lanes b) { return _mm256_max_ps(a, b); }
+    inline Lanes squareRoot(Lanes a) { return _mm256_sqrt_ps(a); }
+    inline Mask lessEqual(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    inline Mask greater(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    inline Mask either(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+    inline Mask andNot(Mask a, Mask b) { return _mm256_andnot_ps(b, a); }
+    inline uint32_t bits(Mask mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+#elif defined(LIGHT_CLUSTERS_SSE2)
+    const uint32_t WIDTH = 4;
+    using Lanes = __m128;
+    using Mask = __m128;
+    inline Lanes load(const float* values) { return _mm_loadu_ps(values); }
+    inline Lanes splat(float value) { return _mm_set1_ps(value); }
+    inline Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+    inline Lanes sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+    inline Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+    inline Lanes maximum(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+    inline Lanes squareRoot(Lanes a) { return _mm_sqrt_ps(a); }
+    inline Mask lessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a, b); }
+    inline Mask greater(Lanes a, Lanes b) { return _mm_cmpgt_ps(a, b); }
+    inline Mask either(Mask a, Mask b) { return _mm_or_ps(a, b); }
+    inline Mask andNot(Mask a, Mask b) { return _mm_andnot_ps(b, a); }
+    inline uint32_t bits(Mask mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+#else
+    const uint32_t WIDTH = 1;
+    using Lanes = float;
+    using Mask = bool;
+    inline Lanes load(const float* values) { return *values; }
+    inline Lanes splat(float value) { return value; }
+    inline Lanes add(Lanes a, Lanes b) { return a + b; }
+    inline Lanes sub(Lanes a, Lanes b) { return a - b; }
+    inline Lanes mul(Lanes a, Lanes b) { return a * b; }
+    inline Lanes maximum(Lanes a, Lanes b) { return std::max(a, b); }
+    inline Lanes squareRoot(Lanes a) { return std::sqrt(a); }
+    inline Mask lessEqual(Lanes a, Lanes b) { return a <= b; }
+    inline Mask greater(Lanes a, Lanes b) { return a > b; }
+    inline Mask either(Mask a, Mask b) { return a || b; }
+    inline Mask andNot(Mask a, Mask b) { return a && !b; }
+    inline uint32_t bits(Mask mask) { return mask ? 1u : 0u; }
+#endif
+    static_assert(BLOCK % WIDTH == 0, "Slice padding must hold whole registers");
+
+    // Where the line from `nearPoint` to `farPoint` crosses view depth `depth`
+    glm::vec3 atDepth(const glm::vec3& nearPoint, const glm::vec3& farPoint, float depth) {
+        float t = (-depth - nearPoint.z) / (farPoint.z - nearPoint.z);
+        glm::vec3 point = nearPoint + (farPoint - nearPoint) * t;
+        point.z = -depth;  // Exact, so neighbouring slices share their boundary
+        return point;
+    }
+
+    glm::vec3 unproject(const glm::mat4& inverseProjection, float x, float y, float z) {
+        glm::vec4 point = inverseProjection * glm::vec4(x, y, z, 1.0f);
+        return glm::vec3(point) / point.w;
+    }
+}
+
+LightClusters::LightClusters(uint32_t tilesX, uint32_t tilesY, uint32_t slices)
+    : builtProjection(1.0f), boundsValid(false) {
+    assert(tilesX > 0 && tilesY > 0 && slices > 0);
+    header.tilesX = tilesX;
+    header.tilesY = tilesY;
+    header.slices = slices;
+    clustersPerSlice = tilesX * tilesY;
+    sliceStride = (clustersPerSlice + BLOCK - 1) / BLOCK * BLOCK;
+
+    const size_t padded = static_cast<size_t>(sliceStride) * slices;
+    for (std::vector<float>* values : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ,
+                                        &sphereX, &sphereY, &sphereZ, &sphereRadius }) {
+        values->assign(padded, 0.0f);
+    }
+    sliceWork.resize(slices);
+    ranges.assign(static_cast<size_t>(clustersPerSlice) * slices, ClusterRange{ 0, 0 });
+}
+
+AABB LightClusters::getClusterBounds(uint32_t cluster) const {
+    uint32_t slice = cluster / clustersPerSlice;
+    size_t i = static_cast<size_t>(slice) * sliceStride + cluster % clustersPerSlice;
+    return AABB(glm::vec3(minX[i], minY[i], minZ[i]), glm::vec3(maxX[i], maxY[i], maxZ[i]));
+}
+
+// Slice k starts at view depth near * (far / near)^(k / slices), which the
+// shader inverts as floor(log(depth) * depthScale + depthBias). Tile corners
+// are unprojected through the inverse projection, so perspective and
+// orthographic cameras both work.
+void LightClusters::buildClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane) {
+    PROFILE_SCOPE("LightClusters::buildClusterBounds");
+    const uint32_t slices = header.slices;
+    const float logRatio = std::log(farPlane / nearPlane);
+    header.depthScale = static_cast<float>(slices) / logRatio;
+    header.depthBias = -static_cast<float>(slices) * std::log(nearPlane) / logRatio;
+    header.nearPlane = nearPlane;
+    header.farPlane = farPlane;
+
+    sliceDepths.resize(slices + 1);
+    for (uint32_t k = 0; k <= slices; ++k) {
+        sliceDepths[k] = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(k) / slices);
+    }
+    sliceDepths[slices] = farPlane;
+
+    // Each tile corner's ray, as points on the near and far planes
+    const glm::mat4 inverseProjection = glm::inverse(projection);
+    const uint32_t cornersX = header.tilesX + 1;
+    const uint32_t cornersY = header.tilesY + 1;
+    std::vector<glm::vec3> nearCorners(cornersX * cornersY), farCorners(cornersX * cornersY);
+    for (uint32_t y = 0; y < cornersY; ++y) {
+        for (uint32_t x = 0; x < cornersX; ++x) {
+            float ndcX = -1.0f + 2.0f * x / header.tilesX;
+            float ndcY = -1.0f + 2.0f * y / header.tilesY;
+            nearCorners[x + y * cornersX] = unproject(inverseProjection, ndcX, ndcY, -1.0f);
+            farCorners[x + y * cornersX] = unproject(inverseProjection, ndcX, ndcY, 1.0f);
+        }
+    }
+
+    sliceBounds.resize(slices);
+    for (uint32_t z = 0; z < slices; ++z) {
+        size_t base = static_cast<size_t>(z) * sliceStride;
+        AABB& slab = sliceBounds[z];
+        slab = AABB(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+        for (uint32_t y = 0; y < header.tilesY; ++y) {
+            for (uint32_t x = 0; x < header.tilesX; ++x) {
+                glm::vec3 points[8];
+                int count = 0;
+                for (uint32_t corner = 0; corner < 4; ++corner) {
+                    uint32_t c = (x + (corner & 1)) + (y + (corner >> 1)) * cornersX;
+                    points[count++] = atDepth(nearCorners[c], farCorners[c], sliceDepths[z]);
+                    points[count++] = atDepth(nearCorners[c], farCorners[c], sliceDepths[z + 1]);
+                }
+
+                glm::vec3 low = points[0], high = points[0], center(0.0f);
+                for (const glm::vec3& point : points) {
+                    low = glm::min(low, point);
+                    high = glm::max(high, point);
+                    center += point;
+                }
+                center /= 8.0f;
+                slab.min = glm::min(slab.min, low);
+                slab.max = glm::max(slab.max, high);
+                float radius = 0.0f;
+                for (const glm::vec3& point : points) {
+                    radius = std::max(radius, glm::length(point - center));
+                }
+
+                size_t i = base + x + y * header.tilesX;
+                minX[i] = low.x;
+                minY[i] = low.y;
+                minZ[i] = low.z;
+                maxX[i] = high.x;
+                maxY[i] = high.y;
+                maxZ[i] = high.z;
+                sphereX[i] = center.x;
+                sphereY[i] = center.y;
+                sphereZ[i] = center.z;
+                sphereRadius[i] = radius;
+            }
+        }
+
+        // Padding lanes: inverted boxes are infinitely far from any sphere
+        for (size_t i = base + clustersPerSlice; i < base + sliceStride; ++i) {
+            minX[i] = minY[i] = minZ[i] = FLT_MAX;
+            maxX[i] = maxY[i] = maxZ[i] = -FLT_MAX;
+            sphereX[i] = sphereY[i] = sphereZ[i] = sphereRadius[i] = 0.0f;
+        }
+    }
+
+    builtProjection = projection;
+    boundsValid = true;
+}
+
+void LightClusters::build(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane,
+                          const LightBuffer& lights) {
+    PROFILE_SCOPE("LightClusters::build");
+    assert(nearPlane > 0.0f && farPlane > nearPlane && "Depth slicing needs 0 < near < far");
+    if (!boundsValid || projection != builtProjection || nearPlane != header.nearPlane || farPlane != header.farPlane) {
+        buildClusterBounds(projection, nearPlane, farPlane);
+    }
+
+    // Point and spot lights follow the directional ones in LightBuffer's array
+    const LightBufferHeader& counts = lights.getHeader();
+    const std::vector<GpuLight>& packed = lights.getLights();
+    const uint32_t first = counts.directionalCount;
+    const uint32_t spotStart = first + counts.pointCount;
+    const uint32_t end = spotStart + counts.spotCount;
+
+    viewLights.clear();
+    viewLights.reserve(end - first);
+    for (uint32_t i = first; i < end; ++i) {
+        const GpuLight& light = packed[i];
+        ViewLight viewLight;
+        viewLight.position = glm::vec3(view * glm::vec4(glm::vec3(light.positionRange), 1.0f));
+        viewLight.range = light.positionRange.w;
+        viewLight.index = i;
+
+        // Spots wider than a hemisphere fall back to the sphere test alone
+        float cosAngle = light.attenuation.w;
+        viewLight.cone = i >= spotStart && cosAngle > 0.0f;
+        viewLight.direction = glm::vec3(0.0f);
+        viewLight.cosAngle = 1.0f;
+        viewLight.sinAngle = 0.0f;
+        if (viewLight.cone) {
+            viewLight.direction = glm::normalize(glm::vec3(view * glm::vec4(glm::vec3(light.directionCutOff), 0.0f)));
+            viewLight.cosAngle = cosAngle;
+            viewLight.sinAngle = std::sqrt(std::max(0.0f, 1.0f - cosAngle * cosAngle));
+        }
+
+        // Padded slightly so rounding never drops a light the exact test keeps
+        viewLight.reach = viewLight.range * 1.001f + 1e-4f;
+        float depth = -viewLight.position.z;
+        if (depth + viewLight.reach < nearPlane || depth - viewLight.reach > farPlane) continue;
+        viewLights.push_back(viewLight);
+    }
+
+    JobSystem::getInstance().parallelFor(0, header.slices, [this](size_t begin, size_t end) {
+        for (size_t slice = begin; slice < end; ++slice) {
+            assignSlice(static_cast<uint32_t>(slice));
+        }
+    }, 1);
+
+    // Slices wrote offsets relative to their own lists; join them into one
+    size_t total = 0;
+    for (const SliceWork& work : sliceWork) total += work.indices.size();
+    lightIndices.resize(total);
+
+    stats = Stats();
+    stats.lights = end - first;
+    stats.assignments = static_cast<uint32_t>(total);
+    uint32_t offset = 0;
+    for (uint32_t slice = 0; slice < header.slices; ++slice) {
+        const std::vector<uint32_t>& indices = sliceWork[slice].indices;
+        std::copy(indices.begin(), indices.end(), lightIndices.begin() + offset);
+        ClusterRange* sliceRanges = &ranges[static_cast<size_t>(slice) * clustersPerSlice];
+        for (uint32_t c = 0; c < clustersPerSlice; ++c) {
+            sliceRanges[c].offset += offset;
+            stats.maxPerCluster = std::max(stats.maxPerCluster, sliceRanges[c].count);
+            if (sliceRanges[c].count == 0) stats.emptyClusters++;
+        }
+        offset += static_cast<uint32_t>(indices.size());
+    }
+}
+
+// One light against WIDTH clusters at a time. Every light must touch the
+// cluster's box (sphere-AABB, exact); spot lights must also not be culled
+// by the cone test against the cluster's bounding sphere, after Bart
+// Wronski's "Cull that cone" (conservative: it may keep a cluster the cone
+// just misses, never the reverse).
+void LightClusters::assignSlice(uint32_t slice) {
+    SliceWork& work = sliceWork[slice];
+    const AABB& bounds = sliceBounds[slice];
+
+    work.candidates.clear();
+    for (uint32_t i = 0; i < viewLights.size(); ++i) {
+        if (bounds.overlapsSphere(viewLights[i].position, viewLights[i].reach)) {
+            work.candidates.push_back(i);
+        }
+    }
+    work.masks.resize(work.candidates.size());
+    work.indices.clear();
+
+    ClusterRange* sliceRanges = &ranges[static_cast<size_t>(slice) * clustersPerSlice];
+    const size_t base = static_cast<size_t>(slice) * sliceStride;
+    const Lanes zero = splat(0.0f);
+
+    for (uint32_t block = 0; block < clustersPerSlice; block += WIDTH) {
+        const size_t i = base + block;
+        const Lanes boxMinX = load(&minX[i]), boxMinY = load(&minY[i]), boxMinZ = load(&minZ[i]);
+        const Lanes boxMaxX = load(&maxX[i]), boxMaxY = load(&maxY[i]), boxMaxZ = load(&maxZ[i]);
+        const Lanes centerX = load(&sphereX[i]), centerY = load(&sphereY[i]), centerZ = load(&sphereZ[i]);
+        const Lanes radius = load(&sphereRadius[i]);
+
+        uint32_t touched = 0;
+        for (size_t c = 0; c < work.candidates.size(); ++c) {
+            const ViewLight& light = viewLights[work.candidates[c]];
+            const Lanes px = splat(light.position.x), py = splat(light.position.y), pz = splat(light.position.z);
+            const Lanes range = splat(light.range);
+
+            // Distance from the light to the box, per axis
+            Lanes dx = add(maximum(sub(boxMinX, px), zero), maximum(sub(px, boxMaxX), zero));
+            Lanes dy = add(maximum(sub(boxMinY, py), zero), maximum(sub(py, boxMaxY), zero));
+            Lanes dz = add(maximum(sub(boxMinZ, pz), zero), maximum(sub(pz, boxMaxZ), zero));
+            Lanes distanceSquared = add(add(mul(dx, dx), mul(dy, dy)), mul(dz, dz));
+            Mask hit = lessEqual(distanceSquared, mul(range, range));
+
+            if (light.cone && bits(hit)) {
+                Lanes vx = sub(centerX, px), vy = sub(centerY, py), vz = sub(centerZ, pz);
+                Lanes lengthSquared = add(add(mul(vx, vx), mul(vy, vy)), mul(vz, vz));
+                Lanes along = add(add(mul(vx, splat(light.direction.x)), mul(vy, splat(light.direction.y))),
+                                  mul(vz, splat(light.direction.z)));
+                Lanes across = squareRoot(maximum(sub(lengthSquared, mul(along, along)), zero));
+                Lanes closest = sub(mul(splat(light.cosAngle), across), mul(along, splat(light.sinAngle)));
+                Mask culled = either(either(greater(closest, radius), greater(along, add(radius, range))),
+                                     greater(sub(zero, radius), along));
+                hit = andNot(hit, culled);
+            }
+
+            uint32_t mask = bits(hit);
+            work.masks[c] = static_cast<uint8_t>(mask);
+            touched |= mask;
+        }
+
+        // Write each cluster's list; lanes past the slice's end are padding
+        const uint32_t lanes = std::min(WIDTH, clustersPerSlice - block);
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            ClusterRange& clusterRange = sliceRanges[block + lane];
+            clusterRange.offset = static_cast<uint32_t>(work.indices.size());
+            clusterRange.count = 0;
+            if (!(touched & (1u << lane))) continue;
+            for (size_t c = 0; c < work.candidates.size(); ++c) {
+                if (work.masks[c] & (1u << lane)) work.indices.push_back(viewLights[work.candidates[c]].index);
+            }
+            clusterRange.count = static_cast<uint32_t>(work.indices.size()) - clusterRange.offset;
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../scene/Bounds.hpp"
+
+class LightBuffer;
+
+// Matches the header of the LightClusterGrid buffer in lit_clustered.frag
+struct LightClusterHeader {
+    uint32_t tilesX = 0;
+    uint32_t tilesY = 0;
+    uint32_t slices = 0;
+    uint32_t padding = 0;
+    float depthScale = 0.0f;  // slice = floor(log(viewDepth) * depthScale + depthBias)
+    float depthBias = 0.0f;
+    float nearPlane = 0.0f;
+    float farPlane = 0.0f;
+};
+static_assert(sizeof(LightClusterHeader) == 32, "LightClusterHeader must match lit_clustered.frag");
+
+// A cluster's run in the light index list
+struct ClusterRange {
+    uint32_t offset;
+    uint32_t count;
+};
+
+// Clustered forward lighting, CPU side. The camera frustum is cut into
+// tilesX x tilesY screen tiles and `slices` depth slices, spaced
+// exponentially so clusters stay roughly cubic. Each cluster keeps its
+// view-space AABB and bounding sphere. Every frame, each point and spot
+// light is tested against the clusters and the result is written as one
+// offset/count range per cluster into a compact list of light indices.
+// Indices refer to LightBuffer's array, which the shader already holds.
+//
+// Work is split across JobSystem by depth slice. Within a slice one light
+// is tested against four clusters at a time with SSE, or eight with AVX
+// when built with ENGINE_AVX: a sphere-AABB test for every light, then a
+// cone test against the cluster's bounding sphere for spot lights. GL-free.
+// Renderer uploads the result.
+class LightClusters {
+public:
+    static constexpr uint32_t GRID_BINDING = 1;   // Header, then one ClusterRange per cluster
+    static constexpr uint32_t INDEX_BINDING = 2;  // The light index list
+
+    struct Stats {
+        uint32_t lights = 0;       // Point and spot lights considered
+        uint32_t assignments = 0;  // Entries in the index list
+        uint32_t maxPerCluster = 0;
+        uint32_t emptyClusters = 0;
+    };
+
+    LightClusters(uint32_t tilesX = 16, uint32_t tilesY = 9, uint32_t slices = 24);
+
+    // Rebuilds cluster bounds if the projection changed, then assigns the
+    // point and spot lights in `lights`; directional lights light every
+    // cluster and are left to the shader
+    void build(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane,
+               const LightBuffer& lights);
+
+    const LightClusterHeader& getHeader() const { return header; }
+    const std::vector<ClusterRange>& getRanges() const { return ranges; }
+    const std::vector<uint32_t>& getLightIndices() const { return lightIndices; }
+    const Stats& getStats() const { return stats; }
+
+    size_t getClusterCount() const { return ranges.size(); }
+    uint32_t getClusterIndex(uint32_t x, uint32_t y, uint32_t z) const {
+        return x + header.tilesX * (y + header.tilesY * z);
+    }
+    AABB getClusterBounds(uint32_t cluster) const;
+
+private:
+    // A light in view space, as the tests need it
+    struct ViewLight {
+        glm::vec3 position;
+        float range;
+        glm::vec3 direction;
+        float cosAngle;  // Outer cone, including the falloff band
+        float sinAngle;
+        bool cone;       // Spot lights narrower than a hemisphere
+        uint32_t index;  // Into LightBuffer's array
+        float reach;     // Range padded for the per-slice prefilter
+    };
+
+    // Per depth slice, reused across frames so steady state allocates nothing
+    struct SliceWork {
+        std::vector<uint32_t> candidates;  // ViewLights that reach the slice's bounds
+        std::vector<uint8_t> masks;        // Per candidate, the lanes of the current block it lights
+        std::vector<uint32_t> indices;
+    };
+
+    LightClusterHeader header;
+    uint32_t clustersPerSlice;
+    uint32_t sliceStride;  // clustersPerSlice rounded up to whole SIMD blocks
+
+    // Cluster bounds, structure-of-arrays, padded per slice with boxes that
+    // touch nothing
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+    std::vector<float> sphereX, sphereY, sphereZ, sphereRadius;
+    std::vector<float> sliceDepths;  // slices + 1 boundaries, positive view depth
+    std::vector<AABB> sliceBounds;   // Each slice's clusters together
+
+    glm::mat4 builtProjection;
+    bool boundsValid;
+
+    std::vector<ViewLight> viewLights;
+    std::vector<SliceWork> sliceWork;
+    std::vector<ClusterRange> ranges;
+    std::vector<uint32_t> lightIndices;
+    Stats stats;
+
+    void buildClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane);
+    void assignSlice(uint32_t slice);
+};
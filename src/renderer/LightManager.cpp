@@ -1,25 +1,34 @@
 #include "LightManager.hpp"
-#include "Shader.hpp"
+#include "../components/Transform.hpp"
+#include "../core/Profiler.hpp"
+#include "../scene/Scene.hpp"
+#include <GL/glew.h>
 #include <algorithm>
 
+void LightManager::gatherLights(Scene& scene) {
+    clear();
+    scene.view<Light, Transform>().each([this](Entity*, Light& light, Transform& transform) {
+        addGathered(light, transform.getPosition(), Light::directionFromRotation(transform.getRotation()));
+    });
+}
+
 void LightManager::addLight(Light* light) {
     if (!light) return;
+    addGathered(*light, light->getPosition(), light->getDirection());
+}
 
-    switch (light->getType()) {
+void LightManager::addGathered(const Light& light, const glm::vec3& position, const glm::vec3& direction) {
+    GatheredLight gathered{ &light, position, direction };
+
+    switch (light.getType()) {
         case Light::Type::Directional:
-            if (directionalLights.size() < MAX_DIRECTIONAL_LIGHTS) {
-                directionalLights.push_back(light);
-            }
+            directionalLights.push_back(gathered);
             break;
         case Light::Type::Point:
-            if (pointLights.size() < MAX_POINT_LIGHTS) {
-                pointLights.push_back(light);
-            }
+            pointLights.push_back(gathered);
             break;
         case Light::Type::Spot:
-            if (spotLights.size() < MAX_SPOT_LIGHTS) {
-                spotLights.push_back(light);
-            }
+            spotLights.push_back(gathered);
             break;
     }
 }
@@ -27,8 +36,9 @@ void LightManager::addLight(Light* light) {
 void LightManager::removeLight(Light* light) {
     if (!light) return;
 
-    auto removeFromVector = [light](std::vector<Light*>& lights) {
-        auto it = std::find(lights.begin(), lights.end(), light);
+    auto removeFromVector = [light](std::vector<GatheredLight>& lights) {
+        auto it = std::find_if(lights.begin(), lights.end(),
+            [light](const GatheredLight& gathered) { return gathered.light == light; });
         if (it != lights.end()) {
             lights.erase(it);
         }
@@ -53,56 +63,35 @@ void LightManager::clear() {
     spotLights.clear();
 }
 
-void LightManager::applyLights(Shader* shader) {
-    if (!shader) return;
-
-    applyDirectionalLights(shader);
-    applyPointLights(shader);
-    applySpotLights(shader);
-}
-
-void LightManager::applyDirectionalLights(Shader* shader) {
-    shader->setInt("numDirectionalLights", static_cast<int>(directionalLights.size()));
-
-    for (size_t i = 0; i < directionalLights.size() && i < MAX_DIRECTIONAL_LIGHTS; ++i) {
-        std::string base = "directionalLights[" + std::to_string(i) + "].";
-        shader->setVec3(base + "direction", directionalLights[i]->getDirection());
-        shader->setVec3(base + "color", directionalLights[i]->getColor());
-        shader->setFloat(base + "intensity", directionalLights[i]->getIntensity());
+void LightManager::uploadLights() {
+    PROFILE_SCOPE("LightManager::uploadLights");
+    packed.clear();
+    packed.reserve(directionalLights.size() + pointLights.size() + spotLights.size());
+    for (const auto* lights : { &directionalLights, &pointLights, &spotLights }) {
+        for (const GatheredLight& light : *lights) {
+            packed.add(*light.light, light.position, light.direction);
+        }
     }
-}
 
-void LightManager::applyPointLights(Shader* shader) {
-    shader->setInt("numPointLights", static_cast<int>(pointLights.size()));
+    if (!buffer) {
+        glGenBuffers(1, &buffer);
+    }
 
-    for (size_t i = 0; i < pointLights.size() && i < MAX_POINT_LIGHTS; ++i) {
-        std::string base = "pointLights[" + std::to_string(i) + "].";
-        shader->setVec3(base + "position", pointLights[i]->getPosition());
-        shader->setVec3(base + "color", pointLights[i]->getColor());
-        shader->setFloat(base + "intensity", pointLights[i]->getIntensity());
-        shader->setFloat(base + "range", pointLights[i]->getRange());
-        
-        // Attenuation factors
-        float range = pointLights[i]->getRange();
-        shader->setFloat(base + "constant", 1.0f);
-        shader->setFloat(base + "linear", 2.0f / range);
-        shader->setFloat(base + "quadratic", 1.0f / (range * range));
+    // Orphans last frame's storage rather than waiting on draws still reading it
+    const std::vector<GpuLight>& lights = packed.getLights();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, packed.getByteSize(), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(LightBufferHeader), &packed.getHeader());
+    if (!lights.empty()) {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(LightBufferHeader),
+                        lights.size() * sizeof(GpuLight), lights.data());
     }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LightBuffer::BINDING, buffer);
 }
 
-void LightManager::applySpotLights(Shader* shader) {
-    shader->setInt("numSpotLights", static_cast<int>(spotLights.size()));
-
-    for (size_t i = 0; i < spotLights.size() && i < MAX_SPOT_LIGHTS; ++i) {
-        std::string base = "spotLights[" + std::to_string(i) + "].";
-        shader->setVec3(base + "position", spotLights[i]->getPosition());
-        shader->setVec3(base + "direction", spotLights[i]->getDirection());
-        shader->setVec3(base + "color", spotLights[i]->getColor());
-        shader->setFloat(base + "intensity", spotLights[i]->getIntensity());
-        shader->setFloat(base + "range", spotLights[i]->getRange());
-        
-        float angle = spotLights[i]->getSpotAngle();
-        shader->setFloat(base + "cutOff", glm::cos(glm::radians(angle)));
-        shader->setFloat(base + "outerCutOff", glm::cos(glm::radians(angle + 5.0f)));
+void LightManager::releaseBuffer() {
+    if (buffer) {
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
     }
 }
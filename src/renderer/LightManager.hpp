@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "LightBuffer.hpp"
+#include "../components/Light.hpp"
+
+class Scene;
+
+// Collects the lights that lit.frag shades with and uploads them once per
+// frame into a shader storage buffer bound at LightBuffer::BINDING, which
+// every shader reads. Binds no uniforms, so light count adds no per-draw or
+// per-shader CPU cost.
+class LightManager {
+public:
+    static LightManager& getInstance() {
+        static LightManager instance;
+        return instance;
+    }
+
+    // Replaces the current set with every Light + Transform in the scene,
+    // capturing position and direction in the same pass. Call once per frame
+    // after Scene::update.
+    void gatherLights(Scene& scene);
+
+    // Manual registration; position and direction are captured now
+    void addLight(Light* light);
+    void removeLight(Light* light);
+    void clear();
+
+    // Packs the current set and uploads it; call once per frame before
+    // drawing, with a GL context current
+    void uploadLights();
+    void releaseBuffer();
+
+    // What the last uploadLights() sent
+    const LightBuffer& getPackedLights() const { return packed; }
+
+private:
+    LightManager() = default;
+    ~LightManager() = default;
+    LightManager(const LightManager&) = delete;
+    LightManager& operator=(const LightManager&) = delete;
+
+    struct GatheredLight {
+        const Light* light;
+        glm::vec3 position;
+        glm::vec3 direction;
+    };
+
+    std::vector<GatheredLight> directionalLights;
+    std::vector<GatheredLight> pointLights;
+    std::vector<GatheredLight> spotLights;
+
+    LightBuffer packed;
+    unsigned int buffer = 0;
+
+    void addGathered(const Light& light, const glm::vec3& position, const glm::vec3& direction);
+};
@@ -1,8 +1,9 @@
 #pragma once
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
+#include "Uniforms.hpp"
 
 class Shader;
 class Texture;
@@ -12,9 +13,16 @@ public:
     Material();
     explicit Material(std::shared_ptr<Shader> shader);
 
+    // use() on the shader, then apply()
     void bind();
     void unbind();
 
+    // Uploads properties and binds textures, assuming the shader is
+    // already in use. The render queue calls this when only the material
+    // changed between draws. Only values changed since the last apply()
+    // are uploaded, unless another material has used the shader since.
+    void apply();
+
     // Shader management
     void setShader(std::shared_ptr<Shader> shader);
     Shader* getShader() const { return shader.get(); }
@@ -24,7 +32,10 @@ public:
     void setViewMatrix(const glm::mat4& matrix);
     void setProjectionMatrix(const glm::mat4& matrix);
 
-    // Material properties
+    // Material properties; the typed form skips interning the name
+    template<typename T>
+    void set(UniformHandle<T> handle, const T& value) { properties.set(handle, value); }
+
     void setFloat(const std::string& name, float value);
     void setInt(const std::string& name, int value);
     void setVector2(const std::string& name, const glm::vec2& value);
@@ -34,16 +45,12 @@ public:
     void setTexture(const std::string& name, std::shared_ptr<Texture> texture);
 
 private:
-    std::shared_ptr<Shader> shader;
-    std::unordered_map<std::string, std::shared_ptr<Texture>> textures;
+    struct TextureBinding {
+        UniformHandle<int> sampler;
+        std::shared_ptr<Texture> texture;
+    };
 
-    // Material properties cache
-    std::unordered_map<std::string, float> floatProperties;
-    std::unordered_map<std::string, int> intProperties;
-    std::unordered_map<std::string, glm::vec2> vector2Properties;
-    std::unordered_map<std::string, glm::vec3> vector3Properties;
-    std::unordered_map<std::string, glm::vec4> vector4Properties;
-    std::unordered_map<std::string, glm::mat4> matrix4Properties;
-
-    void applyProperties();
+    std::shared_ptr<Shader> shader;
+    std::vector<TextureBinding> textures;
+    PropertyBlock properties;
 };
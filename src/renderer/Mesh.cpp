@@ -1,6 +1,6 @@
 #include "Mesh.hpp"
 
-Mesh::Mesh() : VAO(0), VBO(0), EBO(0) {}
+Mesh::Mesh() : VAO(0), VBO(0), EBO(0), instanceBuffer(0) {}
 
 Mesh::~Mesh() {
     cleanup();
@@ -9,6 +9,14 @@ Mesh::~Mesh() {
 void Mesh::initialize(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
     this->vertices = vertices;
     this->indices = indices;
+
+    if (!vertices.empty()) {
+        bounds = AABB(vertices[0].position, vertices[0].position);
+        for (const Vertex& vertex : vertices) {
+            bounds.min = glm::min(bounds.min, vertex.position);
+            bounds.max = glm::max(bounds.max, vertex.position);
+        }
+    }
     setupMesh();
 }
 
@@ -53,8 +61,16 @@ void Mesh::setupMesh() {
 }
 
 void Mesh::render() const {
+    bind();
+    draw();
+    glBindVertexArray(0);
+}
+
+void Mesh::bind() const {
     glBindVertexArray(VAO);
+}
 
+void Mesh::draw() const {
     if (subMeshes.empty()) {
         // Render entire mesh if no submeshes defined
         glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
@@ -68,8 +84,38 @@ void Mesh::render() const {
                                    subMesh.baseVertex);
         }
     }
+}
 
-    glBindVertexArray(0);
+void Mesh::drawInstanced(uint32_t count, uint32_t baseInstance) const {
+    if (subMeshes.empty()) {
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT,
+                                            0, static_cast<GLsizei>(count), baseInstance);
+    } else {
+        for (const auto& subMesh : subMeshes) {
+            glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES,
+                                                          subMesh.numIndices,
+                                                          GL_UNSIGNED_INT,
+                                                          (void*)(sizeof(unsigned int) * subMesh.baseIndex),
+                                                          static_cast<GLsizei>(count),
+                                                          subMesh.baseVertex,
+                                                          baseInstance);
+        }
+    }
+}
+
+void Mesh::setInstanceBuffer(GLuint buffer) {
+    if (instanceBuffer == buffer) return;
+    instanceBuffer = buffer;
+
+    // A mat4 attribute takes four vec4 slots; advance once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (GLuint column = 0; column < 4; ++column) {
+        GLuint location = INSTANCE_MATRIX_LOCATION + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                              (void*)(sizeof(glm::vec4) * column));
+        glVertexAttribDivisor(location, 1);
+    }
 }
 
 void Mesh::cleanup() {
@@ -85,4 +131,5 @@ void Mesh::cleanup() {
         glDeleteBuffers(1, &EBO);
         EBO = 0;
     }
+    instanceBuffer = 0;
 }
@@ -2,14 +2,8 @@
 #include <vector>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
-
-struct Vertex {
-    glm::vec3 position;
-    glm::vec3 normal;
-    glm::vec2 texCoords;
-    glm::vec3 tangent;
-    glm::vec3 bitangent;
-};
+#include "Vertex.hpp"
+#include "../scene/Bounds.hpp"
 
 struct SubMesh {
     unsigned int baseVertex;
@@ -20,11 +14,28 @@ struct SubMesh {
 
 class Mesh {
 public:
+    // First of the four vec4 attribute slots holding the per-instance model
+    // matrix; must match aInstanceModel in lit.vert
+    static constexpr GLuint INSTANCE_MATRIX_LOCATION = 5;
+
     Mesh();
     ~Mesh();
 
     void initialize(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
     void render() const;
+
+    // render() split for callers that draw several times per bind: bind()
+    // makes the VAO current, draw() issues the draws and leaves it bound
+    void bind() const;
+    void draw() const;
+
+    // draw() for `count` instances reading model matrices from the buffer
+    // given to setInstanceBuffer, starting at matrix `baseInstance`
+    void drawInstanced(uint32_t count, uint32_t baseInstance) const;
+
+    // Points the instance matrix attributes at `buffer` (tightly packed
+    // mat4s). Cheap when the buffer is already attached; the VAO must be bound.
+    void setInstanceBuffer(GLuint buffer);
     void cleanup();
 
     // Getters for mesh data
@@ -32,6 +43,9 @@ public:
     const std::vector<uint32_t>& getIndices() const { return indices; }
     const std::vector<SubMesh>& getSubMeshes() const { return subMeshes; }
 
+    // Model-space bounds of the vertices, computed in initialize()
+    const AABB& getBounds() const { return bounds; }
+
     // Add submesh for multi-material support
     void addSubMesh(const SubMesh& subMesh) { subMeshes.push_back(subMesh); }
 
@@ -39,10 +53,12 @@ private:
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
     std::vector<SubMesh> subMeshes;
+    AABB bounds;
 
     GLuint VAO;
     GLuint VBO;
     GLuint EBO;
+    GLuint instanceBuffer;
 
     void setupMesh();
 };
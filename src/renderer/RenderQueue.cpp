@@ -0,0 +1,135 @@
+#include "RenderQueue.hpp"
+#include "../core/Profiler.hpp"
+#include <array>
+#include <cstring>
+
+namespace {
+    constexpr uint64_t fieldMask(uint32_t bits) {
+        return (uint64_t(1) << bits) - 1;
+    }
+}
+
+uint32_t RenderQueue::quantizeDepth(float depth) {
+    if (!(depth > 0.0f)) return 0; // Also catches NaN
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits >> (31 - DEPTH_BITS);
+}
+
+uint64_t RenderQueue::makeKey(RenderPass pass, uint16_t shader, uint16_t material, uint16_t mesh, float depth) {
+    uint64_t depthBits = quantizeDepth(depth);
+    uint64_t state = ((shader & fieldMask(SHADER_BITS)) << (MATERIAL_BITS + MESH_BITS)) |
+                     ((material & fieldMask(MATERIAL_BITS)) << MESH_BITS) |
+                     (mesh & fieldMask(MESH_BITS));
+    uint64_t key = uint64_t(pass) << 62;
+
+    if (pass == RenderPass::Transparent) {
+        uint64_t farToNear = fieldMask(DEPTH_BITS) - depthBits;
+        return key | (farToNear << (SHADER_BITS + MATERIAL_BITS + MESH_BITS)) | state;
+    }
+    return key | (state << DEPTH_BITS) | depthBits;
+}
+
+void RenderQueue::push(RenderPass pass, uint16_t shader, uint16_t material, uint16_t mesh, float depth,
+                       uint32_t instance) {
+    RenderPacket packet;
+    packet.sortKey = makeKey(pass, shader, material, mesh, depth);
+    packet.instance = instance;
+    packet.shader = shader;
+    packet.material = material;
+    packet.mesh = mesh;
+    packets.push_back(packet);
+}
+
+void RenderQueue::sort() {
+    PROFILE_SCOPE("RenderQueue::sort");
+    const size_t count = packets.size();
+    if (count < 2) return;
+    scratch.resize(count);
+
+    // All eight histograms in one read of the keys
+    std::array<std::array<uint32_t, 256>, 8> histograms{};
+    for (const RenderPacket& packet : packets) {
+        for (size_t byte = 0; byte < 8; ++byte) {
+            histograms[byte][(packet.sortKey >> (byte * 8)) & 0xFF]++;
+        }
+    }
+
+    RenderPacket* source = packets.data();
+    RenderPacket* destination = scratch.data();
+    for (size_t byte = 0; byte < 8; ++byte) {
+        std::array<uint32_t, 256>& histogram = histograms[byte];
+        uint32_t shift = static_cast<uint32_t>(byte * 8);
+        if (histogram[(source[0].sortKey >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram) {
+            uint32_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            destination[histogram[(source[i].sortKey >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != packets.data()) {
+        packets.swap(scratch);
+    }
+}
+
+RenderStats RenderQueue::submit(RenderBackend& backend) const {
+    PROFILE_SCOPE("RenderQueue::submit");
+    RenderStats stats;
+    const uint32_t count = static_cast<uint32_t>(packets.size());
+    stats.packets = count;
+
+    bool first = true;
+    uint16_t shader = 0, material = 0, mesh = 0;
+    uint32_t i = 0;
+    while (i < count) {
+        const RenderPacket& packet = packets[i];
+        bool shaderChanged = first || packet.shader != shader;
+        if (shaderChanged) {
+            backend.bindShader(packet.shader);
+            shader = packet.shader;
+            stats.shaderChanges++;
+        }
+        if (shaderChanged || packet.material != material) {
+            backend.bindMaterial(packet.material);
+            material = packet.material;
+            stats.materialChanges++;
+        }
+        if (first || packet.mesh != mesh) {
+            backend.bindMesh(packet.mesh);
+            mesh = packet.mesh;
+            stats.meshChanges++;
+        }
+        first = false;
+
+        uint32_t runEnd = i + 1;
+        if (minInstances > 0) {
+            while (runEnd < count && packets[runEnd].shader == shader &&
+                   packets[runEnd].material == material && packets[runEnd].mesh == mesh) {
+                ++runEnd;
+            }
+        }
+
+        uint32_t runLength = runEnd - i;
+        if (minInstances > 0 && runLength >= minInstances) {
+            backend.drawInstanced(&packet, runLength, i);
+            stats.instancedBatches++;
+            stats.instancedPackets += runLength;
+            stats.drawCalls++;
+            i = runEnd;
+        } else {
+            // Short runs draw singly; their state is already bound
+            for (; i < runEnd; ++i) {
+                backend.draw(packets[i]);
+            }
+            stats.drawCalls += runLength;
+        }
+    }
+    return stats;
+}
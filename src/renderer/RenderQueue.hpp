@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One frame's draws, reduced to compact packets that are sorted by a 64-bit
+// key and submitted in order. Resources are referred to by small ids the
+// caller assigns per frame; the queue never touches GL, so sorting and
+// state tracking run (and are benchmarked) without a GPU. The GL side is a
+// RenderBackend, which Renderer implements.
+//
+// Key layout, most significant bits first:
+//   Opaque:      pass:2 | shader:12 | material:14 | mesh:12 | depth:24
+//   Transparent: pass:2 | far-to-near depth:24 | shader:12 | material:14 | mesh:12
+// Opaque draws group by state and go front to back within a group;
+// transparent draws must blend back to front, so depth wins over state.
+//
+// After sorting, consecutive packets with the same shader, material and
+// mesh form a run. Runs of at least getMinInstances() packets go to the
+// backend as one instanced draw; instances keep packet order, so this is
+// safe in both passes.
+enum class RenderPass : uint8_t {
+    Opaque,
+    Transparent
+};
+
+struct RenderPacket {
+    uint64_t sortKey;
+    uint32_t instance;  // Caller's index for per-draw data, e.g. the world matrix
+    uint16_t shader;
+    uint16_t material;
+    uint16_t mesh;
+};
+
+// Counts for the last submit; a "state change" is a bind that was not
+// skipped as redundant. An instanced batch is one draw call.
+struct RenderStats {
+    uint32_t packets = 0;
+    uint32_t drawCalls = 0;
+    uint32_t shaderChanges = 0;
+    uint32_t materialChanges = 0;
+    uint32_t meshChanges = 0;
+    uint32_t instancedBatches = 0;
+    uint32_t instancedPackets = 0;  // Packets drawn as part of a batch
+
+    uint32_t getStateChanges() const { return shaderChanges + materialChanges + meshChanges; }
+};
+
+// Receives the sorted stream with redundant binds already removed. A
+// material is always rebound after a shader change, since its uniforms
+// live in the shader program.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual void bindShader(uint16_t shader) = 0;
+    virtual void bindMaterial(uint16_t material) = 0;
+    virtual void bindMesh(uint16_t mesh) = 0;
+    virtual void draw(const RenderPacket& packet) = 0;
+
+    // `count` same-state packets in one draw. `first` is the position of
+    // packets[0] in the sorted queue, for backends that lay out per-instance
+    // data in queue order. The default draws them one by one.
+    virtual void drawInstanced(const RenderPacket* packets, uint32_t count, uint32_t first) {
+        (void)first;
+        for (uint32_t i = 0; i < count; ++i) {
+            draw(packets[i]);
+        }
+    }
+};
+
+class RenderQueue {
+public:
+    static constexpr uint32_t SHADER_BITS = 12;
+    static constexpr uint32_t MATERIAL_BITS = 14;
+    static constexpr uint32_t MESH_BITS = 12;
+    static constexpr uint32_t DEPTH_BITS = 24;
+
+    RenderQueue() : minInstances(2) {}
+
+    void clear() { packets.clear(); }
+    void reserve(size_t count) { packets.reserve(count); }
+
+    // `depth` is the view-space distance to the camera; negative values
+    // count as zero. Ids wider than their key field still draw correctly,
+    // they just sort less tightly.
+    void push(RenderPass pass, uint16_t shader, uint16_t material, uint16_t mesh, float depth, uint32_t instance);
+
+    // Stable LSD radix sort on the key, one byte per pass; passes where
+    // every key has the same byte are skipped
+    void sort();
+
+    // Walks the packets in order, binding only what differs from the
+    // previous packet and batching same-state runs
+    RenderStats submit(RenderBackend& backend) const;
+
+    // Shortest run drawn instanced; 0 turns instancing off
+    void setMinInstances(uint32_t count) { minInstances = count; }
+    uint32_t getMinInstances() const { return minInstances; }
+
+    const std::vector<RenderPacket>& getPackets() const { return packets; }
+    size_t size() const { return packets.size(); }
+
+    static uint64_t makeKey(RenderPass pass, uint16_t shader, uint16_t material, uint16_t mesh, float depth);
+
+    // Top DEPTH_BITS of the float's bit pattern, which orders like the
+    // value for non-negative floats
+    static uint32_t quantizeDepth(float depth);
+
+private:
+    std::vector<RenderPacket> packets;
+    std::vector<RenderPacket> scratch;
+    uint32_t minInstances;
+};
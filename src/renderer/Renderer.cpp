@@ -1,7 +1,92 @@
 #include "Renderer.hpp"
+#include "LightManager.hpp"
+#include "Material.hpp"
+#include "Mesh.hpp"
+#include "Shader.hpp"
+#include "../components/Camera.hpp"
+#include "../components/MeshRenderer.hpp"
+#include "../components/Transform.hpp"
 #include "../scene/Scene.hpp"
+#include "../core/Profiler.hpp"
+#include <algorithm>
 
-Renderer::Renderer() : clearColor(0.2f, 0.3f, 0.3f, 1.0f) {}
+namespace {
+    const UniformHandle<glm::mat4> VIEW_MATRIX("view");
+    const UniformHandle<glm::mat4> PROJECTION_MATRIX("projection");
+    const UniformHandle<glm::vec3> VIEW_POSITION("viewPos");
+    const UniformHandle<int> USE_INSTANCING("useInstancing");
+}
+
+// Turns the sorted packet stream into GL calls
+class Renderer::GLBackend : public RenderBackend {
+public:
+    GLBackend(Renderer& renderer, const glm::mat4& view, const glm::mat4& projection)
+        : renderer(renderer)
+        , view(view)
+        , projection(projection)
+        , viewPosition(glm::inverse(view)[3])
+        , preparedShaders(renderer.shaders.size(), false)
+    {}
+
+    void bindShader(uint16_t id) override {
+        shader = renderer.shaders.get(id);
+        shader->use();
+        instancing = -1; // Each program keeps its own uniform value
+
+        // Per-frame uniforms only once per program
+        if (!preparedShaders[id]) {
+            preparedShaders[id] = true;
+            shader->set(VIEW_MATRIX, view);
+            shader->set(PROJECTION_MATRIX, projection);
+            shader->set(VIEW_POSITION, viewPosition);
+        }
+    }
+
+    void bindMaterial(uint16_t id) override {
+        material = renderer.materials.get(id);
+        material->apply();
+    }
+
+    void bindMesh(uint16_t id) override {
+        mesh = renderer.meshes.get(id);
+        mesh->bind();
+        if (renderer.instanceBuffer) {
+            mesh->setInstanceBuffer(renderer.instanceBuffer);
+        }
+    }
+
+    void draw(const RenderPacket& packet) override {
+        setInstancing(false);
+        material->setModelMatrix(renderer.modelMatrices[packet.instance]);
+        mesh->draw();
+    }
+
+    void drawInstanced(const RenderPacket*, uint32_t count, uint32_t first) override {
+        setInstancing(true);
+        mesh->drawInstanced(count, first);
+    }
+
+private:
+    void setInstancing(bool enabled) {
+        if (instancing == static_cast<int>(enabled)) return;
+        instancing = enabled;
+        shader->set(USE_INSTANCING, instancing);
+    }
+
+    Renderer& renderer;
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 viewPosition;
+    std::vector<bool> preparedShaders;
+    Shader* shader = nullptr;
+    int instancing = -1;
+    Material* material = nullptr;
+    Mesh* mesh = nullptr;
+};
+
+Renderer::Renderer()
+    : clearColor(0.2f, 0.3f, 0.3f, 1.0f), instanceBuffer(0), lightClustering(true), clusterGridBuffer(0),
+      clusterIndexBuffer(0) {}
 
 Renderer::~Renderer() {
     shutdown();
@@ -11,11 +96,24 @@ bool Renderer::initialize() {
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
+    glGenBuffers(1, &instanceBuffer);
+    glGenBuffers(1, &clusterGridBuffer);
+    glGenBuffers(1, &clusterIndexBuffer);
     return true;
 }
 
 void Renderer::shutdown() {
-    // Clean up any renderer resources
+    LightManager::getInstance().releaseBuffer();
+    if (instanceBuffer) {
+        glDeleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0;
+    }
+    if (clusterGridBuffer) {
+        glDeleteBuffers(1, &clusterGridBuffer);
+        glDeleteBuffers(1, &clusterIndexBuffer);
+        clusterGridBuffer = 0;
+        clusterIndexBuffer = 0;
+    }
 }
 
 void Renderer::beginFrame() {
@@ -23,8 +121,93 @@ void Renderer::beginFrame() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void Renderer::render(const Scene& scene) {
-    // Will be implemented when we add scene rendering
+void Renderer::render(Scene& scene, const Camera& camera) {
+    PROFILE_SCOPE("Renderer::render");
+    const glm::mat4 view = camera.getViewMatrix();
+    const glm::mat4 projection = camera.getProjectionMatrix();
+
+    queue.clear();
+    shaders.clear();
+    materials.clear();
+    meshes.clear();
+    modelMatrices.clear();
+
+    visibleEntities.clear();
+    cullStats = scene.getSpatialIndex().cull(SpatialIndex::Layer::Renderables, camera.getFrustum(), visibleEntities);
+
+    {
+        PROFILE_SCOPE("Renderer::extract");
+        for (Entity* entity : visibleEntities) {
+            // Renderers removed since the last sync are skipped
+            MeshRenderer* renderer = entity->getComponent<MeshRenderer>();
+            Transform* transform = entity->getComponent<Transform>();
+            if (!renderer || !transform) continue;
+
+            Mesh* mesh = renderer->getMesh();
+            Material* material = renderer->getMaterial();
+            Shader* shader = material ? material->getShader() : nullptr;
+            if (!mesh || !shader) continue;
+
+            const glm::mat4& model = transform->getRenderMatrix();
+            glm::vec4 center = model * glm::vec4(renderer->getLocalBounds().getCenter(), 1.0f);
+            float depth = -(view * center).z;
+
+            uint32_t instance = static_cast<uint32_t>(modelMatrices.size());
+            modelMatrices.push_back(model);
+            queue.push(RenderPass::Opaque, shaders.getId(shader), materials.getId(material),
+                       meshes.getId(mesh), depth, instance);
+        }
+    }
+
+    queue.sort();
+
+    // Orphans last frame's storage rather than waiting on draws still reading it
+    if (instanceBuffer && queue.getMinInstances() > 0 && queue.size() > 0) {
+        instanceMatrices.clear();
+        for (const RenderPacket& packet : queue.getPackets()) {
+            instanceMatrices.push_back(modelMatrices[packet.instance]);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, instanceMatrices.size() * sizeof(glm::mat4), instanceMatrices.data(),
+                     GL_STREAM_DRAW);
+    }
+
+    LightManager::getInstance().uploadLights();
+    if (lightClustering && clusterGridBuffer) {
+        uploadLightClusters(camera, view, projection);
+    }
+
+    GLBackend backend(*this, view, projection);
+    stats = queue.submit(backend);
+    glBindVertexArray(0);
+}
+
+void Renderer::uploadLightClusters(const Camera& camera, const glm::mat4& view, const glm::mat4& projection) {
+    PROFILE_SCOPE("Renderer::uploadLightClusters");
+    // Depth slicing is logarithmic, so it needs a near plane in front of the camera
+    if (camera.getNearPlane() <= 0.0f || camera.getFarPlane() <= camera.getNearPlane()) return;
+
+    lightClusters.build(view, projection, camera.getNearPlane(), camera.getFarPlane(),
+                        LightManager::getInstance().getPackedLights());
+
+    // Orphaned like the light buffer; the index list is never empty so the binding stays valid
+    const std::vector<ClusterRange>& ranges = lightClusters.getRanges();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, clusterGridBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(LightClusterHeader) + ranges.size() * sizeof(ClusterRange),
+                 nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(LightClusterHeader), &lightClusters.getHeader());
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(LightClusterHeader), ranges.size() * sizeof(ClusterRange),
+                    ranges.data());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LightClusters::GRID_BINDING, clusterGridBuffer);
+
+    const std::vector<uint32_t>& indices = lightClusters.getLightIndices();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, clusterIndexBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(indices.size(), 1) * sizeof(uint32_t), nullptr,
+                 GL_STREAM_DRAW);
+    if (!indices.empty()) {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, indices.size() * sizeof(uint32_t), indices.data());
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LightClusters::INDEX_BINDING, clusterIndexBuffer);
 }
 
 void Renderer::endFrame() {
@@ -1,11 +1,20 @@
 #pragma once
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
+#include "LightClusters.hpp"
+#include "RenderQueue.hpp"
+#include "../scene/CullingSet.hpp"
 
 class Scene;
 class Camera;
+class Entity;
+class Material;
+class Mesh;
+class Shader;
 
 class Renderer {
 public:
@@ -16,12 +25,75 @@ public:
     void shutdown();
     
     void beginFrame();
-    void render(const Scene& scene);
+
+    // Frustum-culls the scene's MeshRenderers against their exact world
+    // bounds, extracts a packet per visible one, sorts them and draws them
+    // with redundant shader, material and VAO binds skipped. Camera
+    // matrices are set once per shader per frame and lights are uploaded
+    // once per frame, from LightManager's gathered set. Renderers
+    // sharing a mesh and material are drawn instanced, from one buffer of
+    // world matrices uploaded per frame. With light clustering on, each
+    // cluster's light list is uploaded too, for lit_clustered.frag.
+    void render(Scene& scene, const Camera& camera);
     void endFrame();
 
     void setViewport(int width, int height);
     void setClearColor(const glm::vec4& color);
 
+    // Fewest renderers sharing mesh and material that are drawn as one
+    // instanced batch; 0 draws every renderer on its own
+    void setMinInstances(uint32_t count) { queue.setMinInstances(count); }
+
+    // Assigns point and spot lights to view clusters every frame. On by
+    // default; shaders that do not read the cluster buffers are unaffected.
+    void setLightClustering(bool enabled) { lightClustering = enabled; }
+    const LightClusters& getLightClusters() const { return lightClusters; }
+
+    // Counts from the last render(); batch counts are in RenderStats
+    const RenderStats& getStats() const { return stats; }
+    const CullingSet::Stats& getCullStats() const { return cullStats; }
+
 private:
+    // Dense per-frame ids for the resources referenced by packets
+    template<typename T>
+    class ResourceTable {
+    public:
+        uint16_t getId(T* resource) {
+            auto [it, inserted] = ids.try_emplace(resource, static_cast<uint16_t>(resources.size()));
+            if (inserted) resources.push_back(resource);
+            return it->second;
+        }
+        T* get(uint16_t id) const { return resources[id]; }
+        size_t size() const { return resources.size(); }
+        void clear() { ids.clear(); resources.clear(); }
+
+    private:
+        std::unordered_map<T*, uint16_t> ids;
+        std::vector<T*> resources;
+    };
+
+    class GLBackend;
+
     glm::vec4 clearColor;
+
+    RenderQueue queue;
+    RenderStats stats;
+    CullingSet::Stats cullStats;
+    std::vector<Entity*> visibleEntities;
+    ResourceTable<Shader> shaders;
+    ResourceTable<Material> materials;
+    ResourceTable<Mesh> meshes;
+    std::vector<glm::mat4> modelMatrices; // Indexed by RenderPacket::instance
+
+    // modelMatrices in sorted packet order, so a batch's matrices start at
+    // its first packet's position in the queue
+    std::vector<glm::mat4> instanceMatrices;
+    GLuint instanceBuffer;
+
+    LightClusters lightClusters;
+    bool lightClustering;
+    GLuint clusterGridBuffer;
+    GLuint clusterIndexBuffer;
+
+    void uploadLightClusters(const Camera& camera, const glm::mat4& view, const glm::mat4& projection);
 };
@@ -0,0 +1,198 @@
+#include "Shader.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+    bool readFile(const std::string& path, std::string& contents) {
+        std::ifstream file(path);
+        if (!file) return false;
+        std::stringstream stream;
+        stream << file.rdbuf();
+        contents = stream.str();
+        return true;
+    }
+
+    GLuint compileStage(GLenum stage, const std::string& source) {
+        GLuint shader = glCreateShader(stage);
+        const char* text = source.c_str();
+        glShaderSource(shader, 1, &text, nullptr);
+        glCompileShader(shader);
+
+        GLint success = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            char log[1024];
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            std::cerr << (stage == GL_VERTEX_SHADER ? "Vertex" : "Fragment")
+                      << " shader compilation failed:\n" << log << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+
+    // Types the engine writes; anything else (images, integer vectors) is
+    // left out of the table
+    bool toUniformType(GLenum glType, UniformType& type) {
+        switch (glType) {
+            case GL_FLOAT: type = UniformType::Float; return true;
+            case GL_FLOAT_VEC2: type = UniformType::Vec2; return true;
+            case GL_FLOAT_VEC3: type = UniformType::Vec3; return true;
+            case GL_FLOAT_VEC4: type = UniformType::Vec4; return true;
+            case GL_FLOAT_MAT3: type = UniformType::Mat3; return true;
+            case GL_FLOAT_MAT4: type = UniformType::Mat4; return true;
+            case GL_INT:
+            case GL_BOOL:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_2D_SHADOW:
+                type = UniformType::Int;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void upload(GLuint program, GLint location, UniformType type, const void* value) {
+        const GLfloat* floats = static_cast<const GLfloat*>(value);
+        switch (type) {
+            case UniformType::Float: glProgramUniform1fv(program, location, 1, floats); break;
+            case UniformType::Int: glProgramUniform1iv(program, location, 1, static_cast<const GLint*>(value)); break;
+            case UniformType::Vec2: glProgramUniform2fv(program, location, 1, floats); break;
+            case UniformType::Vec3: glProgramUniform3fv(program, location, 1, floats); break;
+            case UniformType::Vec4: glProgramUniform4fv(program, location, 1, floats); break;
+            case UniformType::Mat3: glProgramUniformMatrix3fv(program, location, 1, GL_FALSE, floats); break;
+            case UniformType::Mat4: glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, floats); break;
+        }
+    }
+}
+
+Shader::Shader() : program(0) {}
+
+Shader::~Shader() {
+    cleanup();
+}
+
+bool Shader::loadFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
+    std::string vertexSource, fragmentSource;
+    if (!readFile(vertexPath, vertexSource)) {
+        std::cerr << "Failed to read shader: " << vertexPath << std::endl;
+        return false;
+    }
+    if (!readFile(fragmentPath, fragmentSource)) {
+        std::cerr << "Failed to read shader: " << fragmentPath << std::endl;
+        return false;
+    }
+    return loadFromSource(vertexSource, fragmentSource);
+}
+
+bool Shader::loadFromSource(const std::string& vertexSource, const std::string& fragmentSource) {
+    GLuint vertex = compileStage(GL_VERTEX_SHADER, vertexSource);
+    if (!vertex) return false;
+    GLuint fragment = compileStage(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!fragment) {
+        glDeleteShader(vertex);
+        return false;
+    }
+
+    GLuint linked = glCreateProgram();
+    glAttachShader(linked, vertex);
+    glAttachShader(linked, fragment);
+    glLinkProgram(linked);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    GLint success = 0;
+    glGetProgramiv(linked, GL_LINK_STATUS, &success);
+    if (!success) {
+        char log[1024];
+        glGetProgramInfoLog(linked, sizeof(log), nullptr, log);
+        std::cerr << "Shader program linking failed:\n" << log << std::endl;
+        glDeleteProgram(linked);
+        return false;
+    }
+
+    cleanup();
+    program = linked;
+    reflect();
+    return true;
+}
+
+void Shader::use() const {
+    glUseProgram(program);
+}
+
+void Shader::apply(PropertyBlock& properties) {
+    properties.apply(uniforms, [this](int32_t location, UniformType type, const void* value) {
+        upload(program, location, type, value);
+    });
+}
+
+void Shader::setInt(const std::string& name, int value) { writeByName(name, UniformType::Int, &value); }
+void Shader::setFloat(const std::string& name, float value) { writeByName(name, UniformType::Float, &value); }
+void Shader::setVec2(const std::string& name, const glm::vec2& value) { writeByName(name, UniformType::Vec2, &value); }
+void Shader::setVec3(const std::string& name, const glm::vec3& value) { writeByName(name, UniformType::Vec3, &value); }
+void Shader::setVec4(const std::string& name, const glm::vec4& value) { writeByName(name, UniformType::Vec4, &value); }
+void Shader::setMat3(const std::string& name, const glm::mat3& value) { writeByName(name, UniformType::Mat3, &value); }
+void Shader::setMat4(const std::string& name, const glm::mat4& value) { writeByName(name, UniformType::Mat4, &value); }
+
+// Arrays of plain types are reported once as "name[0]" with their length;
+// each element gets its own entry, and the bare name aliases element 0.
+// Struct arrays are already reported member by member.
+void Shader::reflect() {
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> nameBuffer(static_cast<size_t>(maxLength > 0 ? maxLength : 1));
+
+    std::vector<UniformInfo> reflected;
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum glType = 0;
+        glGetActiveUniform(program, static_cast<GLuint>(i), maxLength, &length, &size, &glType, nameBuffer.data());
+
+        UniformType type;
+        if (!toUniformType(glType, type)) continue;
+        std::string name(nameBuffer.data(), static_cast<size_t>(length));
+
+        // Uniform block members have no location and are not set this way
+        GLint location = glGetUniformLocation(program, name.c_str());
+        if (location < 0) continue;
+
+        const std::string arraySuffix = "[0]";
+        if (name.size() > arraySuffix.size() &&
+            name.compare(name.size() - arraySuffix.size(), arraySuffix.size(), arraySuffix) == 0) {
+            std::string base = name.substr(0, name.size() - arraySuffix.size());
+            reflected.push_back({ base, type, location });
+            for (GLint element = 0; element < size; ++element) {
+                std::string elementName = base + "[" + std::to_string(element) + "]";
+                GLint elementLocation = glGetUniformLocation(program, elementName.c_str());
+                if (elementLocation >= 0) reflected.push_back({ elementName, type, elementLocation });
+            }
+        } else {
+            reflected.push_back({ name, type, location });
+        }
+    }
+    uniforms.build(reflected);
+}
+
+void Shader::write(uint32_t id, UniformType type, const void* value) {
+    int32_t location = uniforms.write(id, type, value);
+    if (location >= 0) upload(program, location, type, value);
+}
+
+void Shader::writeByName(const std::string& name, UniformType type, const void* value) {
+    uint32_t id = UniformNames::find(name);
+    if (id != UniformNames::INVALID) write(id, type, value);
+}
+
+void Shader::cleanup() {
+    if (program) {
+        glDeleteProgram(program);
+        program = 0;
+    }
+    uniforms.clear();
+}
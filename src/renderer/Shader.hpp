@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "Uniforms.hpp"
+
+// A linked vertex + fragment program. Active uniforms are reflected once at
+// link time into a UniformTable, so writes are an array lookup by handle
+// rather than a glGetUniformLocation, and values the program already holds
+// are skipped. Uploads go through glProgramUniform* and do not need the
+// program to be in use.
+class Shader {
+public:
+    Shader();
+    ~Shader();
+
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    bool loadFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
+    bool loadFromSource(const std::string& vertexSource, const std::string& fragmentSource);
+
+    void use() const;
+    GLuint getID() const { return program; }
+
+    template<typename T>
+    void set(UniformHandle<T> handle, const T& value) {
+        write(handle.getId(), UniformTraits<T>::type, &value);
+    }
+
+    template<typename T>
+    bool hasUniform(UniformHandle<T> handle) const { return uniforms.getLocation(handle.getId()) >= 0; }
+
+    // Writes a material's values; see PropertyBlock::apply
+    void apply(PropertyBlock& properties);
+
+    // By name, for setup code and tools; per-frame code should hold handles
+    void setInt(const std::string& name, int value);
+    void setFloat(const std::string& name, float value);
+    void setVec2(const std::string& name, const glm::vec2& value);
+    void setVec3(const std::string& name, const glm::vec3& value);
+    void setVec4(const std::string& name, const glm::vec4& value);
+    void setMat3(const std::string& name, const glm::mat3& value);
+    void setMat4(const std::string& name, const glm::mat4& value);
+
+    const UniformTable& getUniforms() const { return uniforms; }
+
+private:
+    GLuint program;
+    UniformTable uniforms;
+
+    void reflect();
+    void write(uint32_t id, UniformType type, const void* value);
+    void writeByName(const std::string& name, UniformType type, const void* value);
+    void cleanup();
+};
@@ -47,6 +47,21 @@ bool Texture::loadFromData(unsigned char* data, int w, int h, Format fmt) {
     return true;
 }
 
+void Texture::update(const unsigned char* data) {
+    if (!data) return;
+
+    GLenum glFormat = GL_RGBA;
+    switch (format) {
+        case Format::RGB: glFormat = GL_RGB; break;
+        case Format::RGBA: glFormat = GL_RGBA; break;
+        case Format::Depth: glFormat = GL_DEPTH_COMPONENT; break;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, glFormat, GL_UNSIGNED_BYTE, data);
+    glGenerateMipmap(GL_TEXTURE_2D);
+}
+
 void Texture::bind(unsigned int unit) const {
     glActiveTexture(GL_TEXTURE0 + unit);
     glBindTexture(GL_TEXTURE_2D, textureID);
@@ -33,6 +33,8 @@ public:
 
     bool loadFromFile(const std::string& path);
     bool loadFromData(unsigned char* data, int width, int height, Format format);
+    // Replaces the whole image in place; data must match the current size and format
+    void update(const unsigned char* data);
     void bind(unsigned int unit = 0) const;
     void unbind() const;
 
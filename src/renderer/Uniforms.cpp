@@ -0,0 +1,132 @@
+#include "Uniforms.hpp"
+#include <cassert>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    struct NameRegistry {
+        std::mutex mutex;
+        std::unordered_map<std::string, uint32_t> ids;
+        std::deque<std::string> names; // Deque so getName's references stay valid
+    };
+
+    NameRegistry& getRegistry() {
+        static NameRegistry registry;
+        return registry;
+    }
+}
+
+size_t getUniformSize(UniformType type) {
+    switch (type) {
+        case UniformType::Float: return sizeof(float);
+        case UniformType::Int: return sizeof(int);
+        case UniformType::Vec2: return sizeof(glm::vec2);
+        case UniformType::Vec3: return sizeof(glm::vec3);
+        case UniformType::Vec4: return sizeof(glm::vec4);
+        case UniformType::Mat3: return sizeof(glm::mat3);
+        case UniformType::Mat4: return sizeof(glm::mat4);
+    }
+    return 0;
+}
+
+uint32_t UniformNames::intern(const std::string& name) {
+    NameRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto [it, inserted] = registry.ids.try_emplace(name, static_cast<uint32_t>(registry.names.size()));
+    if (inserted) registry.names.push_back(name);
+    return it->second;
+}
+
+uint32_t UniformNames::find(const std::string& name) {
+    NameRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.ids.find(name);
+    return it != registry.ids.end() ? it->second : INVALID;
+}
+
+const std::string& UniformNames::getName(uint32_t id) {
+    NameRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.names[id];
+}
+
+void UniformTable::build(const std::vector<UniformInfo>& uniforms) {
+    clear();
+    for (const UniformInfo& uniform : uniforms) {
+        uint32_t id = UniformNames::intern(uniform.name);
+        if (id >= slotOf.size()) slotOf.resize(id + 1, -1);
+        if (slotOf[id] >= 0) continue;
+
+        slotOf[id] = static_cast<int32_t>(slots.size());
+        slots.push_back({ uniform.location, uniform.type, false, static_cast<uint32_t>(values.size()) });
+        values.resize(values.size() + getUniformSize(uniform.type));
+    }
+}
+
+void UniformTable::clear() {
+    slotOf.clear();
+    slots.clear();
+    values.clear();
+    generation++;
+}
+
+int32_t UniformTable::getLocation(uint32_t id) const {
+    if (id >= slotOf.size() || slotOf[id] < 0) return -1;
+    return slots[slotOf[id]].location;
+}
+
+int32_t UniformTable::write(uint32_t id, UniformType type, const void* value) {
+    if (id >= slotOf.size() || slotOf[id] < 0) return -1;
+    Slot& slot = slots[slotOf[id]];
+    assert(slot.type == type && "Uniform written with a different type than the shader declares");
+    if (slot.type != type) return -1;
+
+    unsigned char* shadow = &values[slot.offset];
+    size_t size = getUniformSize(type);
+    if (slot.known && std::memcmp(shadow, value, size) == 0) return -1;
+
+    std::memcpy(shadow, value, size);
+    slot.known = true;
+    generation++;
+    return slot.location;
+}
+
+void PropertyBlock::setRaw(uint32_t id, UniformType type, const void* value) {
+    size_t size = getUniformSize(type);
+    for (Property& property : properties) {
+        if (property.id != id) continue;
+
+        unsigned char* stored = &values[property.offset];
+        if (property.type == type) {
+            if (std::memcmp(stored, value, size) == 0) return;
+        } else {
+            // Retyped: the old bytes are left unused
+            property.type = type;
+            property.offset = static_cast<uint32_t>(values.size());
+            values.resize(values.size() + size);
+            stored = &values[property.offset];
+        }
+        std::memcpy(stored, value, size);
+        property.dirty = true;
+        anyDirty = true;
+        return;
+    }
+
+    // Every type's size is a multiple of four, so values stay float-aligned
+    properties.push_back({ id, type, true, static_cast<uint32_t>(values.size()) });
+    values.resize(values.size() + size);
+    std::memcpy(&values[properties.back().offset], value, size);
+    anyDirty = true;
+}
+
+bool PropertyBlock::getRaw(uint32_t id, UniformType type, void* value) const {
+    for (const Property& property : properties) {
+        if (property.id == id && property.type == type) {
+            std::memcpy(value, &values[property.offset], getUniformSize(type));
+            return true;
+        }
+    }
+    return false;
+}
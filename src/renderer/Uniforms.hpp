@@ -0,0 +1,159 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Shader uniforms without strings on the hot path. Names are interned once
+// into process-wide ids; a UniformHandle<T> carries an id and the value
+// type, so the same handle addresses the uniform in every shader. Each
+// Shader reflects its active uniforms at link time into a UniformTable, and
+// each Material keeps its values in a PropertyBlock. None of this touches
+// GL, so the bookkeeping runs (and is benchmarked) without a GPU.
+enum class UniformType : uint8_t {
+    Float,
+    Int,    // Also bool and sampler uniforms
+    Vec2,
+    Vec3,
+    Vec4,
+    Mat3,
+    Mat4
+};
+
+size_t getUniformSize(UniformType type);
+
+template<typename T> struct UniformTraits;
+template<> struct UniformTraits<float> { static constexpr UniformType type = UniformType::Float; };
+template<> struct UniformTraits<int> { static constexpr UniformType type = UniformType::Int; };
+template<> struct UniformTraits<glm::vec2> { static constexpr UniformType type = UniformType::Vec2; };
+template<> struct UniformTraits<glm::vec3> { static constexpr UniformType type = UniformType::Vec3; };
+template<> struct UniformTraits<glm::vec4> { static constexpr UniformType type = UniformType::Vec4; };
+template<> struct UniformTraits<glm::mat3> { static constexpr UniformType type = UniformType::Mat3; };
+template<> struct UniformTraits<glm::mat4> { static constexpr UniformType type = UniformType::Mat4; };
+
+// Dense ids from 0 in interning order; thread-safe, ids never change
+class UniformNames {
+public:
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+    static uint32_t intern(const std::string& name);
+
+    // INVALID if the name was never interned, which means no shader uses it
+    static uint32_t find(const std::string& name);
+    static const std::string& getName(uint32_t id);
+};
+
+// Resolve once, typically as a static or member, and reuse every frame
+template<typename T>
+class UniformHandle {
+public:
+    UniformHandle() : id(UniformNames::INVALID) {}
+    explicit UniformHandle(const std::string& name) : id(UniformNames::intern(name)) {}
+
+    uint32_t getId() const { return id; }
+    bool isValid() const { return id != UniformNames::INVALID; }
+
+private:
+    uint32_t id;
+};
+
+struct UniformInfo {
+    std::string name;
+    UniformType type;
+    int32_t location;
+};
+
+// One program's active uniforms: the location of each by name id, and a
+// shadow copy of the value last written, so values the program already
+// holds are not sent again
+class UniformTable {
+public:
+    void build(const std::vector<UniformInfo>& uniforms);
+    void clear();
+
+    // -1 if the program has no such uniform
+    int32_t getLocation(uint32_t id) const;
+    size_t size() const { return slots.size(); }
+
+    // Records `value` as the uniform's current value. Returns the location
+    // to upload to, or -1 if the program lacks the uniform, the type does
+    // not match, or the program already holds the value.
+    int32_t write(uint32_t id, UniformType type, const void* value);
+
+    // Bumped by every write that changed a value
+    uint64_t getGeneration() const { return generation; }
+
+private:
+    struct Slot {
+        int32_t location;
+        UniformType type;
+        bool known;       // False until the first write; GLSL initialisers are not reflected
+        uint32_t offset;  // Into values
+    };
+
+    std::vector<int32_t> slotOf;  // By name id, -1 where unused
+    std::vector<Slot> slots;
+    std::vector<unsigned char> values;
+    uint64_t generation = 0;
+};
+
+// A material's uniform values in one flat buffer keyed by name id, with a
+// dirty flag per value. apply() writes only dirty values, unless something
+// else has written to the table since this block was last applied, in which
+// case every value goes through the table and its shadow copies filter out
+// the ones that still match.
+class PropertyBlock {
+public:
+    template<typename T>
+    void set(UniformHandle<T> handle, const T& value) {
+        setRaw(handle.getId(), UniformTraits<T>::type, &value);
+    }
+
+    // False if the block has no value of that type under the handle
+    template<typename T>
+    bool get(UniformHandle<T> handle, T& value) const {
+        return getRaw(handle.getId(), UniformTraits<T>::type, &value);
+    }
+
+    void setRaw(uint32_t id, UniformType type, const void* value);
+    bool getRaw(uint32_t id, UniformType type, void* value) const;
+
+    size_t size() const { return properties.size(); }
+
+    // Forces the next apply() to write every value, e.g. after a shader swap
+    void invalidate() { appliedTable = nullptr; }
+
+    // upload(int32_t location, UniformType type, const void* value) for each
+    // value the table reports as changed
+    template<typename Upload>
+    void apply(UniformTable& table, Upload&& upload) {
+        bool full = appliedTable != &table || appliedGeneration != table.getGeneration();
+        if (!full && !anyDirty) return;
+
+        for (Property& property : properties) {
+            if (!full && !property.dirty) continue;
+            property.dirty = false;
+            const unsigned char* value = &values[property.offset];
+            int32_t location = table.write(property.id, property.type, value);
+            if (location >= 0) upload(location, property.type, value);
+        }
+        anyDirty = false;
+        appliedTable = &table;
+        appliedGeneration = table.getGeneration();
+    }
+
+private:
+    struct Property {
+        uint32_t id;
+        UniformType type;
+        bool dirty;
+        uint32_t offset;  // Into values
+    };
+
+    std::vector<Property> properties;
+    std::vector<unsigned char> values;
+    bool anyDirty = false;
+    const UniformTable* appliedTable = nullptr;
+    uint64_t appliedGeneration = 0;
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Kept apart from Mesh.hpp so CPU-side mesh code does not pull in GL
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoords;
+    glm::vec3 tangent;
+    glm::vec3 bitangent;
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+// World-space axis-aligned box
+struct AABB {
+    glm::vec3 min;
+    glm::vec3 max;
+
+    AABB() : min(0.0f), max(0.0f) {}
+    AABB(const glm::vec3& min, const glm::vec3& max) : min(min), max(max) {}
+
+    glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+    glm::vec3 getExtents() const { return (max - min) * 0.5f; }
+
+    // Half the true surface area; only ever compared, so the factor is dropped
+    float getPerimeter() const {
+        glm::vec3 size = max - min;
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+
+    bool contains(const AABB& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+               other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+    }
+
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && other.min.x <= max.x &&
+               min.y <= other.max.y && other.min.y <= max.y &&
+               min.z <= other.max.z && other.min.z <= max.z;
+    }
+
+    bool overlapsSphere(const glm::vec3& center, float radius) const {
+        glm::vec3 closest = glm::clamp(center, min, max);
+        glm::vec3 offset = center - closest;
+        return glm::dot(offset, offset) <= radius * radius;
+    }
+
+    // Slab test. `inverseDirection` is 1/direction per axis (infinite for
+    // zero components). Returns the entry distance in `tEnter`, 0 if the
+    // origin is inside.
+    bool intersectRay(const glm::vec3& origin, const glm::vec3& inverseDirection,
+                      float maxDistance, float& tEnter) const {
+        glm::vec3 t0 = (min - origin) * inverseDirection;
+        glm::vec3 t1 = (max - origin) * inverseDirection;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+        float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+        tEnter = enter;
+        return enter <= exit;
+    }
+
+    // Bounds of this box after `matrix` (Arvo's method: no corner loop)
+    AABB transformed(const glm::mat4& matrix) const {
+        glm::vec3 center = glm::vec3(matrix * glm::vec4(getCenter(), 1.0f));
+        glm::vec3 extents = getExtents();
+        glm::vec3 worldExtents(0.0f);
+        for (int row = 0; row < 3; ++row) {
+            worldExtents[row] = std::abs(matrix[0][row]) * extents.x +
+                                std::abs(matrix[1][row]) * extents.y +
+                                std::abs(matrix[2][row]) * extents.z;
+        }
+        return AABB(center - worldExtents, center + worldExtents);
+    }
+
+    static AABB merge(const AABB& a, const AABB& b) {
+        return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+    }
+};
+
+// Six inward-facing planes (xyz normal, w distance) taken from a
+// view-projection matrix; a point p is inside a plane when dot(n, p) + w >= 0
+struct Frustum {
+    enum class Result {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
+    glm::vec4 planes[6];
+
+    // Gribb-Hartmann extraction for OpenGL clip space (-w <= z <= w)
+    static Frustum fromMatrix(const glm::mat4& viewProjection) {
+        glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+        glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+        glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+        glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+        Frustum frustum;
+        frustum.planes[0] = row3 + row0; // Left
+        frustum.planes[1] = row3 - row0; // Right
+        frustum.planes[2] = row3 + row1; // Bottom
+        frustum.planes[3] = row3 - row1; // Top
+        frustum.planes[4] = row3 + row2; // Near
+        frustum.planes[5] = row3 - row2; // Far
+        for (glm::vec4& plane : frustum.planes) {
+            plane /= glm::length(glm::vec3(plane));
+        }
+        return frustum;
+    }
+
+    // Conservative: boxes near a frustum corner may report Intersecting
+    // while lying just outside
+    Result classify(const AABB& box) const {
+        glm::vec3 center = box.getCenter();
+        glm::vec3 extents = box.getExtents();
+        Result result = Result::Inside;
+        for (const glm::vec4& plane : planes) {
+            glm::vec3 normal(plane);
+            float distance = glm::dot(normal, center) + plane.w;
+            float radius = glm::dot(glm::abs(normal), extents);
+            if (distance < -radius) return Result::Outside;
+            if (distance < radius) result = Result::Intersecting;
+        }
+        return result;
+    }
+
+    bool intersects(const AABB& box) const { return classify(box) != Result::Outside; }
+};
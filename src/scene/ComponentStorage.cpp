@@ -0,0 +1,314 @@
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+#include "../core/AllocationTracker.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    std::array<ComponentTypeInfo, MAX_COMPONENT_TYPES> registeredTypes;
+    ComponentTypeId nextDynamicTypeId = static_cast<ComponentTypeId>(EngineComponentTypes::size);
+
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+ComponentTypeId allocateComponentTypeId() {
+    assert(nextDynamicTypeId < MAX_COMPONENT_TYPES && "Too many component types");
+    return nextDynamicTypeId++;
+}
+
+// ComponentTypeRegistry implementation
+const ComponentTypeInfo& ComponentTypeRegistry::registerType(ComponentTypeId id, ComponentTypeInfo info) {
+    info.id = id;
+    registeredTypes[id] = info;
+    return registeredTypes[id];
+}
+
+const ComponentTypeInfo& ComponentTypeRegistry::get(ComponentTypeId id) {
+    return registeredTypes[id];
+}
+
+// Archetype implementation
+Archetype::Archetype(const ComponentSignature& sig, BlockPool& pool)
+    : signature(sig)
+    , chunkPool(pool)
+    , rowsPerChunk(1)
+    , entityCount(0)
+    , chunkBytes(CHUNK_SIZE)
+{
+    columnIndex.fill(-1);
+    for (size_t id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+        if (signature.test(id)) {
+            columnIndex[id] = static_cast<int8_t>(columns.size());
+            columns.push_back({ &ComponentTypeRegistry::get(static_cast<ComponentTypeId>(id)), 0 });
+        }
+    }
+    buildLayout();
+}
+
+Archetype::~Archetype() {
+    for (uint32_t row = 0; row < entityCount; ++row) {
+        destroyComponents(row);
+    }
+    for (auto& chunk : chunks) {
+        freeChunk(chunk.data);
+    }
+}
+
+void Archetype::buildLayout() {
+    size_t rowBytes = sizeof(Entity*);
+    for (const auto& column : columns) {
+        rowBytes += column.type->size;
+    }
+
+    // Fit as many rows as possible into one chunk, accounting for per-column padding
+    auto layoutSize = [this](uint32_t rows) {
+        size_t offset = sizeof(Entity*) * rows;
+        for (auto& column : columns) {
+            offset = alignUp(offset, column.type->alignment);
+            column.offset = offset;
+            offset += column.type->size * rows;
+        }
+        return offset;
+    };
+
+    uint32_t rows = static_cast<uint32_t>(std::max<size_t>(1, CHUNK_SIZE / rowBytes));
+    while (rows > 1 && layoutSize(rows) > CHUNK_SIZE) {
+        --rows;
+    }
+
+    rowsPerChunk = rows;
+    chunkBytes = std::max(CHUNK_SIZE, alignUp(layoutSize(rowsPerChunk), CHUNK_ALIGNMENT));
+}
+
+uint32_t Archetype::allocateRow(Entity* entity) {
+    uint32_t row = entityCount;
+    if (row / rowsPerChunk >= chunks.size()) {
+        MEMORY_TAG(Scene);
+        Chunk chunk;
+        chunk.data = allocateChunk();
+        chunks.push_back(chunk);
+    }
+
+    chunks[row / rowsPerChunk].count++;
+    entityCount++;
+    setEntity(row, entity);
+    return row;
+}
+
+Entity* Archetype::freeRow(uint32_t row) {
+    uint32_t last = entityCount - 1;
+    Entity* moved = nullptr;
+
+    if (row != last) {
+        // Swap-and-pop keeps every chunk densely packed
+        for (size_t c = 0; c < columns.size(); ++c) {
+            void* src = getComponent(static_cast<int>(c), last);
+            columns[c].type->moveConstruct(getComponent(static_cast<int>(c), row), src);
+            columns[c].type->destroy(src);
+        }
+        moved = getEntity(last);
+        setEntity(row, moved);
+    }
+
+    chunks[last / rowsPerChunk].count--;
+    entityCount--;
+
+    // Keep a single spare chunk around to avoid thrashing at chunk boundaries
+    while (chunks.size() > 1 && chunks.back().count == 0 && chunks[chunks.size() - 2].count == 0) {
+        freeChunk(chunks.back().data);
+        chunks.pop_back();
+    }
+
+    return moved;
+}
+
+void Archetype::destroyComponents(uint32_t row) {
+    for (size_t c = 0; c < columns.size(); ++c) {
+        columns[c].type->destroy(getComponent(static_cast<int>(c), row));
+    }
+}
+
+std::byte* Archetype::allocateChunk() {
+    if (chunkBytes == chunkPool.getBlockSize()) {
+        return static_cast<std::byte*>(chunkPool.allocate());
+    }
+    return static_cast<std::byte*>(::operator new(chunkBytes, std::align_val_t(CHUNK_ALIGNMENT)));
+}
+
+void Archetype::freeChunk(std::byte* data) {
+    if (chunkBytes == chunkPool.getBlockSize()) {
+        chunkPool.deallocate(data);
+    } else {
+        ::operator delete(data, std::align_val_t(CHUNK_ALIGNMENT));
+    }
+}
+
+void Archetype::setEntity(uint32_t row, Entity* entity) {
+    reinterpret_cast<Entity**>(chunks[row / rowsPerChunk].data)[row % rowsPerChunk] = entity;
+}
+
+// ComponentStorage implementation
+ComponentStorage::ComponentStorage()
+    : chunkPool(Archetype::CHUNK_SIZE, Archetype::CHUNK_ALIGNMENT, 16)
+{}
+
+Archetype* ComponentStorage::findOrCreateArchetype(const ComponentSignature& signature) {
+    auto it = archetypeLookup.find(signature);
+    if (it != archetypeLookup.end()) {
+        return it->second;
+    }
+
+    MEMORY_TAG(Scene);
+    archetypes.push_back(std::make_unique<Archetype>(signature, chunkPool));
+    Archetype* archetype = archetypes.back().get();
+    archetypeLookup[signature] = archetype;
+    return archetype;
+}
+
+const std::vector<Archetype*>& ComponentStorage::findArchetypes(const ComponentQuery& query) {
+    std::lock_guard<std::mutex> lock(queryMutex);
+
+    QueryCache& cache = queryCache[query];
+    for (; cache.scannedArchetypes < archetypes.size(); ++cache.scannedArchetypes) {
+        Archetype* archetype = archetypes[cache.scannedArchetypes].get();
+        if (query.matches(archetype->getSignature())) {
+            cache.archetypes.push_back(archetype);
+        }
+    }
+    return cache.archetypes;
+}
+
+void* ComponentStorage::moveToArchetype(Entity* entity, EntityLocation& location,
+                                        ComponentTypeId typeId, bool add) {
+    Archetype* source = location.archetype;
+    ComponentSignature signature = source ? source->getSignature() : ComponentSignature();
+    signature.set(typeId, add);
+
+    Archetype* target = findOrCreateArchetype(signature);
+    uint32_t newRow = target->allocateRow(entity);
+
+    if (source) {
+        // Move shared components across, drop the removed one
+        const auto& sourceColumns = source->getColumns();
+        for (size_t c = 0; c < sourceColumns.size(); ++c) {
+            void* src = source->getComponent(static_cast<int>(c), location.row);
+            int dstColumn = target->findColumn(sourceColumns[c].type->id);
+            if (dstColumn >= 0) {
+                sourceColumns[c].type->moveConstruct(target->getComponent(dstColumn, newRow), src);
+            }
+            sourceColumns[c].type->destroy(src);
+        }
+
+        Entity* moved = source->freeRow(location.row);
+        if (moved) {
+            relocated(moved, location.row);
+        }
+    }
+
+    location.archetype = target;
+    location.row = newRow;
+
+    return add ? target->getComponent(target->findColumn(typeId), newRow) : nullptr;
+}
+
+void ComponentStorage::addComponents(Entity* entity, EntityLocation& location,
+                                     const ComponentSignature& signature) {
+    assert(!location.archetype && "addComponents expects an entity without components");
+    if (signature.none()) return;
+
+    Archetype* archetype = findOrCreateArchetype(signature);
+    uint32_t row = archetype->allocateRow(entity);
+
+    const auto& columns = archetype->getColumns();
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const ComponentTypeInfo* type = columns[c].type;
+        assert(type->defaultConstruct && "Component type is not default-constructible");
+        void* storage = archetype->getComponent(static_cast<int>(c), row);
+        type->defaultConstruct(storage);
+        attach(type->asComponent(storage), entity);
+    }
+
+    location.archetype = archetype;
+    location.row = row;
+}
+
+EntityLocation ComponentStorage::addComponents(Entity* const* entities, size_t count,
+                                              const ComponentSignature& signature) {
+    if (signature.none() || count == 0) return EntityLocation();
+
+    Archetype* archetype = findOrCreateArchetype(signature);
+    uint32_t firstRow = archetype->getEntityCount();
+    for (size_t i = 0; i < count; ++i) {
+        EntityLocation& location = entities[i]->location;
+        assert(!location.archetype && "addComponents expects entities without components");
+        location.archetype = archetype;
+        location.row = archetype->allocateRow(entities[i]);
+    }
+
+    const auto& columns = archetype->getColumns();
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const ComponentTypeInfo* type = columns[c].type;
+        assert(type->defaultConstruct && "Component type is not default-constructible");
+        for (size_t i = 0; i < count; ++i) {
+            void* storage = archetype->getComponent(static_cast<int>(c), firstRow + static_cast<uint32_t>(i));
+            type->defaultConstruct(storage);
+            attach(type->asComponent(storage), entities[i]);
+        }
+    }
+
+    EntityLocation first;
+    first.archetype = archetype;
+    first.row = firstRow;
+    return first;
+}
+
+void ComponentStorage::cloneComponents(const EntityLocation& source, Entity* const* targets, size_t count) {
+    const Archetype* prototype = source.archetype;
+    if (!prototype || count == 0) return;
+
+    Archetype* archetype = findOrCreateArchetype(prototype->getSignature());
+    uint32_t firstRow = archetype->getEntityCount();
+    for (size_t i = 0; i < count; ++i) {
+        EntityLocation& location = targets[i]->location;
+        assert(!location.archetype && "cloneComponents expects entities without components");
+        location.archetype = archetype;
+        location.row = archetype->allocateRow(targets[i]);
+    }
+
+    // Both archetypes share the signature, so their columns line up
+    const auto& columns = archetype->getColumns();
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const ComponentTypeInfo* type = columns[c].type;
+        assert(type->copyConstruct && "Component type is not copy-constructible");
+        const void* original = prototype->getComponent(static_cast<int>(c), source.row);
+        for (size_t i = 0; i < count; ++i) {
+            void* storage = archetype->getComponent(static_cast<int>(c), firstRow + static_cast<uint32_t>(i));
+            type->copyConstruct(storage, original);
+            attach(type->asComponent(storage), targets[i]);
+        }
+    }
+}
+
+void ComponentStorage::removeEntity(EntityLocation& location) {
+    Archetype* archetype = location.archetype;
+    if (!archetype) return;
+
+    archetype->destroyComponents(location.row);
+    Entity* moved = archetype->freeRow(location.row);
+    if (moved) {
+        relocated(moved, location.row);
+    }
+
+    location.archetype = nullptr;
+    location.row = 0;
+}
+
+void ComponentStorage::relocated(Entity* moved, uint32_t row) {
+    moved->location.row = row;
+}
+
+void ComponentStorage::attach(Component* component, Entity* entity) {
+    component->entity = entity;
+}
@@ -0,0 +1,287 @@
+#pragma once
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../components/Component.hpp"
+#include "../core/Allocators.hpp"
+#include "ComponentTypes.hpp"
+
+class Entity;
+class Archetype;
+
+constexpr size_t MAX_COMPONENT_TYPES = 64;
+
+using ComponentSignature = std::bitset<MAX_COMPONENT_TYPES>;
+
+// Type-erased operations for a concrete component type. Archetype chunks store
+// components by value, so relocation and batched updates go through these.
+struct ComponentTypeInfo {
+    ComponentTypeId id;
+    size_t size;
+    size_t alignment;
+
+    void (*defaultConstruct)(void* ptr); // Null when T has no default constructor
+    void (*moveConstruct)(void* dst, void* src);
+    void (*copyConstruct)(void* dst, const void* src); // Null when T is not copy-constructible
+    void (*destroy)(void* ptr);
+    Component* (*asComponent)(void* ptr);
+
+    // Null when the type does not override Component::update/render
+    void (*updateRange)(std::byte* first, uint32_t count, float deltaTime);
+    void (*renderRange)(std::byte* first, uint32_t count);
+};
+
+class ComponentTypeRegistry {
+public:
+    template<typename T>
+    static const ComponentTypeInfo& get() {
+        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+        static const ComponentTypeInfo& info = registerType(getComponentTypeId<T>(), makeInfo<T>());
+        return info;
+    }
+
+    static const ComponentTypeInfo& get(ComponentTypeId id);
+
+private:
+    template<typename T>
+    static ComponentTypeInfo makeInfo() {
+        ComponentTypeInfo info{};
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        if constexpr (std::is_default_constructible<T>::value) {
+            info.defaultConstruct = [](void* ptr) { new (ptr) T(); };
+        }
+        info.moveConstruct = [](void* dst, void* src) {
+            new (dst) T(std::move(*static_cast<T*>(src)));
+        };
+        if constexpr (std::is_copy_constructible<T>::value) {
+            info.copyConstruct = [](void* dst, const void* src) {
+                new (dst) T(*static_cast<const T*>(src));
+            };
+        }
+        info.destroy = [](void* ptr) { static_cast<T*>(ptr)->~T(); };
+        info.asComponent = [](void* ptr) -> Component* { return static_cast<T*>(ptr); };
+
+        // Qualified calls: every element of a column is exactly T, so skip the vtable
+        if (!std::is_same<decltype(&T::update), void (Component::*)(float)>::value) {
+            info.updateRange = [](std::byte* first, uint32_t count, float deltaTime) {
+                T* components = reinterpret_cast<T*>(first);
+                for (uint32_t i = 0; i < count; ++i) {
+                    components[i].T::update(deltaTime);
+                }
+            };
+        }
+        if (!std::is_same<decltype(&T::render), void (Component::*)()>::value) {
+            info.renderRange = [](std::byte* first, uint32_t count) {
+                T* components = reinterpret_cast<T*>(first);
+                for (uint32_t i = 0; i < count; ++i) {
+                    components[i].T::render();
+                }
+            };
+        }
+        return info;
+    }
+
+    static const ComponentTypeInfo& registerType(ComponentTypeId id, ComponentTypeInfo info);
+};
+
+// Component filter for views: archetypes with every `required` type and
+// none of the `excluded` ones
+struct ComponentQuery {
+    ComponentSignature required;
+    ComponentSignature excluded;
+
+    bool matches(const ComponentSignature& signature) const {
+        return (signature & required) == required && (signature & excluded).none();
+    }
+
+    bool operator==(const ComponentQuery& other) const {
+        return required == other.required && excluded == other.excluded;
+    }
+};
+
+struct ComponentQueryHash {
+    size_t operator()(const ComponentQuery& query) const {
+        std::hash<ComponentSignature> hash;
+        return hash(query.required) * 31 + hash(query.excluded);
+    }
+};
+
+// Where an entity's components live: a row inside one archetype
+struct EntityLocation {
+    Archetype* archetype = nullptr;
+    uint32_t row = 0;
+};
+
+// All entities sharing a component signature. Rows are packed densely into
+// fixed-size chunks; inside a chunk every component type is its own
+// contiguous array (SoA), preceded by the owning Entity* of each row.
+class Archetype {
+public:
+    static constexpr size_t CHUNK_SIZE = 16 * 1024;
+    static constexpr size_t CHUNK_ALIGNMENT = 64;
+
+    struct Chunk {
+        std::byte* data = nullptr;
+        uint32_t count = 0;
+    };
+
+    struct Column {
+        const ComponentTypeInfo* type;
+        size_t offset; // Byte offset of this column's array inside a chunk
+    };
+
+    // Standard-size chunks come from `chunkPool`; oversized ones from the heap
+    Archetype(const ComponentSignature& signature, BlockPool& chunkPool);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    const ComponentSignature& getSignature() const { return signature; }
+    const std::vector<Column>& getColumns() const { return columns; }
+    const std::vector<Chunk>& getChunks() const { return chunks; }
+    uint32_t getRowsPerChunk() const { return rowsPerChunk; }
+    uint32_t getEntityCount() const { return entityCount; }
+
+    // Column lookup, -1 if the component type is not part of this archetype
+    int findColumn(ComponentTypeId id) const { return columnIndex[id]; }
+
+    void* getComponent(int column, uint32_t row) const {
+        const Chunk& chunk = chunks[row / rowsPerChunk];
+        return chunk.data + columns[column].offset + (row % rowsPerChunk) * columns[column].type->size;
+    }
+
+    Entity* getEntity(uint32_t row) const {
+        const Chunk& chunk = chunks[row / rowsPerChunk];
+        return reinterpret_cast<Entity**>(chunk.data)[row % rowsPerChunk];
+    }
+
+    std::byte* getColumnData(const Chunk& chunk, int column) const {
+        return chunk.data + columns[column].offset;
+    }
+
+    // Reserves a row with uninitialised component storage
+    uint32_t allocateRow(Entity* entity);
+
+    // Removes a row whose components have already been destroyed or moved out.
+    // The last row is moved into the hole; returns the entity that moved, if any.
+    Entity* freeRow(uint32_t row);
+
+    void destroyComponents(uint32_t row);
+
+private:
+    ComponentSignature signature;
+    std::vector<Column> columns;
+    std::array<int8_t, MAX_COMPONENT_TYPES> columnIndex; // Sparse type id -> column
+    std::vector<Chunk> chunks;
+    BlockPool& chunkPool;
+    uint32_t rowsPerChunk;
+    uint32_t entityCount;
+    size_t chunkBytes;
+
+    void buildLayout();
+    void setEntity(uint32_t row, Entity* entity);
+    std::byte* allocateChunk();
+    void freeChunk(std::byte* data);
+};
+
+// Owns every archetype of a scene and moves entities between them as their
+// component signature changes.
+class ComponentStorage {
+public:
+    ComponentStorage();
+    ~ComponentStorage() = default;
+
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    template<typename T, typename... Args>
+    T* addComponent(Entity* entity, EntityLocation& location, Args&&... args) {
+        const ComponentTypeInfo& type = ComponentTypeRegistry::get<T>();
+        if (location.archetype && location.archetype->findColumn(type.id) >= 0) {
+            return getComponent<T>(location);
+        }
+
+        void* storage = moveToArchetype(entity, location, type.id, true);
+        T* component = new (storage) T(std::forward<Args>(args)...);
+        attach(component, entity);
+        return component;
+    }
+
+    // Constant time: compile-time type id -> sparse column index -> chunk slot
+    template<typename T>
+    T* getComponent(const EntityLocation& location) const {
+        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+        if (!location.archetype) return nullptr;
+        int column = location.archetype->findColumn(getComponentTypeId<T>());
+        if (column < 0) return nullptr;
+        return static_cast<T*>(location.archetype->getComponent(column, location.row));
+    }
+
+    template<typename T>
+    void removeComponent(Entity* entity, EntityLocation& location) {
+        ComponentTypeId id = getComponentTypeId<T>();
+        if (location.archetype && location.archetype->findColumn(id) >= 0) {
+            moveToArchetype(entity, location, id, false);
+        }
+    }
+
+    void removeEntity(EntityLocation& location);
+
+    // Places an entity that has no components yet straight into the archetype
+    // for `signature`, default-constructing every component. Bulk loaders use
+    // this to skip the archetype-per-component moves of addComponent.
+    void addComponents(Entity* entity, EntityLocation& location, const ComponentSignature& signature);
+
+    // The same for `count` entities at once. Their rows are reserved back to
+    // back and filled column by column; returns the first entity's location,
+    // the rest follow it row by row.
+    EntityLocation addComponents(Entity* const* entities, size_t count, const ComponentSignature& signature);
+
+    // Copy-constructs the components at `source`, which may live in another
+    // storage, into each of `targets`. The targets must have no components.
+    // Rows are reserved first and then filled column by column, so each
+    // component type is copied in one pass over contiguous memory.
+    void cloneComponents(const EntityLocation& source, Entity* const* targets, size_t count);
+
+    const std::vector<std::unique_ptr<Archetype>>& getArchetypes() const { return archetypes; }
+
+    // Archetypes matching `query`, cached per query. Archetypes are never
+    // destroyed, so a cached list only has to pick up archetypes created
+    // since it was last used. Safe to call from concurrent systems; the
+    // returned list stays valid until the next structural change.
+    const std::vector<Archetype*>& findArchetypes(const ComponentQuery& query);
+
+private:
+    struct QueryCache {
+        std::vector<Archetype*> archetypes;
+        size_t scannedArchetypes = 0;
+    };
+
+    // Chunks are recycled across all archetypes of the scene; declared first
+    // so it outlives them
+    BlockPool chunkPool;
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::unordered_map<ComponentSignature, Archetype*> archetypeLookup;
+
+    std::mutex queryMutex;
+    std::unordered_map<ComponentQuery, QueryCache, ComponentQueryHash> queryCache;
+
+    Archetype* findOrCreateArchetype(const ComponentSignature& signature);
+
+    // Relocates the entity into the archetype with `typeId` added or removed.
+    // When adding, returns the uninitialised storage for the new component.
+    void* moveToArchetype(Entity* entity, EntityLocation& location, ComponentTypeId typeId, bool add);
+    void relocated(Entity* moved, uint32_t row);
+
+    static void attach(Component* component, Entity* entity);
+};
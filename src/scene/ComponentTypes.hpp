@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+using ComponentTypeId = uint32_t;
+
+class Transform;
+class Camera;
+class Light;
+class MeshRenderer;
+class RigidBody;
+class BoxCollider;
+class SphereCollider;
+class CapsuleCollider;
+class FPSController;
+class AIController;
+class WeaponSystem;
+class HealthSystem;
+class VisualEffects;
+
+template<typename... Ts>
+struct TypeList {
+    static constexpr size_t size = sizeof...(Ts);
+};
+
+// Index of T inside a TypeList, or `size` when absent
+template<typename T, typename List>
+struct TypeListIndex;
+
+template<typename T>
+struct TypeListIndex<T, TypeList<>> {
+    static constexpr size_t value = 0;
+};
+
+template<typename T, typename Head, typename... Tail>
+struct TypeListIndex<T, TypeList<Head, Tail...>> {
+    static constexpr size_t value = std::is_same<T, Head>::value
+        ? 0 : 1 + TypeListIndex<T, TypeList<Tail...>>::value;
+};
+
+// Engine components get fixed ids known at compile time. Lookups are by exact
+// type, so concrete collider types are listed individually.
+using EngineComponentTypes = TypeList<
+    Transform,
+    Camera,
+    Light,
+    MeshRenderer,
+    RigidBody,
+    BoxCollider,
+    SphereCollider,
+    CapsuleCollider,
+    FPSController,
+    AIController,
+    WeaponSystem,
+    HealthSystem,
+    VisualEffects
+>;
+
+template<typename T>
+constexpr bool isEngineComponentType() {
+    return TypeListIndex<T, EngineComponentTypes>::value < EngineComponentTypes::size;
+}
+
+// Ids for game-defined components are handed out after the engine range
+ComponentTypeId allocateComponentTypeId();
+
+template<typename T>
+inline ComponentTypeId getComponentTypeId() {
+    if constexpr (isEngineComponentType<T>()) {
+        return static_cast<ComponentTypeId>(TypeListIndex<T, EngineComponentTypes>::value);
+    } else {
+        static const ComponentTypeId id = allocateComponentTypeId();
+        return id;
+    }
+}
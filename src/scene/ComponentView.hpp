@@ -0,0 +1,151 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "ComponentStorage.hpp"
+
+// Iterates every entity that has all of T... and none of the excluded
+// types. Matching archetypes come from the storage's query cache; iteration
+// then walks their chunks column by column with no per-entity lookups.
+//
+// Component references are only valid until the next structural change, so
+// do not add/remove components or entities while iterating (record them in
+// the scene's command buffer instead).
+template<typename... T>
+class ComponentView {
+    static_assert(sizeof...(T) > 0, "A view needs at least one component type");
+
+public:
+    explicit ComponentView(ComponentStorage& storage, const ComponentQuery& baseQuery = ComponentQuery())
+        : storage(&storage)
+        , query(baseQuery)
+    {
+        (query.required.set(getComponentTypeId<T>()), ...);
+        archetypes = &storage.findArchetypes(query);
+    }
+
+    // Same view, additionally skipping entities that have any of U...
+    template<typename... U>
+    ComponentView exclude() const {
+        ComponentQuery excluding = query;
+        (excluding.excluded.set(getComponentTypeId<U>()), ...);
+        return ComponentView(*storage, excluding);
+    }
+
+    // Calls fn(Entity*, T&...) for every match. Prefer this over the
+    // iterators in hot loops: the inner loop runs over one chunk at a time.
+    template<typename Function>
+    void each(Function&& fn) const {
+        eachImpl(fn, std::index_sequence_for<T...>());
+    }
+
+    size_t count() const {
+        size_t total = 0;
+        for (Archetype* archetype : *archetypes) {
+            total += archetype->getEntityCount();
+        }
+        return total;
+    }
+
+    bool empty() const { return count() == 0; }
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::tuple<Entity*, T&...>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        Iterator(const std::vector<Archetype*>* archetypes, size_t archetypeIndex)
+            : archetypes(archetypes)
+            , archetypeIndex(archetypeIndex)
+            , chunkIndex(0)
+            , row(0)
+            , rowCount(0)
+            , entities(nullptr)
+        {
+            seek();
+        }
+
+        value_type operator*() const {
+            return dereference(std::index_sequence_for<T...>());
+        }
+
+        Iterator& operator++() {
+            if (++row < rowCount) return *this;
+            row = 0;
+            ++chunkIndex;
+            seek();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return archetypeIndex == other.archetypeIndex && chunkIndex == other.chunkIndex && row == other.row;
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        const std::vector<Archetype*>* archetypes;
+        size_t archetypeIndex;
+        size_t chunkIndex;
+        uint32_t row;
+        uint32_t rowCount;
+        Entity* const* entities;
+        std::tuple<T*...> columns;
+
+        // Moves to the next non-empty chunk at or after the current position.
+        // Chunks are packed, so the first empty one ends its archetype.
+        void seek() {
+            while (archetypeIndex < archetypes->size()) {
+                Archetype* archetype = (*archetypes)[archetypeIndex];
+                const auto& chunks = archetype->getChunks();
+                if (chunkIndex < chunks.size() && chunks[chunkIndex].count > 0) {
+                    loadChunk(*archetype, chunks[chunkIndex]);
+                    return;
+                }
+                ++archetypeIndex;
+                chunkIndex = 0;
+            }
+            rowCount = 0;
+        }
+
+        void loadChunk(const Archetype& archetype, const Archetype::Chunk& chunk) {
+            rowCount = chunk.count;
+            entities = reinterpret_cast<Entity* const*>(chunk.data);
+            columns = std::tuple<T*...>(reinterpret_cast<T*>(
+                archetype.getColumnData(chunk, archetype.findColumn(getComponentTypeId<T>())))...);
+        }
+
+        template<size_t... I>
+        value_type dereference(std::index_sequence<I...>) const {
+            return value_type(entities[row], std::get<I>(columns)[row]...);
+        }
+    };
+
+    Iterator begin() const { return Iterator(archetypes, 0); }
+    Iterator end() const { return Iterator(archetypes, archetypes->size()); }
+
+private:
+    ComponentStorage* storage;
+    ComponentQuery query;
+    const std::vector<Archetype*>* archetypes;
+
+    template<typename Function, size_t... I>
+    void eachImpl(Function& fn, std::index_sequence<I...>) const {
+        for (Archetype* archetype : *archetypes) {
+            int columnIndices[] = { archetype->findColumn(getComponentTypeId<T>())... };
+            for (const auto& chunk : archetype->getChunks()) {
+                if (chunk.count == 0) break;
+
+                Entity* const* entities = reinterpret_cast<Entity* const*>(chunk.data);
+                std::tuple<T*...> columns(reinterpret_cast<T*>(archetype->getColumnData(chunk, columnIndices[I]))...);
+                for (uint32_t row = 0; row < chunk.count; ++row) {
+                    fn(entities[row], std::get<I>(columns)[row]...);
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,191 @@
+#include "CullingSet.hpp"
+#include "../core/Profiler.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CULLING_SET_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CULLING_SET_SSE2 1
+#endif
+
+namespace {
+    // Plane coefficients split out once per cull, with |n| precomputed
+    struct CullPlane {
+        float nx, ny, nz, w;
+        float ax, ay, az;
+    };
+
+    void pushVisible(uint32_t mask, uint32_t width, uint32_t base, std::vector<uint32_t>& visible) {
+        for (uint32_t lane = 0; lane < width; ++lane) {
+            if (mask & (1u << lane)) visible.push_back(base + lane);
+        }
+    }
+}
+
+uint32_t CullingSet::add(const AABB& bounds, uint32_t key) {
+    glm::vec3 center = bounds.getCenter();
+    glm::vec3 extents = bounds.getExtents();
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    extentX.push_back(extents.x);
+    extentY.push_back(extents.y);
+    extentZ.push_back(extents.z);
+    keys.push_back(key);
+    return static_cast<uint32_t>(keys.size() - 1);
+}
+
+void CullingSet::update(uint32_t index, const AABB& bounds) {
+    glm::vec3 center = bounds.getCenter();
+    glm::vec3 extents = bounds.getExtents();
+    centerX[index] = center.x;
+    centerY[index] = center.y;
+    centerZ[index] = center.z;
+    extentX[index] = extents.x;
+    extentY[index] = extents.y;
+    extentZ[index] = extents.z;
+}
+
+uint32_t CullingSet::remove(uint32_t index) {
+    uint32_t last = static_cast<uint32_t>(keys.size() - 1);
+    uint32_t movedKey = NO_KEY;
+    if (index != last) {
+        centerX[index] = centerX[last];
+        centerY[index] = centerY[last];
+        centerZ[index] = centerZ[last];
+        extentX[index] = extentX[last];
+        extentY[index] = extentY[last];
+        extentZ[index] = extentZ[last];
+        keys[index] = keys[last];
+        movedKey = keys[index];
+    }
+
+    centerX.pop_back();
+    centerY.pop_back();
+    centerZ.pop_back();
+    extentX.pop_back();
+    extentY.pop_back();
+    extentZ.pop_back();
+    keys.pop_back();
+    return movedKey;
+}
+
+void CullingSet::clear() {
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+    keys.clear();
+}
+
+AABB CullingSet::getBounds(uint32_t index) const {
+    glm::vec3 center(centerX[index], centerY[index], centerZ[index]);
+    glm::vec3 extents(extentX[index], extentY[index], extentZ[index]);
+    return AABB(center - extents, center + extents);
+}
+
+// Same test as Frustum::classify, reduced to outside or not: a box is
+// outside when, for some plane, dot(n, c) + w + dot(|n|, e) < 0. Each SIMD
+// lane runs all six planes on one box; NaN bounds never compare as outside,
+// so they stay visible as they would in the tree.
+CullingSet::Stats CullingSet::cull(const Frustum& frustum, std::vector<uint32_t>& visible) const {
+    PROFILE_SCOPE("CullingSet::cull");
+    CullPlane planes[6];
+    for (int p = 0; p < 6; ++p) {
+        const glm::vec4& plane = frustum.planes[p];
+        planes[p] = { plane.x, plane.y, plane.z, plane.w,
+                      std::abs(plane.x), std::abs(plane.y), std::abs(plane.z) };
+    }
+
+    const uint32_t count = static_cast<uint32_t>(keys.size());
+    const size_t visibleBefore = visible.size();
+    uint32_t i = 0;
+
+#if defined(CULLING_SET_AVX)
+    __m256 nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+    for (int p = 0; p < 6; ++p) {
+        nx[p] = _mm256_set1_ps(planes[p].nx);
+        ny[p] = _mm256_set1_ps(planes[p].ny);
+        nz[p] = _mm256_set1_ps(planes[p].nz);
+        nw[p] = _mm256_set1_ps(planes[p].w);
+        ax[p] = _mm256_set1_ps(planes[p].ax);
+        ay[p] = _mm256_set1_ps(planes[p].ay);
+        az[p] = _mm256_set1_ps(planes[p].az);
+    }
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 cx = _mm256_loadu_ps(&centerX[i]);
+        __m256 cy = _mm256_loadu_ps(&centerY[i]);
+        __m256 cz = _mm256_loadu_ps(&centerZ[i]);
+        __m256 ex = _mm256_loadu_ps(&extentX[i]);
+        __m256 ey = _mm256_loadu_ps(&extentY[i]);
+        __m256 ez = _mm256_loadu_ps(&extentZ[i]);
+
+        __m256 outside = zero;
+        for (int p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx[p], cx), _mm256_mul_ps(ny[p], cy)),
+                                            _mm256_add_ps(_mm256_mul_ps(nz[p], cz), nw[p]));
+            __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax[p], ex), _mm256_mul_ps(ay[p], ey)),
+                                          _mm256_mul_ps(az[p], ez));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_LT_OQ));
+        }
+
+        uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+        if (mask) pushVisible(mask, 8, i, visible);
+    }
+#elif defined(CULLING_SET_SSE2)
+    __m128 nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+    for (int p = 0; p < 6; ++p) {
+        nx[p] = _mm_set1_ps(planes[p].nx);
+        ny[p] = _mm_set1_ps(planes[p].ny);
+        nz[p] = _mm_set1_ps(planes[p].nz);
+        nw[p] = _mm_set1_ps(planes[p].w);
+        ax[p] = _mm_set1_ps(planes[p].ax);
+        ay[p] = _mm_set1_ps(planes[p].ay);
+        az[p] = _mm_set1_ps(planes[p].az);
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 cx = _mm_loadu_ps(&centerX[i]);
+        __m128 cy = _mm_loadu_ps(&centerY[i]);
+        __m128 cz = _mm_loadu_ps(&centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&extentX[i]);
+        __m128 ey = _mm_loadu_ps(&extentY[i]);
+        __m128 ez = _mm_loadu_ps(&extentZ[i]);
+
+        __m128 outside = zero;
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx), _mm_mul_ps(ny[p], cy)),
+                                         _mm_add_ps(_mm_mul_ps(nz[p], cz), nw[p]));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)),
+                                       _mm_mul_ps(az[p], ez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xFu;
+        if (mask) pushVisible(mask, 4, i, visible);
+    }
+#endif
+
+    // Scalar fallback, and the tail that does not fill a register. Evaluated
+    // in the same order as the SIMD lanes so both agree bit for bit.
+    for (; i < count; ++i) {
+        bool outside = false;
+        for (const CullPlane& plane : planes) {
+            float distance = (plane.nx * centerX[i] + plane.ny * centerY[i]) + (plane.nz * centerZ[i] + plane.w);
+            float radius = (plane.ax * extentX[i] + plane.ay * extentY[i]) + plane.az * extentZ[i];
+            outside |= distance + radius < 0.0f;
+        }
+        if (!outside) visible.push_back(i);
+    }
+
+    Stats stats;
+    stats.tested = count;
+    stats.visible = static_cast<uint32_t>(visible.size() - visibleBefore);
+    return stats;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Bounds.hpp"
+
+// Exact world-space boxes in structure-of-arrays form, tested against a
+// frustum several at a time. Each box is stored as center and extents in
+// six float arrays, so one SIMD load brings in the same coordinate of four
+// boxes (SSE) or eight (AVX, when built with ENGINE_AVX). Boxes are kept
+// dense by swap-and-pop; each carries a caller key to map it back.
+//
+// Unlike DynamicAABBTree there is no hierarchy to skip whole regions, but
+// also no fat margins and no pointer chasing: the cost is a flat, branch-
+// free pass over memory, which wins when a good share of the set is in
+// view or the boxes move every frame.
+class CullingSet {
+public:
+    static constexpr uint32_t NO_KEY = 0xFFFFFFFFu;
+
+    struct Stats {
+        uint32_t tested = 0;
+        uint32_t visible = 0;
+
+        uint32_t getCulled() const { return tested - visible; }
+    };
+
+    // Returns the box's index, valid until a remove() moves it
+    uint32_t add(const AABB& bounds, uint32_t key);
+    void update(uint32_t index, const AABB& bounds);
+
+    // Moves the last box into `index`; returns that box's key so the caller
+    // can repoint it, or NO_KEY if `index` was the last box
+    uint32_t remove(uint32_t index);
+
+    void clear();
+    size_t size() const { return keys.size(); }
+
+    uint32_t getKey(uint32_t index) const { return keys[index]; }
+    AABB getBounds(uint32_t index) const;
+
+    // Appends the index of every box that intersects the frustum
+    Stats cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+private:
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+    std::vector<uint32_t> keys;
+};
@@ -0,0 +1,241 @@
+#include "DynamicAABBTree.hpp"
+#include <cassert>
+
+DynamicAABBTree::DynamicAABBTree()
+    : root(NULL_NODE)
+    , freeList(NULL_NODE)
+    , proxyCount(0)
+{}
+
+int32_t DynamicAABBTree::createProxy(const AABB& bounds, void* userData) {
+    int32_t proxy = allocateNode();
+    Node& node = nodes[proxy];
+    node.bounds = AABB(bounds.min - glm::vec3(MARGIN), bounds.max + glm::vec3(MARGIN));
+    node.userData = userData;
+    node.height = 0;
+
+    insertLeaf(proxy);
+    proxyCount++;
+    return proxy;
+}
+
+void DynamicAABBTree::destroyProxy(int32_t proxy) {
+    assert(proxy >= 0 && proxy < static_cast<int32_t>(nodes.size()) && nodes[proxy].isLeaf());
+    removeLeaf(proxy);
+    freeNode(proxy);
+    proxyCount--;
+}
+
+bool DynamicAABBTree::moveProxy(int32_t proxy, const AABB& bounds, const glm::vec3& displacement) {
+    assert(proxy >= 0 && proxy < static_cast<int32_t>(nodes.size()) && nodes[proxy].isLeaf());
+    if (nodes[proxy].bounds.contains(bounds)) {
+        return false;
+    }
+
+    // Pad, then stretch towards where the object is heading so steady motion
+    // does not reinsert every tick
+    AABB fat(bounds.min - glm::vec3(MARGIN), bounds.max + glm::vec3(MARGIN));
+    glm::vec3 stretch = displacement * DISPLACEMENT_MULTIPLIER;
+    fat.min += glm::min(stretch, glm::vec3(0.0f));
+    fat.max += glm::max(stretch, glm::vec3(0.0f));
+
+    removeLeaf(proxy);
+    nodes[proxy].bounds = fat;
+    insertLeaf(proxy);
+    return true;
+}
+
+void DynamicAABBTree::clear() {
+    nodes.clear();
+    root = NULL_NODE;
+    freeList = NULL_NODE;
+    proxyCount = 0;
+}
+
+float DynamicAABBTree::getAreaRatio() const {
+    if (root == NULL_NODE) return 0.0f;
+
+    float rootArea = nodes[root].bounds.getPerimeter();
+    float totalArea = 0.0f;
+    for (const Node& node : nodes) {
+        if (node.height >= 0) totalArea += node.bounds.getPerimeter();
+    }
+    return rootArea > 0.0f ? totalArea / rootArea : 0.0f;
+}
+
+int32_t DynamicAABBTree::allocateNode() {
+    int32_t index;
+    if (freeList != NULL_NODE) {
+        index = freeList;
+        freeList = nodes[index].parent;
+    } else {
+        index = static_cast<int32_t>(nodes.size());
+        nodes.emplace_back();
+    }
+
+    Node& node = nodes[index];
+    node.userData = nullptr;
+    node.parent = NULL_NODE;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = 0;
+    return index;
+}
+
+void DynamicAABBTree::freeNode(int32_t index) {
+    nodes[index].parent = freeList;
+    nodes[index].height = -1;
+    freeList = index;
+}
+
+void DynamicAABBTree::insertLeaf(int32_t leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend to the sibling that minimises the added surface area. Going
+    // down a level costs the growth of every node already passed.
+    const AABB leafBounds = nodes[leaf].bounds;
+    int32_t index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node& node = nodes[index];
+        float area = node.bounds.getPerimeter();
+        float combinedArea = AABB::merge(node.bounds, leafBounds).getPerimeter();
+
+        // Cost of making a new parent for this node and the leaf
+        float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            const Node& childNode = nodes[child];
+            float merged = AABB::merge(leafBounds, childNode.bounds).getPerimeter();
+            if (childNode.isLeaf()) return merged + inheritanceCost;
+            return merged - childNode.bounds.getPerimeter() + inheritanceCost;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+    int32_t sibling = index;
+
+    // New parent takes the sibling's place
+    int32_t oldParent = nodes[sibling].parent;
+    int32_t newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].bounds = AABB::merge(leafBounds, nodes[sibling].bounds);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        root = newParent;
+    } else if (nodes[oldParent].child1 == sibling) {
+        nodes[oldParent].child1 = newParent;
+    } else {
+        nodes[oldParent].child2 = newParent;
+    }
+
+    refitAncestors(nodes[leaf].parent);
+}
+
+void DynamicAABBTree::removeLeaf(int32_t leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    // The leaf's sibling replaces their parent
+    int32_t parent = nodes[leaf].parent;
+    int32_t grandParent = nodes[parent].parent;
+    int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    if (nodes[grandParent].child1 == parent) {
+        nodes[grandParent].child1 = sibling;
+    } else {
+        nodes[grandParent].child2 = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refitAncestors(grandParent);
+}
+
+// Rebalances and refits from `index` up to the root
+void DynamicAABBTree::refitAncestors(int32_t index) {
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        Node& node = nodes[index];
+        const Node& child1 = nodes[node.child1];
+        const Node& child2 = nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.bounds = AABB::merge(child1.bounds, child2.bounds);
+
+        index = node.parent;
+    }
+}
+
+// If one child of A is two or more levels taller than the other, rotate
+// the taller child C up into A's place, with A taking C's shorter child.
+// Returns the index now at A's position.
+int32_t DynamicAABBTree::balance(int32_t a) {
+    Node& nodeA = nodes[a];
+    if (nodeA.isLeaf() || nodeA.height < 2) {
+        return a;
+    }
+
+    int32_t b = nodeA.child1;
+    int32_t c = nodeA.child2;
+    int32_t skew = nodes[c].height - nodes[b].height;
+    if (skew >= -1 && skew <= 1) {
+        return a;
+    }
+
+    // `up` is the taller child, `down` the shorter one that stays under A
+    int32_t up = skew > 1 ? c : b;
+    int32_t down = skew > 1 ? b : c;
+    Node& nodeUp = nodes[up];
+    int32_t f = nodeUp.child1;
+    int32_t g = nodeUp.child2;
+
+    // Swap A and its taller child
+    nodeUp.child1 = a;
+    nodeUp.parent = nodeA.parent;
+    nodeA.parent = up;
+
+    if (nodeUp.parent == NULL_NODE) {
+        root = up;
+    } else if (nodes[nodeUp.parent].child1 == a) {
+        nodes[nodeUp.parent].child1 = up;
+    } else {
+        nodes[nodeUp.parent].child2 = up;
+    }
+
+    // The taller grandchild stays with `up`, the shorter one moves under A
+    int32_t keep = nodes[f].height > nodes[g].height ? f : g;
+    int32_t give = keep == f ? g : f;
+    nodeUp.child2 = keep;
+    nodeA.child1 = down;
+    nodeA.child2 = give;
+    nodes[give].parent = a;
+
+    nodeA.bounds = AABB::merge(nodes[down].bounds, nodes[give].bounds);
+    nodeA.height = 1 + std::max(nodes[down].height, nodes[give].height);
+    nodeUp.bounds = AABB::merge(nodeA.bounds, nodes[keep].bounds);
+    nodeUp.height = 1 + std::max(nodeA.height, nodes[keep].height);
+    return up;
+}
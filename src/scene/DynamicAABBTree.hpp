@@ -0,0 +1,196 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Bounds.hpp"
+
+// Bounding volume hierarchy over moving boxes, in the style of Box2D's
+// b2DynamicTree. Leaves store a "fat" box padded by a margin, so an object
+// that moves a little keeps its leaf and costs nothing; only when it leaves
+// its fat box is it removed and reinserted. Insertion picks the sibling by
+// surface-area cost and every ancestor on the way back up is rebalanced
+// with AVL-style rotations, so the tree stays shallow without full rebuilds.
+//
+// Queries are templates taking a callback per overlapping leaf; they
+// allocate nothing unless the tree is deeper than the inline stack.
+class DynamicAABBTree {
+public:
+    static constexpr int32_t NULL_NODE = -1;
+
+    // Padding on each side of a leaf's fat box
+    static constexpr float MARGIN = 0.2f;
+    // Fat boxes are stretched along the movement by this multiple of it
+    static constexpr float DISPLACEMENT_MULTIPLIER = 2.0f;
+
+    DynamicAABBTree();
+
+    int32_t createProxy(const AABB& bounds, void* userData);
+    void destroyProxy(int32_t proxy);
+
+    // Returns true if the proxy was reinserted, false if `bounds` still fit
+    // its fat box
+    bool moveProxy(int32_t proxy, const AABB& bounds, const glm::vec3& displacement);
+
+    void* getUserData(int32_t proxy) const { return nodes[proxy].userData; }
+    const AABB& getFatBounds(int32_t proxy) const { return nodes[proxy].bounds; }
+
+    void clear();
+
+    size_t getProxyCount() const { return proxyCount; }
+    // Levels below the root; 0 for a single leaf, -1 when empty
+    int getHeight() const { return root == NULL_NODE ? -1 : nodes[root].height; }
+    // Summed node area over root area; grows as the tree degrades
+    float getAreaRatio() const;
+
+    // callback(int32_t proxy) -> bool; return false to stop early
+    template<typename Callback>
+    void query(const AABB& bounds, Callback&& callback) const {
+        traverse([&bounds](const AABB& node) { return node.overlaps(bounds); }, callback);
+    }
+
+    template<typename Callback>
+    void querySphere(const glm::vec3& center, float radius, Callback&& callback) const {
+        traverse([&center, radius](const AABB& node) { return node.overlapsSphere(center, radius); }, callback);
+    }
+
+    // Subtrees wholly inside the frustum are reported without further plane tests
+    template<typename Callback>
+    void queryFrustum(const Frustum& frustum, Callback&& callback) const {
+        NodeStack stack;
+        stack.push(root);
+        while (!stack.empty()) {
+            int32_t index = stack.pop();
+            if (index == NULL_NODE) continue;
+
+            const Node& node = nodes[index];
+            Frustum::Result result = frustum.classify(node.bounds);
+            if (result == Frustum::Result::Outside) continue;
+
+            if (result == Frustum::Result::Inside) {
+                if (!reportSubtree(index, callback)) return;
+            } else if (node.isLeaf()) {
+                if (!callback(index)) return;
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    // Walks leaves whose boxes the ray enters before `maxDistance`.
+    // `direction` must be normalised. callback(int32_t proxy, float maxDistance)
+    // returns the distance to clip the ray to: the hit distance for a closer
+    // hit, the passed value to carry on, 0 to stop.
+    template<typename Callback>
+    void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const {
+        glm::vec3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+        NodeStack stack;
+        stack.push(root);
+        while (!stack.empty()) {
+            int32_t index = stack.pop();
+            if (index == NULL_NODE) continue;
+
+            const Node& node = nodes[index];
+            float enter;
+            if (!node.bounds.intersectRay(origin, inverseDirection, maxDistance, enter)) continue;
+
+            if (node.isLeaf()) {
+                float clipped = callback(index, maxDistance);
+                if (clipped <= 0.0f) return;
+                maxDistance = std::min(maxDistance, clipped);
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+private:
+    struct Node {
+        AABB bounds;          // Fat box for leaves, union of children otherwise
+        void* userData;
+        int32_t parent;       // Next free node while on the free list
+        int32_t child1;
+        int32_t child2;
+        int32_t height;       // 0 for leaves, -1 for free nodes
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    // Fixed inline storage; spills to the heap only for degenerate trees
+    class NodeStack {
+    public:
+        void push(int32_t index) {
+            if (count < inlineNodes.size()) {
+                inlineNodes[count] = index;
+            } else {
+                overflow.push_back(index);
+            }
+            ++count;
+        }
+
+        int32_t pop() {
+            --count;
+            if (count < inlineNodes.size()) return inlineNodes[count];
+            int32_t index = overflow.back();
+            overflow.pop_back();
+            return index;
+        }
+
+        bool empty() const { return count == 0; }
+
+    private:
+        std::array<int32_t, 128> inlineNodes;
+        std::vector<int32_t> overflow;
+        size_t count = 0;
+    };
+
+    std::vector<Node> nodes;
+    int32_t root;
+    int32_t freeList;
+    size_t proxyCount;
+
+    int32_t allocateNode();
+    void freeNode(int32_t index);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t balance(int32_t index);
+    void refitAncestors(int32_t index);
+
+    template<typename Overlaps, typename Callback>
+    void traverse(const Overlaps& overlaps, Callback& callback) const {
+        NodeStack stack;
+        stack.push(root);
+        while (!stack.empty()) {
+            int32_t index = stack.pop();
+            if (index == NULL_NODE) continue;
+
+            const Node& node = nodes[index];
+            if (!overlaps(node.bounds)) continue;
+
+            if (node.isLeaf()) {
+                if (!callback(index)) return;
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    template<typename Callback>
+    bool reportSubtree(int32_t subtree, Callback& callback) const {
+        NodeStack stack;
+        stack.push(subtree);
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.pop()];
+            if (node.isLeaf()) {
+                if (!callback(static_cast<int32_t>(&node - nodes.data()))) return false;
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+        return true;
+    }
+};
@@ -1,10 +1,22 @@
 #include "Entity.hpp"
 
-Entity::Entity(const std::string& entityName) 
-    : name(entityName) {}
+Entity::Entity(Scene* owner, ComponentStorage* componentStorage, const std::string& entityName)
+    : name(entityName)
+    , scene(owner)
+    , storage(componentStorage)
+{}
+
+Entity::~Entity() {
+    storage->removeEntity(location);
+}
 
 void Entity::update(float deltaTime) {
-    for (auto& component : components) {
-        component->update(deltaTime);
+    Archetype* archetype = location.archetype;
+    if (!archetype) return;
+
+    const auto& columns = archetype->getColumns();
+    for (size_t c = 0; c < columns.size(); ++c) {
+        void* component = archetype->getComponent(static_cast<int>(c), location.row);
+        columns[c].type->asComponent(component)->update(deltaTime);
     }
 }
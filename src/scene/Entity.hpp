@@ -1,42 +1,59 @@
 #pragma once
 #include <string>
-#include <vector>
-#include <memory>
-#include <typeinfo>
-#include "../components/Component.hpp"
+#include "ComponentStorage.hpp"
+#include "EntityHandle.hpp"
 
+class Scene;
+
+// Lightweight handle into a scene's archetype storage. The entity itself owns
+// no components; they live in the chunk row described by `location`.
 class Entity {
 public:
-    Entity(const std::string& name = "Entity");
-    ~Entity() = default;
+    Entity(Scene* scene, ComponentStorage* storage, const std::string& name = "Entity");
+    ~Entity();
+
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
 
     void update(float deltaTime);
 
     template<typename T, typename... Args>
     T* addComponent(Args&&... args) {
-        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-        auto component = std::make_unique<T>(std::forward<Args>(args)...);
-        T* componentPtr = component.get();
-        component->entity = this;
-        components.push_back(std::move(component));
-        return componentPtr;
+        return storage->addComponent<T>(this, location, std::forward<Args>(args)...);
     }
 
     template<typename T>
     T* getComponent() {
-        static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-        for (const auto& component : components) {
-            if (T* casted = dynamic_cast<T*>(component.get())) {
-                return casted;
-            }
-        }
-        return nullptr;
+        return storage->getComponent<T>(location);
+    }
+
+    // Adds every component in `signature` at once, default-constructed.
+    // Only valid while the entity has no components.
+    void addComponents(const ComponentSignature& signature) {
+        storage->addComponents(this, location, signature);
+    }
+
+    template<typename T>
+    void removeComponent() {
+        storage->removeComponent<T>(this, location);
     }
 
     const std::string& getName() const { return name; }
     void setName(const std::string& newName) { name = newName; }
 
+    // Prefer holding the handle over a raw Entity* across frames
+    EntityHandle getHandle() const { return handle; }
+    Scene* getScene() const { return scene; }
+
+    const EntityLocation& getLocation() const { return location; }
+
 private:
     std::string name;
-    std::vector<std::unique_ptr<Component>> components;
+    Scene* scene;
+    ComponentStorage* storage;
+    EntityLocation location;
+    EntityHandle handle;
+
+    friend class ComponentStorage;
+    friend class Scene;
 };
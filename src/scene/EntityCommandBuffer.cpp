@@ -0,0 +1,54 @@
+#include "EntityCommandBuffer.hpp"
+#include "Scene.hpp"
+#include <iterator>
+
+void EntityCommandBuffer::createEntity(const std::string& name, const EntityAction& init) {
+    creates.push_back({ name, init });
+}
+
+void EntityCommandBuffer::destroyEntity(EntityHandle entity) {
+    destroys.push_back(entity);
+}
+
+void EntityCommandBuffer::record(EntityHandle entity, const EntityAction& action) {
+    actions.push_back({ entity, action });
+}
+
+void EntityCommandBuffer::clear() {
+    creates.clear();
+    actions.clear();
+    destroys.clear();
+}
+
+void EntityCommandBuffer::merge(EntityCommandBuffer& other) {
+    creates.insert(creates.end(),
+                   std::make_move_iterator(other.creates.begin()),
+                   std::make_move_iterator(other.creates.end()));
+    actions.insert(actions.end(),
+                   std::make_move_iterator(other.actions.begin()),
+                   std::make_move_iterator(other.actions.end()));
+    destroys.insert(destroys.end(), other.destroys.begin(), other.destroys.end());
+    other.clear();
+}
+
+void EntityCommandBuffer::playback(Scene& scene) {
+    for (auto& command : creates) {
+        Entity* entity = scene.createEntity(command.name);
+        if (command.init) {
+            command.init(*entity);
+        }
+    }
+
+    for (auto& command : actions) {
+        if (Entity* entity = scene.getEntity(command.entity)) {
+            command.action(*entity);
+        }
+    }
+
+    // Stale or duplicate handles are rejected by the slot map
+    for (EntityHandle entity : destroys) {
+        scene.destroyEntity(entity);
+    }
+
+    clear();
+}
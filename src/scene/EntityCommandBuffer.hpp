@@ -0,0 +1,68 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Entity.hpp"
+#include "EntityHandle.hpp"
+
+class Scene;
+
+// Records structural changes (create/destroy/add/remove component) and other
+// entity mutations while systems are iterating, for playback at the scene's
+// sync point. Each thread records into its own buffer, so no locking is
+// needed on the hot path.
+class EntityCommandBuffer {
+public:
+    using EntityAction = std::function<void(Entity&)>;
+
+    EntityCommandBuffer() = default;
+
+    // Created during playback, after which `init` runs on the new entity
+    void createEntity(const std::string& name, const EntityAction& init = nullptr);
+    void destroyEntity(EntityHandle entity);
+
+    // Arbitrary deferred mutation; skipped if the entity is gone by playback
+    void record(EntityHandle entity, const EntityAction& action);
+
+    template<typename T, typename... Args>
+    void addComponent(EntityHandle entity, Args... args) {
+        record(entity, [args...](Entity& target) {
+            target.addComponent<T>(args...);
+        });
+    }
+
+    template<typename T>
+    void removeComponent(EntityHandle entity) {
+        record(entity, [](Entity& target) {
+            target.removeComponent<T>();
+        });
+    }
+
+    bool isEmpty() const { return creates.empty() && actions.empty() && destroys.empty(); }
+    size_t getCommandCount() const { return creates.size() + actions.size() + destroys.size(); }
+    void clear();
+
+    // Appends another buffer's commands, preserving their recording order
+    void merge(EntityCommandBuffer& other);
+
+    // Applies everything in phases: creations, then mutations, then
+    // destructions, so commands recorded against an entity that is also
+    // being destroyed this frame still see it.
+    void playback(Scene& scene);
+
+private:
+    struct CreateCommand {
+        std::string name;
+        EntityAction init;
+    };
+
+    struct ActionCommand {
+        EntityHandle entity;
+        EntityAction action;
+    };
+
+    std::vector<CreateCommand> creates;
+    std::vector<ActionCommand> actions;
+    std::vector<EntityHandle> destroys;
+};
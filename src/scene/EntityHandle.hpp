@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+// Stable reference to an entity: a slot index plus the generation the slot had
+// when the entity was created. Destroying the entity bumps the generation, so
+// stale handles resolve to nullptr instead of dangling.
+struct EntityHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == INVALID_INDEX; }
+    explicit operator bool() const { return !isNull(); }
+
+    bool operator==(const EntityHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+namespace std {
+    template<>
+    struct hash<EntityHandle> {
+        size_t operator()(const EntityHandle& handle) const {
+            return hash<uint64_t>()((static_cast<uint64_t>(handle.generation) << 32) | handle.index);
+        }
+    };
+}
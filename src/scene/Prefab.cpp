@@ -0,0 +1,29 @@
+#include "Prefab.hpp"
+#include "Scene.hpp"
+#include "../core/AllocationTracker.hpp"
+#include "../core/Profiler.hpp"
+#include <cassert>
+
+Prefab::Prefab(const std::string& name)
+    : prototype(nullptr, &storage, name)
+{}
+
+Entity* Prefab::instantiate(Scene& scene) {
+    return instantiate(scene, 1).front();
+}
+
+std::vector<Entity*> Prefab::instantiate(Scene& scene, size_t count) {
+    PROFILE_SCOPE("Prefab::instantiate");
+    MEMORY_TAG(Scene);
+    assert(!scene.isUpdating() && "Prefabs are instantiated outside Scene::update");
+
+    std::vector<Entity*> instances;
+    instances.reserve(count);
+    scene.reserveEntities(count);
+    for (size_t i = 0; i < count; ++i) {
+        instances.push_back(scene.createEntity(prototype.getName()));
+    }
+
+    scene.getStorage().cloneComponents(prototype.getLocation(), instances.data(), instances.size());
+    return instances;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+
+class Scene;
+
+// Template entity that is built once and stamped out in bulk. The
+// prototype lives in the prefab's own storage, outside any scene, so it is
+// never updated, indexed or collided with. Instantiating copy-constructs its
+// components straight into the scene's archetype rows, one component column
+// at a time, instead of adding components one by one to every instance.
+//
+// Configuration that is read-only after setup (weapon loadouts, meshes,
+// materials) is held by shared pointer or SharedData, so clones reference
+// the prototype's copy and only detach one when they modify it.
+//
+// Covers single entities; Transform parents are copied as-is, so a clone
+// of a child attaches to the same parent.
+class Prefab {
+public:
+    explicit Prefab(const std::string& name = "Prefab");
+
+    Prefab(const Prefab&) = delete;
+    Prefab& operator=(const Prefab&) = delete;
+
+    // The prototype is set up like any entity. Every component type used
+    // must be copy-constructible.
+    template<typename T, typename... Args>
+    T* addComponent(Args&&... args) {
+        return prototype.addComponent<T>(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* getComponent() {
+        return prototype.getComponent<T>();
+    }
+
+    template<typename T>
+    void removeComponent() {
+        prototype.removeComponent<T>();
+    }
+
+    const std::string& getName() const { return prototype.getName(); }
+
+    // Instances are named after the prefab. Must not be called while the
+    // scene is updating.
+    Entity* instantiate(Scene& scene);
+    std::vector<Entity*> instantiate(Scene& scene, size_t count);
+
+private:
+    // Declared first so it outlives the prototype
+    ComponentStorage storage;
+    Entity prototype;
+};
@@ -1,31 +1,256 @@
 #include "Scene.hpp"
-#include <algorithm>
+#include "../components/Transform.hpp"
+#include "../components/MeshRenderer.hpp"
+#include "../physics/PhysicsSystem.hpp"
+#include "../core/AllocationTracker.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Profiler.hpp"
 
 void Scene::update(float deltaTime) {
-    for (auto& entity : entities) {
-        entity->update(deltaTime);
+    PROFILE_SCOPE("Scene::update");
+    MEMORY_TAG(Scene);
+    registerComponentSystems();
+    prepareCommandBuffers();
+
+    updating = true;
+    scheduler.run(*this, deltaTime);
+    updating = false;
+
+    {
+        PROFILE_SCOPE("Scene::playbackCommands");
+        playbackCommands();
+    }
+
+    // World matrices are final once every system and deferred command has run
+    {
+        PROFILE_SCOPE("TransformSystem::update");
+        TransformSystem::getInstance().update();
     }
+
+    spatialIndex.sync(*this);
 }
 
 void Scene::render() {
-    for (auto& entity : entities) {
-        // Render each entity's components
-        for (const auto& component : entity->components) {
-            component->render();
+    view<MeshRenderer, Transform>().each([](Entity*, MeshRenderer& renderer, Transform& transform) {
+        renderer.draw(transform.getRenderMatrix());
+    });
+    renderComponents();
+}
+
+void Scene::render(const Frustum& frustum) {
+    spatialIndex.queryFrustum(SpatialIndex::Layer::Renderables, frustum, [](Entity* entity) {
+        // Renderers removed since the last sync are skipped
+        MeshRenderer* renderer = entity->getComponent<MeshRenderer>();
+        Transform* transform = entity->getComponent<Transform>();
+        if (renderer && transform) {
+            renderer->draw(transform->getRenderMatrix());
+        }
+    });
+    renderComponents();
+}
+
+// Any component type other than MeshRenderer that overrides render()
+void Scene::renderComponents() {
+    for (const auto& archetype : storage.getArchetypes()) {
+        const auto& columns = archetype->getColumns();
+        for (size_t c = 0; c < columns.size(); ++c) {
+            auto renderRange = columns[c].type->renderRange;
+            if (!renderRange) continue;
+
+            for (const auto& chunk : archetype->getChunks()) {
+                if (chunk.count == 0) break;
+                renderRange(archetype->getColumnData(chunk, static_cast<int>(c)), chunk.count);
+            }
         }
     }
 }
 
+Scene::Scene()
+    : freeListHead(EntityHandle::INVALID_INDEX)
+    , updating(false)
+{
+    prepareCommandBuffers();
+    declareEngineComponentAccess();
+    addEngineSystems();
+}
+
+Scene::~Scene() {
+    for (Entity* entity : entities) {
+        entityPool.destroy(entity);
+    }
+}
+
 Entity* Scene::createEntity(const std::string& name) {
-    entities.push_back(std::make_unique<Entity>(name));
-    return entities.back().get();
+    MEMORY_TAG(Scene);
+    uint32_t index;
+    if (freeListHead != EntityHandle::INVALID_INDEX) {
+        index = freeListHead;
+        freeListHead = slots[index].denseIndex;
+    } else {
+        index = static_cast<uint32_t>(slots.size());
+        slots.push_back({ 0, 0 });
+    }
+
+    EntitySlot& slot = slots[index];
+    slot.denseIndex = static_cast<uint32_t>(entities.size());
+
+    Entity* entity = entityPool.create(this, &storage, name);
+    entities.push_back(entity);
+    entity->handle = { index, slot.generation };
+    return entity;
+}
+
+void Scene::reserveEntities(size_t count) {
+    MEMORY_TAG(Scene);
+    entities.reserve(entities.size() + count);
+    slots.reserve(slots.size() + count);
 }
 
 void Scene::destroyEntity(Entity* entity) {
-    auto it = std::find_if(entities.begin(), entities.end(),
-        [entity](const std::unique_ptr<Entity>& e) { return e.get() == entity; });
-    
-    if (it != entities.end()) {
-        entities.erase(it);
+    if (entity && entity->scene == this) {
+        destroyEntity(entity->handle);
+    }
+}
+
+void Scene::destroyEntity(EntityHandle handle) {
+    if (!isValid(handle)) return;
+
+    if (updating) {
+        getCommandBuffer().destroyEntity(handle);
+        return;
+    }
+
+    spatialIndex.remove(handle);
+
+    EntitySlot& slot = slots[handle.index];
+    uint32_t denseIndex = slot.denseIndex;
+
+    // Swap-and-pop, then patch the slot of whichever entity filled the hole
+    if (denseIndex != entities.size() - 1) {
+        std::swap(entities[denseIndex], entities.back());
+        slots[entities[denseIndex]->handle.index].denseIndex = denseIndex;
+    }
+    entityPool.destroy(entities.back());
+    entities.pop_back();
+
+    // Invalidate outstanding handles and recycle the slot
+    slot.generation++;
+    slot.denseIndex = freeListHead;
+    freeListHead = handle.index;
+}
+
+Entity* Scene::getEntity(EntityHandle handle) const {
+    return isValid(handle) ? entities[slots[handle.index].denseIndex] : nullptr;
+}
+
+bool Scene::isValid(EntityHandle handle) const {
+    return handle.index < slots.size() &&
+           slots[handle.index].generation == handle.generation &&
+           !handle.isNull();
+}
+
+EntityCommandBuffer& Scene::getCommandBuffer() {
+    int index = JobSystem::getInstance().getThreadIndex();
+    if (index >= 0 && static_cast<size_t>(index) < threadBuffers.size()) {
+        return *threadBuffers[index];
+    }
+
+    std::lock_guard<std::mutex> lock(commandBufferMutex);
+    std::unique_ptr<EntityCommandBuffer>& buffer = otherThreadBuffers[std::this_thread::get_id()];
+    if (!buffer) {
+        MEMORY_TAG(Scene);
+        buffer = std::make_unique<EntityCommandBuffer>();
+    }
+    return *buffer;
+}
+
+// Main thread, between updates: no job system thread is recording
+void Scene::prepareCommandBuffers() {
+    size_t threads = JobSystem::getInstance().getWorkerCount() + 1;
+    if (threadBuffers.size() >= threads) return;
+
+    MEMORY_TAG(Scene);
+    while (threadBuffers.size() < threads) {
+        threadBuffers.push_back(std::make_unique<EntityCommandBuffer>());
+    }
+}
+
+void Scene::playbackCommands() {
+    MEMORY_TAG(Scene);
+    // Playback may record follow-up commands (a death destroying its entity,
+    // an init adding children), so drain until no buffer has work left
+    for (int pass = 0; pass < MAX_PLAYBACK_PASSES; ++pass) {
+        EntityCommandBuffer merged;
+        {
+            std::lock_guard<std::mutex> lock(commandBufferMutex);
+            for (auto& buffer : threadBuffers) {
+                merged.merge(*buffer);
+            }
+            for (auto& entry : otherThreadBuffers) {
+                merged.merge(*entry.second);
+            }
+        }
+
+        if (merged.isEmpty()) break;
+        merged.playback(*this);
+    }
+}
+
+void Scene::declareEngineComponentAccess() {
+    declareComponentAccess<Camera>("Camera", SystemAccess().write<Camera>().read<Transform>());
+    declareComponentAccess<Light>("Light", SystemAccess().write<Light>().read<Transform>());
+    declareComponentAccess<MeshRenderer>("MeshRenderer", SystemAccess().write<MeshRenderer>());
+
+    // Controllers and weapons raycast against every collider
+    declareComponentAccess<FPSController>("FPSController", SystemAccess()
+        .write<FPSController, Transform, RigidBody>()
+        .read<BoxCollider, SphereCollider, CapsuleCollider>());
+    declareComponentAccess<AIController>("AIController", SystemAccess()
+        .write<AIController, Transform, RigidBody, WeaponSystem>()
+        .read<HealthSystem, BoxCollider, SphereCollider, CapsuleCollider>());
+    declareComponentAccess<WeaponSystem>("WeaponSystem", SystemAccess()
+        .write<WeaponSystem, Transform>()
+        .read<BoxCollider, SphereCollider, CapsuleCollider>());
+
+    // Damage and death go through the command buffer, so health only touches itself
+    declareComponentAccess<HealthSystem>("HealthSystem", SystemAccess().write<HealthSystem>());
+    declareComponentAccess<VisualEffects>("VisualEffects", SystemAccess().write<VisualEffects>());
+}
+
+void Scene::addEngineSystems() {
+    scheduler.addSystem("Physics", SystemAccess().write<RigidBody, Transform>(), [](Scene& scene, float deltaTime) {
+        PhysicsSystem::getInstance().integrate(scene, deltaTime);
+    });
+}
+
+void Scene::registerComponentSystems() {
+    for (const auto& archetype : storage.getArchetypes()) {
+        for (const auto& column : archetype->getColumns()) {
+            ComponentSystem& system = componentSystems[column.type->id];
+            if (system.registered || !column.type->updateRange) continue;
+
+            ComponentTypeId id = column.type->id;
+            if (!system.declared) {
+                system.name = "Component#" + std::to_string(id);
+                system.access = SystemAccess::makeExclusive();
+            }
+            scheduler.addSystem(system.name, system.access, [id](Scene& scene, float deltaTime) {
+                scene.updateComponentType(id, deltaTime);
+            });
+            system.registered = true;
+        }
+    }
+}
+
+void Scene::updateComponentType(ComponentTypeId id, float deltaTime) {
+    for (const auto& archetype : storage.getArchetypes()) {
+        int column = archetype->findColumn(id);
+        if (column < 0) continue;
+
+        auto updateRange = archetype->getColumns()[column].type->updateRange;
+        for (const auto& chunk : archetype->getChunks()) {
+            if (chunk.count == 0) break;
+            updateRange(archetype->getColumnData(chunk, column), chunk.count, deltaTime);
+        }
     }
 }
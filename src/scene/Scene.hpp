@@ -1,21 +1,122 @@
 #pragma once
+#include <array>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "../core/Allocators.hpp"
 #include "Entity.hpp"
+#include "EntityHandle.hpp"
+#include "EntityCommandBuffer.hpp"
+#include "SpatialIndex.hpp"
+#include "ComponentView.hpp"
+#include "SystemScheduler.hpp"
 
 class Scene {
 public:
-    Scene() = default;
-    ~Scene() = default;
+    Scene();
+    ~Scene();
 
+    // Runs every system through the scheduler, plays back deferred commands
+    // and then propagates transforms. Each component type with an update() is
+    // its own system that ticks its columns chunk by chunk. Structural changes
+    // made while updating must go through the command buffer. The spatial
+    // index is synced last.
     void update(float deltaTime);
     void render();
 
+    // Draws only the MeshRenderers whose bounds the frustum touches
+    void render(const Frustum& frustum);
+
+    // O(1) create/destroy through a generational slot map. Destruction requested
+    // while the scene is updating is deferred to the next sync point.
     Entity* createEntity(const std::string& name = "Entity");
     void destroyEntity(Entity* entity);
+    void destroyEntity(EntityHandle handle);
+
+    // Pre-sizes the entity tables for `count` more entities
+    void reserveEntities(size_t count);
+
+    // Calling thread's command buffer. Use it for structural changes made
+    // from inside component/system updates.
+    EntityCommandBuffer& getCommandBuffer();
+
+    // Sync point: merges every thread's buffer and applies it in one pass
+    void playbackCommands();
+    bool isUpdating() const { return updating; }
+
+    // Systems run alongside the component update systems
+    SystemScheduler& getScheduler() { return scheduler; }
+
+    // Declares what T::update reads and writes so it can overlap other
+    // systems. Undeclared component types run exclusively.
+    template<typename T>
+    void declareComponentAccess(const std::string& name, const SystemAccess& access) {
+        ComponentSystem& system = componentSystems[getComponentTypeId<T>()];
+        system.name = name;
+        system.access = access;
+        system.declared = true;
+    }
+
+    // Entities that have every T, e.g. view<Transform, RigidBody>().exclude<Camera>().
+    // Matching archetypes are cached per query.
+    template<typename... T>
+    ComponentView<T...> view() {
+        return ComponentView<T...>(storage);
+    }
+
+    // Returns nullptr for null or stale handles
+    Entity* getEntity(EntityHandle handle) const;
+    bool isValid(EntityHandle handle) const;
     
-    const std::vector<std::unique_ptr<Entity>>& getEntities() const { return entities; }
+    const std::vector<Entity*>& getEntities() const { return entities; }
+    ComponentStorage& getStorage() { return storage; }
+
+    // Bounds of colliders and renderers as of the last update()
+    const SpatialIndex& getSpatialIndex() const { return spatialIndex; }
+    SpatialIndex& getSpatialIndex() { return spatialIndex; }
 
 private:
-    std::vector<std::unique_ptr<Entity>> entities;
+    struct ComponentSystem {
+        std::string name;
+        SystemAccess access;
+        bool declared = false;
+        bool registered = false;
+    };
+
+    struct EntitySlot {
+        uint32_t generation;
+        uint32_t denseIndex; // Position in `entities` while alive, next free slot otherwise
+    };
+
+    // Declared first so it outlives the entities that reference it
+    ComponentStorage storage;
+
+    // Dense array of live entities, allocated from the pool; removal swaps
+    // the last entity into the hole
+    ObjectPool<Entity> entityPool;
+    std::vector<Entity*> entities;
+    std::vector<EntitySlot> slots;
+    uint32_t freeListHead;
+
+    // Deferred structural changes, one buffer per recording thread. Job
+    // system threads use threadBuffers[thread index] without locking; it is
+    // sized before each update. Other threads get one keyed by their id.
+    static constexpr int MAX_PLAYBACK_PASSES = 8;
+    bool updating;
+    std::vector<std::unique_ptr<EntityCommandBuffer>> threadBuffers;
+    std::mutex commandBufferMutex;
+    std::unordered_map<std::thread::id, std::unique_ptr<EntityCommandBuffer>> otherThreadBuffers;
+
+    SystemScheduler scheduler;
+    SpatialIndex spatialIndex;
+    std::array<ComponentSystem, MAX_COMPONENT_TYPES> componentSystems;
+
+    void renderComponents();
+    void prepareCommandBuffers();
+    void declareEngineComponentAccess();
+    void addEngineSystems();
+    void registerComponentSystems();
+    void updateComponentType(ComponentTypeId id, float deltaTime);
 };
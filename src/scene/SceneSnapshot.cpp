@@ -0,0 +1,534 @@
+#include "SceneSnapshot.hpp"
+#include "Scene.hpp"
+#include "../components/Transform.hpp"
+#include "../components/Light.hpp"
+#include "../components/MeshRenderer.hpp"
+#include "../physics/Collider.hpp"
+#include "../physics/CapsuleCollider.hpp"
+#include "../core/AllocationTracker.hpp"
+#include "../core/MappedFile.hpp"
+#ifndef ENGINE_HEADLESS
+#include "../core/ResourceManager.hpp"
+#endif
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+    using Snapshot = SceneSnapshot;
+
+    constexpr size_t SECTION_ALIGNMENT = 16;
+    constexpr uint32_t KNOWN_COMPONENTS = Snapshot::TransformBit | Snapshot::BoxColliderBit |
+        Snapshot::SphereColliderBit | Snapshot::CapsuleColliderBit | Snapshot::LightBit |
+        Snapshot::MeshRendererBit;
+
+    const uint32_t recordStrides[Snapshot::SECTION_COUNT] = {
+        sizeof(Snapshot::EntityRecord),
+        sizeof(Snapshot::GroupRecord),
+        sizeof(Snapshot::TransformRecord),
+        sizeof(Snapshot::ColliderRecord),
+        sizeof(Snapshot::ColliderRecord),
+        sizeof(Snapshot::ColliderRecord),
+        sizeof(Snapshot::LightRecord),
+        sizeof(Snapshot::MeshRendererRecord),
+        1
+    };
+
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    void store(float* dst, const glm::vec3& v) {
+        dst[0] = v.x;
+        dst[1] = v.y;
+        dst[2] = v.z;
+    }
+
+    glm::vec3 loadVec3(const float* src) {
+        return glm::vec3(src[0], src[1], src[2]);
+    }
+
+    uint32_t componentMask(Entity* entity) {
+        uint32_t mask = 0;
+        if (entity->getComponent<Transform>()) mask |= Snapshot::TransformBit;
+        if (entity->getComponent<BoxCollider>()) mask |= Snapshot::BoxColliderBit;
+        if (entity->getComponent<SphereCollider>()) mask |= Snapshot::SphereColliderBit;
+        if (entity->getComponent<CapsuleCollider>()) mask |= Snapshot::CapsuleColliderBit;
+        if (entity->getComponent<Light>()) mask |= Snapshot::LightBit;
+        if (entity->getComponent<MeshRenderer>()) mask |= Snapshot::MeshRendererBit;
+        return mask;
+    }
+
+    ComponentSignature componentSignature(uint32_t mask) {
+        ComponentSignature signature;
+        if (mask & Snapshot::TransformBit) signature.set(ComponentTypeRegistry::get<Transform>().id);
+        if (mask & Snapshot::BoxColliderBit) signature.set(ComponentTypeRegistry::get<BoxCollider>().id);
+        if (mask & Snapshot::SphereColliderBit) signature.set(ComponentTypeRegistry::get<SphereCollider>().id);
+        if (mask & Snapshot::CapsuleColliderBit) signature.set(ComponentTypeRegistry::get<CapsuleCollider>().id);
+        if (mask & Snapshot::LightBit) signature.set(ComponentTypeRegistry::get<Light>().id);
+        if (mask & Snapshot::MeshRendererBit) signature.set(ComponentTypeRegistry::get<MeshRenderer>().id);
+        return signature;
+    }
+
+    // NUL-terminated strings, each distinct string stored once
+    class StringTable {
+    public:
+        uint32_t add(const std::string& value) {
+            auto it = offsets.find(value);
+            if (it != offsets.end()) return it->second;
+
+            uint32_t offset = static_cast<uint32_t>(bytes.size());
+            bytes.insert(bytes.end(), value.begin(), value.end());
+            bytes.push_back('\0');
+            offsets.emplace(value, offset);
+            return offset;
+        }
+
+        const std::vector<char>& getBytes() const { return bytes; }
+
+    private:
+        std::vector<char> bytes;
+        std::unordered_map<std::string, uint32_t> offsets;
+    };
+
+    template<typename T>
+    void writeSection(std::vector<std::byte>& blob, Snapshot::SectionId id,
+                      const T* records, size_t count) {
+        size_t offset = alignUp(blob.size(), SECTION_ALIGNMENT);
+        blob.resize(offset + sizeof(T) * count);
+        if (count > 0) {
+            std::memcpy(blob.data() + offset, records, sizeof(T) * count);
+        }
+
+        Snapshot::Header* header = reinterpret_cast<Snapshot::Header*>(blob.data());
+        header->sections[id] = { offset, static_cast<uint32_t>(count), static_cast<uint32_t>(sizeof(T)) };
+    }
+
+    template<typename T>
+    const T* sectionData(const std::byte* data, const Snapshot::Header& header, Snapshot::SectionId id) {
+        return reinterpret_cast<const T*>(data + header.sections[id].offset);
+    }
+
+    void writeCollider(Snapshot::ColliderRecord& record, uint32_t entity, const Collider& collider) {
+        record = {};
+        record.entity = entity;
+        record.trigger = collider.isTrigger() ? 1 : 0;
+        record.restitution = collider.getRestitution();
+        record.friction = collider.getFriction();
+    }
+
+    void readCollider(const Snapshot::ColliderRecord& record, Collider& collider) {
+        collider.setTrigger(record.trigger != 0);
+        collider.setMaterial(record.restitution, record.friction);
+    }
+
+    // Hands `count` consecutive records to read(component, record), one per
+    // row from `first` on, walking T's column chunk by chunk
+    template<typename T, typename Record, typename Read>
+    void readColumn(const EntityLocation& first, const Record* records, uint32_t count, Read read) {
+        const Archetype& archetype = *first.archetype;
+        const int column = archetype.findColumn(getComponentTypeId<T>());
+        const uint32_t rowsPerChunk = archetype.getRowsPerChunk();
+        uint32_t done = 0;
+        while (done < count) {
+            uint32_t row = first.row + done;
+            const Archetype::Chunk& chunk = archetype.getChunks()[row / rowsPerChunk];
+            T* components = reinterpret_cast<T*>(archetype.getColumnData(chunk, column)) + row % rowsPerChunk;
+            uint32_t run = std::min(count - done, rowsPerChunk - row % rowsPerChunk);
+            for (uint32_t i = 0; i < run; ++i) {
+                read(components[i], records[done + i]);
+            }
+            done += run;
+        }
+    }
+
+    // Checks every offset and index in the blob so instantiation can trust it
+    bool validate(const std::byte* data, size_t size) {
+        if (reinterpret_cast<uintptr_t>(data) % alignof(uint64_t) != 0) return false;
+        if (size < sizeof(Snapshot::Header)) return false;
+
+        const Snapshot::Header& header = *reinterpret_cast<const Snapshot::Header*>(data);
+        if (header.magic != Snapshot::MAGIC || header.version != Snapshot::VERSION) return false;
+        if (header.size != size) return false;
+
+        for (uint32_t id = 0; id < Snapshot::SECTION_COUNT; ++id) {
+            const Snapshot::Section& section = header.sections[id];
+            if (section.stride != recordStrides[id]) return false;
+            if (section.offset % SECTION_ALIGNMENT != 0 || section.offset > size) return false;
+            if (static_cast<uint64_t>(section.count) * section.stride > size - section.offset) return false;
+        }
+
+        const Snapshot::Section& strings = header.sections[Snapshot::StringSection];
+        const char* stringData = sectionData<char>(data, header, Snapshot::StringSection);
+        if (strings.count > 0 && stringData[strings.count - 1] != '\0') return false;
+        auto validString = [&](uint32_t offset, bool optional) {
+            return (optional && offset == Snapshot::NO_STRING) || offset < strings.count;
+        };
+
+        // Groups must tile the entity array exactly
+        uint32_t entityCount = header.sections[Snapshot::EntitySection].count;
+        std::vector<uint32_t> masks(entityCount, 0);
+        const auto* groups = sectionData<Snapshot::GroupRecord>(data, header, Snapshot::GroupSection);
+        uint32_t covered = 0;
+        for (uint32_t g = 0; g < header.sections[Snapshot::GroupSection].count; ++g) {
+            if (groups[g].firstEntity != covered) return false;
+            if ((groups[g].components & ~KNOWN_COMPONENTS) != 0) return false;
+            if (groups[g].count > entityCount - covered) return false;
+            std::fill_n(masks.begin() + covered, groups[g].count, groups[g].components);
+            covered += groups[g].count;
+        }
+        if (covered != entityCount) return false;
+
+        const auto* entities = sectionData<Snapshot::EntityRecord>(data, header, Snapshot::EntitySection);
+        for (uint32_t e = 0; e < entityCount; ++e) {
+            if (!validString(entities[e].name, false)) return false;
+        }
+
+        // Component records must point at an entity whose group owns that
+        // component, one record per such entity in entity order, so each
+        // group's records can be copied into its archetype as one run
+        auto validEntity = [&](uint32_t entity, uint32_t bit) {
+            return entity < entityCount && (masks[entity] & bit) != 0;
+        };
+        auto validOrder = [&](const auto* records, Snapshot::SectionId id, uint32_t bit) {
+            uint32_t owners = 0;
+            for (uint32_t g = 0; g < header.sections[Snapshot::GroupSection].count; ++g) {
+                if (groups[g].components & bit) owners += groups[g].count;
+            }
+            uint32_t count = header.sections[id].count;
+            if (count != owners) return false;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (!validEntity(records[i].entity, bit)) return false;
+                if (i > 0 && records[i].entity <= records[i - 1].entity) return false;
+            }
+            return true;
+        };
+
+        const auto* transforms = sectionData<Snapshot::TransformRecord>(data, header, Snapshot::TransformSection);
+        if (!validOrder(transforms, Snapshot::TransformSection, Snapshot::TransformBit)) return false;
+        for (uint32_t i = 0; i < header.sections[Snapshot::TransformSection].count; ++i) {
+            if (transforms[i].parent != Snapshot::NO_PARENT &&
+                !validEntity(transforms[i].parent, Snapshot::TransformBit)) return false;
+        }
+
+        const Snapshot::SectionId colliderSections[] = {
+            Snapshot::BoxColliderSection, Snapshot::SphereColliderSection, Snapshot::CapsuleColliderSection
+        };
+        const uint32_t colliderBits[] = {
+            Snapshot::BoxColliderBit, Snapshot::SphereColliderBit, Snapshot::CapsuleColliderBit
+        };
+        for (int c = 0; c < 3; ++c) {
+            const auto* colliders = sectionData<Snapshot::ColliderRecord>(data, header, colliderSections[c]);
+            if (!validOrder(colliders, colliderSections[c], colliderBits[c])) return false;
+        }
+
+        const auto* lights = sectionData<Snapshot::LightRecord>(data, header, Snapshot::LightSection);
+        if (!validOrder(lights, Snapshot::LightSection, Snapshot::LightBit)) return false;
+        for (uint32_t i = 0; i < header.sections[Snapshot::LightSection].count; ++i) {
+            if (lights[i].type > static_cast<uint32_t>(Light::Type::Spot)) return false;
+        }
+
+        const auto* renderers = sectionData<Snapshot::MeshRendererRecord>(data, header, Snapshot::MeshRendererSection);
+        if (!validOrder(renderers, Snapshot::MeshRendererSection, Snapshot::MeshRendererBit)) return false;
+        for (uint32_t i = 0; i < header.sections[Snapshot::MeshRendererSection].count; ++i) {
+            if (!validString(renderers[i].mesh, true) || !validString(renderers[i].material, true)) return false;
+        }
+
+        return true;
+    }
+}
+
+std::vector<std::byte> SceneSnapshot::serialize(Scene& scene) {
+    const std::vector<Entity*>& sceneEntities = scene.getEntities();
+    uint32_t entityCount = static_cast<uint32_t>(sceneEntities.size());
+
+    // Sort by component set so every group maps onto a single archetype
+    std::vector<uint32_t> masks(entityCount);
+    for (uint32_t i = 0; i < entityCount; ++i) {
+        masks[i] = componentMask(sceneEntities[i]);
+    }
+    std::vector<uint32_t> order(entityCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&masks](uint32_t a, uint32_t b) { return masks[a] < masks[b]; });
+
+    std::unordered_map<const Entity*, uint32_t> indexOf;
+    indexOf.reserve(entityCount);
+    for (uint32_t i = 0; i < entityCount; ++i) {
+        indexOf.emplace(sceneEntities[order[i]], i);
+    }
+
+    StringTable strings;
+    std::vector<EntityRecord> entities(entityCount);
+    std::vector<GroupRecord> groups;
+    std::vector<TransformRecord> transforms;
+    std::vector<ColliderRecord> boxes, spheres, capsules;
+    std::vector<LightRecord> lights;
+    std::vector<MeshRendererRecord> renderers;
+
+    // Resource names are found by reverse lookup, once per distinct resource.
+    // Headless builds have no resource cache, so renderers save unnamed.
+    std::unordered_map<const void*, uint32_t> resourceNames;
+    auto resourceName = [&](const void* resource, [[maybe_unused]] bool isMesh) {
+        if (!resource) return NO_STRING;
+        auto it = resourceNames.find(resource);
+        if (it != resourceNames.end()) return it->second;
+
+#ifndef ENGINE_HEADLESS
+        ResourceManager& resources = ResourceManager::getInstance();
+        std::string name = isMesh
+            ? resources.findMeshName(static_cast<const Mesh*>(resource))
+            : resources.findMaterialName(static_cast<const Material*>(resource));
+#else
+        std::string name;
+#endif
+        uint32_t offset = name.empty() ? NO_STRING : strings.add(name);
+        resourceNames.emplace(resource, offset);
+        return offset;
+    };
+
+    for (uint32_t i = 0; i < entityCount; ++i) {
+        Entity* entity = sceneEntities[order[i]];
+        uint32_t mask = masks[order[i]];
+        entities[i].name = strings.add(entity->getName());
+
+        if (groups.empty() || groups.back().components != mask) {
+            groups.push_back({ mask, i, 0 });
+        }
+        groups.back().count++;
+
+        if (Transform* transform = entity->getComponent<Transform>()) {
+            TransformRecord record{};
+            record.entity = i;
+            record.parent = NO_PARENT;
+            if (Transform* parent = transform->getParent()) {
+                auto it = indexOf.find(parent->getEntity());
+                if (it != indexOf.end()) record.parent = it->second;
+            }
+            store(record.position, transform->getPosition());
+            const glm::quat& rotation = transform->getRotation();
+            record.rotation[0] = rotation.w;
+            record.rotation[1] = rotation.x;
+            record.rotation[2] = rotation.y;
+            record.rotation[3] = rotation.z;
+            store(record.scale, transform->getScale());
+            transforms.push_back(record);
+        }
+
+        if (BoxCollider* box = entity->getComponent<BoxCollider>()) {
+            ColliderRecord record;
+            writeCollider(record, i, *box);
+            store(record.size, box->getSize());
+            boxes.push_back(record);
+        }
+
+        if (SphereCollider* sphere = entity->getComponent<SphereCollider>()) {
+            ColliderRecord record;
+            writeCollider(record, i, *sphere);
+            record.size[0] = sphere->getRadius();
+            spheres.push_back(record);
+        }
+
+        if (CapsuleCollider* capsule = entity->getComponent<CapsuleCollider>()) {
+            ColliderRecord record;
+            writeCollider(record, i, *capsule);
+            record.size[0] = capsule->getRadius();
+            record.size[1] = capsule->getHeight();
+            capsules.push_back(record);
+        }
+
+        if (Light* light = entity->getComponent<Light>()) {
+            LightRecord record{};
+            record.entity = i;
+            record.type = static_cast<uint32_t>(light->getType());
+            store(record.color, light->getColor());
+            record.intensity = light->getIntensity();
+            record.range = light->getRange();
+            record.spotAngle = light->getSpotAngle();
+            lights.push_back(record);
+        }
+
+        if (MeshRenderer* renderer = entity->getComponent<MeshRenderer>()) {
+            renderers.push_back({ i, resourceName(renderer->getMesh(), true),
+                                  resourceName(renderer->getMaterial(), false) });
+        }
+    }
+
+    std::vector<std::byte> blob(sizeof(Header));
+    Header header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    std::memcpy(blob.data(), &header, sizeof(Header));
+
+    writeSection(blob, EntitySection, entities.data(), entities.size());
+    writeSection(blob, GroupSection, groups.data(), groups.size());
+    writeSection(blob, TransformSection, transforms.data(), transforms.size());
+    writeSection(blob, BoxColliderSection, boxes.data(), boxes.size());
+    writeSection(blob, SphereColliderSection, spheres.data(), spheres.size());
+    writeSection(blob, CapsuleColliderSection, capsules.data(), capsules.size());
+    writeSection(blob, LightSection, lights.data(), lights.size());
+    writeSection(blob, MeshRendererSection, renderers.data(), renderers.size());
+    writeSection(blob, StringSection, strings.getBytes().data(), strings.getBytes().size());
+
+    reinterpret_cast<Header*>(blob.data())->size = blob.size();
+    return blob;
+}
+
+bool SceneSnapshot::save(Scene& scene, const std::string& path) {
+    std::vector<std::byte> blob = serialize(scene);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (file) {
+        file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+    }
+    if (!file) {
+        std::cerr << "Failed to save scene snapshot: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SceneSnapshot::instantiate(Scene& scene, const std::byte* data, size_t size) {
+    MEMORY_TAG(Scene);
+    if (!validate(data, size)) {
+        std::cerr << "Invalid scene snapshot" << std::endl;
+        return false;
+    }
+
+    const Header& header = *reinterpret_cast<const Header*>(data);
+    const char* strings = sectionData<char>(data, header, StringSection);
+
+    // Create each group's entities straight into their final archetype, so
+    // chunks fill sequentially and no entity is ever relocated
+    uint32_t entityCount = header.sections[EntitySection].count;
+    uint32_t groupCount = header.sections[GroupSection].count;
+    const auto* entityRecords = sectionData<EntityRecord>(data, header, EntitySection);
+    const auto* groups = sectionData<GroupRecord>(data, header, GroupSection);
+
+    std::vector<Entity*> entities(entityCount);
+    std::vector<EntityLocation> groupRows(groupCount);
+    scene.reserveEntities(entityCount);
+    for (uint32_t g = 0; g < groupCount; ++g) {
+        uint32_t first = groups[g].firstEntity;
+        for (uint32_t e = first; e < first + groups[g].count; ++e) {
+            entities[e] = scene.createEntity(strings + entityRecords[e].name);
+        }
+        groupRows[g] = scene.getStorage().addComponents(entities.data() + first, groups[g].count,
+                                                        componentSignature(groups[g].components));
+    }
+
+    // Component data. validate() guarantees each section holds one record
+    // per owning entity in entity order, so a group's records are the next
+    // `count` of each of its sections and land on its rows in order.
+    const auto* transforms = sectionData<TransformRecord>(data, header, TransformSection);
+    const auto* boxes = sectionData<ColliderRecord>(data, header, BoxColliderSection);
+    const auto* spheres = sectionData<ColliderRecord>(data, header, SphereColliderSection);
+    const auto* capsules = sectionData<ColliderRecord>(data, header, CapsuleColliderSection);
+    const auto* lights = sectionData<LightRecord>(data, header, LightSection);
+
+    // Many renderers share a resource; resolve each name once. Headless builds
+    // keep the renderers but leave mesh and material unset.
+#ifndef ENGINE_HEADLESS
+    ResourceManager& resources = ResourceManager::getInstance();
+    std::unordered_map<uint32_t, std::shared_ptr<Mesh>> meshes;
+    std::unordered_map<uint32_t, std::shared_ptr<Material>> materials;
+    const auto* renderers = sectionData<MeshRendererRecord>(data, header, MeshRendererSection);
+    auto readRenderer = [&](MeshRenderer& renderer, const MeshRendererRecord& record) {
+        if (record.mesh != NO_STRING) {
+            auto it = meshes.find(record.mesh);
+            if (it == meshes.end()) {
+                it = meshes.emplace(record.mesh, resources.getMesh(strings + record.mesh)).first;
+            }
+            renderer.setMesh(it->second);
+        }
+        if (record.material != NO_STRING) {
+            auto it = materials.find(record.material);
+            if (it == materials.end()) {
+                it = materials.emplace(record.material, resources.getMaterial(strings + record.material)).first;
+            }
+            renderer.setMaterial(it->second);
+        }
+    };
+#endif
+
+    uint32_t nextTransform = 0, nextBox = 0, nextSphere = 0, nextCapsule = 0, nextLight = 0, nextRenderer = 0;
+    for (uint32_t g = 0; g < groupCount; ++g) {
+        const EntityLocation& rows = groupRows[g];
+        const uint32_t mask = groups[g].components;
+        const uint32_t count = groups[g].count;
+
+        if (mask & TransformBit) {
+            readColumn<Transform>(rows, transforms + nextTransform, count,
+                [](Transform& transform, const TransformRecord& record) {
+                    transform.setPosition(loadVec3(record.position));
+                    transform.setRotation(glm::quat(record.rotation[0], record.rotation[1],
+                                                    record.rotation[2], record.rotation[3]));
+                    transform.setScale(loadVec3(record.scale));
+                });
+            nextTransform += count;
+        }
+        if (mask & BoxColliderBit) {
+            readColumn<BoxCollider>(rows, boxes + nextBox, count, [](BoxCollider& box, const ColliderRecord& record) {
+                readCollider(record, box);
+                box.setSize(loadVec3(record.size));
+            });
+            nextBox += count;
+        }
+        if (mask & SphereColliderBit) {
+            readColumn<SphereCollider>(rows, spheres + nextSphere, count,
+                [](SphereCollider& sphere, const ColliderRecord& record) {
+                    readCollider(record, sphere);
+                    sphere.setRadius(record.size[0]);
+                });
+            nextSphere += count;
+        }
+        if (mask & CapsuleColliderBit) {
+            readColumn<CapsuleCollider>(rows, capsules + nextCapsule, count,
+                [](CapsuleCollider& capsule, const ColliderRecord& record) {
+                    readCollider(record, capsule);
+                    capsule.setRadius(record.size[0]);
+                    capsule.setHeight(record.size[1]);
+                });
+            nextCapsule += count;
+        }
+        if (mask & LightBit) {
+            readColumn<Light>(rows, lights + nextLight, count, [](Light& light, const LightRecord& record) {
+                light.setType(static_cast<Light::Type>(record.type));
+                light.setColor(loadVec3(record.color));
+                light.setIntensity(record.intensity);
+                light.setRange(record.range);
+                light.setSpotAngle(record.spotAngle);
+            });
+            nextLight += count;
+        }
+        if (mask & MeshRendererBit) {
+#ifndef ENGINE_HEADLESS
+            readColumn<MeshRenderer>(rows, renderers + nextRenderer, count, readRenderer);
+#endif
+            nextRenderer += count;
+        }
+    }
+
+    // Parents last: a parent may sit in a later group
+    for (uint32_t i = 0; i < header.sections[TransformSection].count; ++i) {
+        const TransformRecord& record = transforms[i];
+        if (record.parent != NO_PARENT) {
+            entities[record.entity]->getComponent<Transform>()->setParent(
+                entities[record.parent]->getComponent<Transform>());
+        }
+    }
+
+    return true;
+}
+
+bool SceneSnapshot::load(Scene& scene, const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Failed to open scene snapshot: " << path << std::endl;
+        return false;
+    }
+    return instantiate(scene, file.getData(), file.getSize());
+}
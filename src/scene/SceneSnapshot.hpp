@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Scene;
+
+// Binary scene files that load without parsing. A snapshot is one
+// relocatable blob: a header followed by flat arrays of POD records, with
+// every cross-reference stored as an index or byte offset instead of a
+// pointer. Loading maps the file, validates the header and then walks the
+// record arrays in place.
+//
+// Covered: entity names, Transform (TRS and parent), Box/Sphere/Capsule
+// colliders, Light and MeshRenderer (mesh and material by ResourceManager
+// name). Other components are not written. Data is little-endian.
+class SceneSnapshot {
+public:
+    static constexpr uint32_t MAGIC = 0x424E4353; // "SCNB"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t NO_STRING = 0xFFFFFFFFu;
+    static constexpr uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    // Bit per component kind in GroupRecord::components. Fixed here rather
+    // than taken from component type ids so files survive type list changes.
+    enum ComponentBit : uint32_t {
+        TransformBit       = 1u << 0,
+        BoxColliderBit     = 1u << 1,
+        SphereColliderBit  = 1u << 2,
+        CapsuleColliderBit = 1u << 3,
+        LightBit           = 1u << 4,
+        MeshRendererBit    = 1u << 5
+    };
+
+    enum SectionId : uint32_t {
+        EntitySection,
+        GroupSection,
+        TransformSection,
+        BoxColliderSection,
+        SphereColliderSection,
+        CapsuleColliderSection,
+        LightSection,
+        MeshRendererSection,
+        StringSection,
+        SECTION_COUNT
+    };
+
+    struct Section {
+        uint64_t offset; // From the start of the blob, 16-byte aligned
+        uint32_t count;
+        uint32_t stride; // sizeof the record, or 1 for the string table
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t size; // Whole blob, header included
+        Section sections[SECTION_COUNT];
+    };
+
+    // Entities are stored sorted by component set, so each group becomes
+    // one archetype and its entities are created back to back
+    struct EntityRecord {
+        uint32_t name; // String table offset
+    };
+
+    struct GroupRecord {
+        uint32_t components; // ComponentBit mask
+        uint32_t firstEntity;
+        uint32_t count;
+    };
+
+    struct TransformRecord {
+        uint32_t entity;
+        uint32_t parent; // Entity index, NO_PARENT for roots
+        float position[3];
+        float rotation[4]; // w, x, y, z
+        float scale[3];
+    };
+
+    struct ColliderRecord {
+        uint32_t entity;
+        uint32_t trigger;
+        float restitution;
+        float friction;
+        float size[3]; // Box: extents. Sphere: radius in [0]. Capsule: radius, height.
+    };
+
+    struct LightRecord {
+        uint32_t entity;
+        uint32_t type;
+        float color[3];
+        float intensity;
+        float range;
+        float spotAngle;
+    };
+
+    struct MeshRendererRecord {
+        uint32_t entity;
+        uint32_t mesh;     // String table offset or NO_STRING
+        uint32_t material; // String table offset or NO_STRING
+    };
+
+    // Builds the blob for every entity in the scene
+    static std::vector<std::byte> serialize(Scene& scene);
+    static bool save(Scene& scene, const std::string& path);
+
+    // Adds the snapshot's entities to `scene`; existing entities are kept.
+    // `data` must be 8-byte aligned. Nothing is created if validation fails.
+    static bool instantiate(Scene& scene, const std::byte* data, size_t size);
+
+    // Memory-maps the file and instantiates it
+    static bool load(Scene& scene, const std::string& path);
+};
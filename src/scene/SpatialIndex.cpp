@@ -0,0 +1,139 @@
+#include "SpatialIndex.hpp"
+#include "Scene.hpp"
+#include "../components/MeshRenderer.hpp"
+#include "../components/Transform.hpp"
+#include "../core/Profiler.hpp"
+#include "../physics/CapsuleCollider.hpp"
+#include "../physics/Collider.hpp"
+
+SpatialIndex::SpatialIndex()
+    : syncStamp(0)
+{
+    layers[static_cast<size_t>(Layer::Renderables)].keepsExactBounds = true;
+}
+
+void SpatialIndex::sync(Scene& scene) {
+    PROFILE_SCOPE("SpatialIndex::sync");
+    const TransformSystem& transforms = TransformSystem::getInstance();
+    syncStamp++;
+
+    LayerData& colliders = layers[static_cast<size_t>(Layer::Colliders)];
+    auto syncCollider = [&](Entity* entity, const Collider& collider, const Transform& transform) {
+        syncEntity(colliders, entity, transforms.hasWorldChanged(transform.getNode()), [&collider]() {
+            AABB bounds;
+            collider.calculateBounds(bounds.min, bounds.max);
+            return bounds;
+        });
+    };
+    scene.view<BoxCollider, Transform>().each([&](Entity* entity, BoxCollider& collider, Transform& transform) {
+        syncCollider(entity, collider, transform);
+    });
+    scene.view<SphereCollider, Transform>().each([&](Entity* entity, SphereCollider& collider, Transform& transform) {
+        syncCollider(entity, collider, transform);
+    });
+    scene.view<CapsuleCollider, Transform>().each([&](Entity* entity, CapsuleCollider& collider, Transform& transform) {
+        syncCollider(entity, collider, transform);
+    });
+    removeUnseen(colliders);
+
+    LayerData& renderables = layers[static_cast<size_t>(Layer::Renderables)];
+    scene.view<MeshRenderer, Transform>().each([&](Entity* entity, MeshRenderer& renderer, Transform& transform) {
+        syncEntity(renderables, entity, transforms.hasWorldChanged(transform.getNode()), [&]() {
+            return renderer.getLocalBounds().transformed(transform.getWorldMatrix());
+        });
+    });
+    removeUnseen(renderables);
+}
+
+void SpatialIndex::clear() {
+    for (LayerData& layer : layers) {
+        layer.tree.clear();
+        layer.proxies.clear();
+        layer.owners.clear();
+        layer.lastSeen.clear();
+        layer.exactBounds.clear();
+        layer.cullIndices.clear();
+    }
+}
+
+void SpatialIndex::remove(EntityHandle handle) {
+    for (LayerData& layer : layers) {
+        if (handle.index >= layer.proxies.size() || layer.owners[handle.index] != handle) continue;
+        destroyProxy(layer, handle.index);
+    }
+}
+
+CullingSet::Stats SpatialIndex::cull(Layer layer, const Frustum& frustum, std::vector<Entity*>& visible) const {
+    const LayerData& data = layers[static_cast<size_t>(layer)];
+    cullScratch.clear();
+    CullingSet::Stats stats = data.exactBounds.cull(frustum, cullScratch);
+
+    visible.reserve(visible.size() + cullScratch.size());
+    for (uint32_t index : cullScratch) {
+        int32_t proxy = data.proxies[data.exactBounds.getKey(index)];
+        visible.push_back(static_cast<Entity*>(data.tree.getUserData(proxy)));
+    }
+    return stats;
+}
+
+template<typename BoundsFunction>
+void SpatialIndex::syncEntity(LayerData& layer, Entity* entity, bool worldChanged, const BoundsFunction& computeBounds) {
+    EntityHandle handle = entity->getHandle();
+    if (handle.index >= layer.proxies.size()) {
+        layer.proxies.resize(handle.index + 1, DynamicAABBTree::NULL_NODE);
+        layer.owners.resize(handle.index + 1);
+        layer.lastSeen.resize(handle.index + 1, 0);
+        if (layer.keepsExactBounds) {
+            layer.cullIndices.resize(handle.index + 1, CullingSet::NO_KEY);
+        }
+    }
+
+    // One proxy per entity and layer, even with several colliders
+    if (layer.lastSeen[handle.index] == syncStamp) return;
+    layer.lastSeen[handle.index] = syncStamp;
+
+    int32_t& proxy = layer.proxies[handle.index];
+    if (proxy != DynamicAABBTree::NULL_NODE && layer.owners[handle.index] != handle) {
+        // Slot recycled since the last sync
+        destroyProxy(layer, handle.index);
+    }
+
+    if (proxy == DynamicAABBTree::NULL_NODE) {
+        AABB bounds = computeBounds();
+        proxy = layer.tree.createProxy(bounds, entity);
+        layer.owners[handle.index] = handle;
+        if (layer.keepsExactBounds) {
+            layer.cullIndices[handle.index] = layer.exactBounds.add(bounds, handle.index);
+        }
+    } else if (worldChanged) {
+        AABB bounds = computeBounds();
+        glm::vec3 displacement = bounds.getCenter() - layer.tree.getFatBounds(proxy).getCenter();
+        layer.tree.moveProxy(proxy, bounds, displacement);
+        if (layer.keepsExactBounds) {
+            layer.exactBounds.update(layer.cullIndices[handle.index], bounds);
+        }
+    }
+}
+
+void SpatialIndex::removeUnseen(LayerData& layer) {
+    for (size_t slot = 0; slot < layer.proxies.size(); ++slot) {
+        if (layer.proxies[slot] != DynamicAABBTree::NULL_NODE && layer.lastSeen[slot] != syncStamp) {
+            destroyProxy(layer, slot);
+        }
+    }
+}
+
+void SpatialIndex::destroyProxy(LayerData& layer, size_t slot) {
+    int32_t& proxy = layer.proxies[slot];
+    if (proxy == DynamicAABBTree::NULL_NODE) return;
+    layer.tree.destroyProxy(proxy);
+    proxy = DynamicAABBTree::NULL_NODE;
+
+    if (layer.keepsExactBounds) {
+        uint32_t movedSlot = layer.exactBounds.remove(layer.cullIndices[slot]);
+        if (movedSlot != CullingSet::NO_KEY) {
+            layer.cullIndices[movedSlot] = layer.cullIndices[slot];
+        }
+        layer.cullIndices[slot] = CullingSet::NO_KEY;
+    }
+}
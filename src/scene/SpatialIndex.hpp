@@ -0,0 +1,113 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "CullingSet.hpp"
+#include "DynamicAABBTree.hpp"
+#include "EntityHandle.hpp"
+
+class Entity;
+class Scene;
+
+// A scene's spatial queries: one DynamicAABBTree per layer, holding world
+// bounds of entities that have a Transform and the layer's components.
+// Scene::update calls sync() once the transforms are final, which only
+// touches entities whose world matrix changed or that gained or lost the
+// components; the tree refits incrementally instead of being rebuilt.
+//
+// Between syncs the trees hold last tick's bounds. The fat margin usually
+// covers motion since then, but callers should narrow-phase against live
+// component data.
+//
+// The Renderables layer also keeps exact world bounds in a CullingSet, for
+// cull(): the renderer tests every box each frame with SIMD instead of
+// walking the tree, and gets no fat-margin false positives.
+class SpatialIndex {
+public:
+    enum class Layer {
+        Colliders,    // Box, sphere and capsule colliders
+        Renderables,  // MeshRenderers, by their mesh bounds
+        Count
+    };
+
+    SpatialIndex();
+
+    void sync(Scene& scene);
+    void clear();
+
+    // Drops the entity from every layer at once. Scene::destroyEntity calls
+    // this so queries never return a destroyed entity.
+    void remove(EntityHandle handle);
+
+    // callback(Entity*) for every entity whose bounds overlap the query
+    template<typename Callback>
+    void queryAABB(Layer layer, const AABB& bounds, Callback&& callback) const {
+        const DynamicAABBTree& tree = getTree(layer);
+        tree.query(bounds, [&](int32_t proxy) {
+            callback(static_cast<Entity*>(tree.getUserData(proxy)));
+            return true;
+        });
+    }
+
+    template<typename Callback>
+    void querySphere(Layer layer, const glm::vec3& center, float radius, Callback&& callback) const {
+        const DynamicAABBTree& tree = getTree(layer);
+        tree.querySphere(center, radius, [&](int32_t proxy) {
+            callback(static_cast<Entity*>(tree.getUserData(proxy)));
+            return true;
+        });
+    }
+
+    template<typename Callback>
+    void queryFrustum(Layer layer, const Frustum& frustum, Callback&& callback) const {
+        const DynamicAABBTree& tree = getTree(layer);
+        tree.queryFrustum(frustum, [&](int32_t proxy) {
+            callback(static_cast<Entity*>(tree.getUserData(proxy)));
+            return true;
+        });
+    }
+
+    // Appends every entity whose exact bounds intersect the frustum. Only
+    // layers that keep exact bounds (Renderables) return anything. Uses a
+    // shared scratch buffer, so calls must not overlap.
+    CullingSet::Stats cull(Layer layer, const Frustum& frustum, std::vector<Entity*>& visible) const;
+
+    // callback(Entity*, float maxDistance) -> float, as DynamicAABBTree::raycast
+    template<typename Callback>
+    void raycast(Layer layer, const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                 Callback&& callback) const {
+        const DynamicAABBTree& tree = getTree(layer);
+        tree.raycast(origin, direction, maxDistance, [&](int32_t proxy, float distance) {
+            return callback(static_cast<Entity*>(tree.getUserData(proxy)), distance);
+        });
+    }
+
+    const DynamicAABBTree& getTree(Layer layer) const { return layers[static_cast<size_t>(layer)].tree; }
+    const CullingSet& getCullingSet(Layer layer) const { return layers[static_cast<size_t>(layer)].exactBounds; }
+
+private:
+    // Proxies are found by entity slot index; `owners` tells a recycled slot
+    // from the entity that was indexed there. With `keepsExactBounds`, each
+    // proxy has a box in `exactBounds` at `cullIndices[slot]`, keyed by slot.
+    struct LayerData {
+        DynamicAABBTree tree;
+        std::vector<int32_t> proxies;
+        std::vector<EntityHandle> owners;
+        std::vector<uint32_t> lastSeen;
+
+        bool keepsExactBounds = false;
+        CullingSet exactBounds;
+        std::vector<uint32_t> cullIndices;
+    };
+
+    std::array<LayerData, static_cast<size_t>(Layer::Count)> layers;
+    uint32_t syncStamp;
+    mutable std::vector<uint32_t> cullScratch;
+
+    // Adds or refits the entity's proxy; `worldChanged` false skips known
+    // entities whose bounds cannot have moved
+    template<typename BoundsFunction>
+    void syncEntity(LayerData& layer, Entity* entity, bool worldChanged, const BoundsFunction& computeBounds);
+    void removeUnseen(LayerData& layer);
+    void destroyProxy(LayerData& layer, size_t slot);
+};
@@ -0,0 +1,172 @@
+#include "SystemScheduler.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+
+namespace {
+    double nowMs() {
+        using namespace std::chrono;
+        return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+SystemScheduler::SystemScheduler()
+    : graphDirty(true)
+    , timelineEnabled(false)
+    , frameStart(0.0)
+    , currentScene(nullptr)
+    , currentDeltaTime(0.0f)
+    , currentFrame(nullptr)
+{}
+
+SystemScheduler::~SystemScheduler() = default;
+
+void SystemScheduler::addSystem(const std::string& name, const SystemAccess& access, const SystemFunction& function) {
+    systems.push_back({ name, Profiler::getInstance().intern(name), access, function, {}, 0 });
+    graphDirty = true;
+}
+
+bool SystemScheduler::removeSystem(const std::string& name) {
+    auto it = std::find_if(systems.begin(), systems.end(),
+        [&name](const SystemNode& node) { return node.name == name; });
+    if (it == systems.end()) return false;
+
+    systems.erase(it);
+    graphDirty = true;
+    return true;
+}
+
+void SystemScheduler::buildGraph() {
+    for (auto& system : systems) {
+        system.successors.clear();
+        system.dependencyCount = 0;
+    }
+
+    // Edges only point forward in registration order, so the graph is acyclic
+    for (size_t later = 0; later < systems.size(); ++later) {
+        for (size_t earlier = 0; earlier < later; ++earlier) {
+            if (systems[earlier].access.conflictsWith(systems[later].access)) {
+                systems[earlier].successors.push_back(later);
+                systems[later].dependencyCount++;
+            }
+        }
+    }
+
+    pendingDependencies.reset(new std::atomic<int>[systems.size()]);
+    graphDirty = false;
+}
+
+void SystemScheduler::run(Scene& scene, float deltaTime) {
+    if (graphDirty) {
+        buildGraph();
+    }
+
+    timeline.resize(timelineEnabled ? systems.size() : 0);
+    frameStart = nowMs();
+    currentScene = &scene;
+    currentDeltaTime = deltaTime;
+    currentFrame = nullptr;
+
+    JobSystem& jobs = JobSystem::getInstance();
+    if (!jobs.isInitialized()) {
+        for (size_t i = 0; i < systems.size(); ++i) {
+            runSystem(i);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < systems.size(); ++i) {
+        pendingDependencies[i].store(systems[i].dependencyCount, std::memory_order_relaxed);
+    }
+
+    JobCounter frame;
+    currentFrame = &frame;
+    for (size_t i = 0; i < systems.size(); ++i) {
+        if (systems[i].dependencyCount == 0) {
+            jobs.run([this, i]() { runSystem(i); }, &frame);
+        }
+    }
+    jobs.wait(frame);
+    currentFrame = nullptr;
+}
+
+void SystemScheduler::runSystem(size_t index) {
+    const SystemNode& system = systems[index];
+    JobSystem& jobs = JobSystem::getInstance();
+
+    double start = timelineEnabled ? nowMs() : 0.0;
+    {
+        PROFILE_SCOPE(system.profileName);
+        system.function(*currentScene, currentDeltaTime);
+    }
+    if (timelineEnabled) {
+        int thread = jobs.isInitialized() ? jobs.getThreadIndex() : 0;
+        timeline[index] = { system.name, thread, start - frameStart, nowMs() - frameStart };
+    }
+
+    // Serial fallback already runs in a valid order
+    JobCounter* frame = currentFrame;
+    if (!frame) return;
+
+    // Successors are queued against the frame counter before this job
+    // finishes, so the frame cannot drain while any of them is still pending
+    for (size_t successor : system.successors) {
+        if (pendingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            jobs.run([this, successor]() { runSystem(successor); }, frame);
+        }
+    }
+}
+
+void SystemScheduler::dumpTimeline(std::ostream& out) const {
+    if (timeline.empty()) {
+        out << "No timeline recorded (enable with setTimelineEnabled)\n";
+        return;
+    }
+
+    const int chartWidth = 50;
+    double frameEnd = 0.0;
+    size_t nameWidth = 6;
+    for (const auto& entry : timeline) {
+        frameEnd = std::max(frameEnd, entry.endMs);
+        nameWidth = std::max(nameWidth, entry.system.size());
+    }
+    double scale = frameEnd > 0.0 ? chartWidth / frameEnd : 0.0;
+
+    std::vector<const TimelineEntry*> sorted;
+    for (const auto& entry : timeline) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const TimelineEntry* a, const TimelineEntry* b) { return a->startMs < b->startMs; });
+
+    out << std::fixed << std::setprecision(3);
+    out << "Frame: " << frameEnd << " ms, " << timeline.size() << " systems\n";
+
+    for (const TimelineEntry* entry : sorted) {
+        int begin = static_cast<int>(entry->startMs * scale);
+        int end = std::max(begin + 1, static_cast<int>(entry->endMs * scale));
+        std::string bar(chartWidth + 1, ' ');
+        for (int c = begin; c < end && c <= chartWidth; ++c) {
+            bar[c] = '#';
+        }
+
+        out << std::left << std::setw(static_cast<int>(nameWidth)) << entry->system
+            << " T" << std::setw(2) << entry->thread
+            << " |" << bar << "| "
+            << entry->startMs << " - " << entry->endMs << " ms";
+
+        // Anything whose time span intersects ours ran concurrently
+        bool first = true;
+        for (const TimelineEntry* other : sorted) {
+            if (other == entry) continue;
+            if (other->startMs < entry->endMs && entry->startMs < other->endMs) {
+                out << (first ? "  overlaps: " : ", ") << other->system;
+                first = false;
+            }
+        }
+        out << '\n';
+    }
+}
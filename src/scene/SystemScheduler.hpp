@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ComponentStorage.hpp"
+
+class Scene;
+class JobCounter;
+
+// Component types a system touches. Systems whose accesses do not conflict
+// may run at the same time on different worker threads.
+struct SystemAccess {
+    ComponentSignature reads;
+    ComponentSignature writes;
+    bool exclusive = false; // Unknown side effects: never overlaps another system
+
+    template<typename... T>
+    SystemAccess& read() {
+        (reads.set(getComponentTypeId<T>()), ...);
+        return *this;
+    }
+
+    template<typename... T>
+    SystemAccess& write() {
+        (writes.set(getComponentTypeId<T>()), ...);
+        return *this;
+    }
+
+    static SystemAccess makeExclusive() {
+        SystemAccess access;
+        access.exclusive = true;
+        return access;
+    }
+
+    bool conflictsWith(const SystemAccess& other) const {
+        if (exclusive || other.exclusive) return true;
+        return (writes & (other.reads | other.writes)).any() || (reads & other.writes).any();
+    }
+};
+
+// Runs registered systems through the JobSystem. A system depends on every
+// earlier-registered system it conflicts with, so the result always matches
+// running them one after another in registration order.
+class SystemScheduler {
+public:
+    using SystemFunction = std::function<void(Scene&, float)>;
+
+    struct TimelineEntry {
+        std::string system;
+        int thread;       // JobSystem thread index, 0 is the main thread
+        double startMs;   // Relative to the start of the frame
+        double endMs;
+    };
+
+    SystemScheduler();
+    ~SystemScheduler();
+
+    void addSystem(const std::string& name, const SystemAccess& access, const SystemFunction& function);
+    bool removeSystem(const std::string& name);
+    size_t getSystemCount() const { return systems.size(); }
+
+    // Runs every system once. Falls back to registration order on the calling
+    // thread when the JobSystem is not running.
+    void run(Scene& scene, float deltaTime);
+
+    // Last frame's per-system timings, indexed like the registration order
+    void setTimelineEnabled(bool enabled) { timelineEnabled = enabled; }
+    const std::vector<TimelineEntry>& getTimeline() const { return timeline; }
+
+    // Text chart of the last frame: one row per system with its thread, time
+    // span and the systems it overlapped with
+    void dumpTimeline(std::ostream& out) const;
+
+private:
+    struct SystemNode {
+        std::string name;
+        const char* profileName; // Interned copy of name for profiler scopes
+        SystemAccess access;
+        SystemFunction function;
+        std::vector<size_t> successors;
+        int dependencyCount;
+    };
+
+    std::vector<SystemNode> systems;
+    std::unique_ptr<std::atomic<int>[]> pendingDependencies;
+    bool graphDirty;
+
+    bool timelineEnabled;
+    std::vector<TimelineEntry> timeline;
+    double frameStart;
+
+    // State of the run in progress, so jobs only capture `this` and an index
+    Scene* currentScene;
+    float currentDeltaTime;
+    JobCounter* currentFrame;
+
+    void buildGraph();
+    void runSystem(size_t index);
+};
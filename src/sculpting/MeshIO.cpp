@@ -1,4 +1,5 @@
 #include "MeshIO.hpp"
+#include "../core/AllocationTracker.hpp"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -53,6 +54,7 @@ bool MeshIO::saveToOBJ(const SculptMesh& mesh, const std::string& filepath) {
 }
 
 bool MeshIO::loadFromOBJ(SculptMesh& mesh, const std::string& filepath) {
+    MEMORY_TAG(Sculpt);
     std::ifstream file(filepath);
     if (!file.is_open()) {
         std::cerr << "Failed to open file: " << filepath << std::endl;
@@ -144,6 +146,7 @@ bool MeshIO::saveToBinary(const SculptMesh& mesh, const std::string& filepath) {
 }
 
 bool MeshIO::loadFromBinary(SculptMesh& mesh, const std::string& filepath) {
+    MEMORY_TAG(Sculpt);
     std::ifstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
         std::cerr << "Failed to open file: " << filepath << std::endl;
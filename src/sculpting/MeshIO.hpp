@@ -1,5 +1,6 @@
 #pragma once
 #include "SculptMesh.hpp"
+#include <cstdint>
 #include <string>
 
 class MeshIO {
@@ -1,7 +1,227 @@
 #include "SculptMesh.hpp"
+#include "../core/AllocationTracker.hpp"
+#include <glm/gtc/constants.hpp>
 #include <glm/gtx/rotate_vector.hpp>
+#include <algorithm>
+#include <cmath>
 
-// ... (keeping existing implementations) ...
+// Headless builds have no GL, so generateMesh() has nothing to upload to
+#ifndef ENGINE_HEADLESS
+#include "../renderer/Mesh.hpp"
+#endif
+
+SculptMesh::SculptMesh() = default;
+SculptMesh::~SculptMesh() = default;
+
+void SculptMesh::initializeAsSphere(float radius, int subdivisions) {
+    MEMORY_TAG(Sculpt);
+    // Latitude/longitude sphere; each subdivision doubles both resolutions
+    const int rings = 4 << std::max(0, subdivisions);
+    const int segments = rings * 2;
+
+    vertices.clear();
+    indices.clear();
+    vertices.reserve((rings + 1) * (segments + 1));
+    for (int ring = 0; ring <= rings; ++ring) {
+        float v = static_cast<float>(ring) / rings;
+        float phi = v * glm::pi<float>();
+        for (int segment = 0; segment <= segments; ++segment) {
+            float u = static_cast<float>(segment) / segments;
+            float theta = u * glm::two_pi<float>();
+
+            Vertex vertex{};
+            vertex.normal = glm::vec3(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+            vertex.position = vertex.normal * radius;
+            vertex.texCoords = glm::vec2(u, v);
+            vertices.push_back(vertex);
+        }
+    }
+
+    indices.reserve(rings * segments * 6);
+    for (int ring = 0; ring < rings; ++ring) {
+        for (int segment = 0; segment < segments; ++segment) {
+            unsigned int a = ring * (segments + 1) + segment;
+            unsigned int b = a + segments + 1;
+            indices.insert(indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+        }
+    }
+}
+
+void SculptMesh::initializeAsCube(float size, int subdivisions) {
+    MEMORY_TAG(Sculpt);
+    const int cells = std::max(1, subdivisions);
+    const float half = size * 0.5f;
+    const glm::vec3 normals[6] = {
+        { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
+
+    vertices.clear();
+    indices.clear();
+    for (const glm::vec3& normal : normals) {
+        // Two axes spanning the face, chosen so triangles wind outwards
+        glm::vec3 tangent = std::abs(normal.y) > 0.5f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+        glm::vec3 bitangent = glm::cross(normal, tangent);
+
+        unsigned int base = static_cast<unsigned int>(vertices.size());
+        for (int y = 0; y <= cells; ++y) {
+            for (int x = 0; x <= cells; ++x) {
+                glm::vec2 uv(static_cast<float>(x) / cells, static_cast<float>(y) / cells);
+                Vertex vertex{};
+                vertex.position = (normal + tangent * (uv.x * 2.0f - 1.0f) + bitangent * (uv.y * 2.0f - 1.0f)) * half;
+                vertex.normal = normal;
+                vertex.texCoords = uv;
+                vertices.push_back(vertex);
+            }
+        }
+        for (int y = 0; y < cells; ++y) {
+            for (int x = 0; x < cells; ++x) {
+                unsigned int a = base + y * (cells + 1) + x;
+                unsigned int b = a + cells + 1;
+                indices.insert(indices.end(), { a, a + 1, b, a + 1, b + 1, b });
+            }
+        }
+    }
+}
+
+void SculptMesh::initializeAsPlane(float width, float height, int subdivisions) {
+    MEMORY_TAG(Sculpt);
+    const int cells = std::max(1, subdivisions);
+
+    vertices.clear();
+    indices.clear();
+    vertices.reserve((cells + 1) * (cells + 1));
+    for (int z = 0; z <= cells; ++z) {
+        for (int x = 0; x <= cells; ++x) {
+            glm::vec2 uv(static_cast<float>(x) / cells, static_cast<float>(z) / cells);
+            Vertex vertex{};
+            vertex.position = glm::vec3((uv.x - 0.5f) * width, 0.0f, (uv.y - 0.5f) * height);
+            vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+            vertex.texCoords = uv;
+            vertices.push_back(vertex);
+        }
+    }
+
+    indices.reserve(cells * cells * 6);
+    for (int z = 0; z < cells; ++z) {
+        for (int x = 0; x < cells; ++x) {
+            unsigned int a = z * (cells + 1) + x;
+            unsigned int b = a + cells + 1;
+            indices.insert(indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+        }
+    }
+}
+
+void SculptMesh::pull(const glm::vec3& position, float radius, float strength) {
+    deformVertices(position, radius, strength, [&](Vertex& vertex, float influence) {
+        vertex.position += vertex.normal * influence * radius * 0.1f;
+    });
+
+    recalculateNormals();
+}
+
+void SculptMesh::push(const glm::vec3& position, float radius, float strength) {
+    deformVertices(position, radius, strength, [&](Vertex& vertex, float influence) {
+        vertex.position -= vertex.normal * influence * radius * 0.1f;
+    });
+
+    recalculateNormals();
+}
+
+void SculptMesh::smooth(const glm::vec3& position, float radius, float strength) {
+    MEMORY_TAG(Sculpt);
+    // Laplacian relaxation: each affected vertex moves towards the average of
+    // the vertices it shares a triangle with
+    std::vector<glm::vec3> neighbourSum(vertices.size(), glm::vec3(0.0f));
+    std::vector<unsigned int> neighbourCount(vertices.size(), 0);
+    const float radiusSquared = radius * radius;
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        for (int corner = 0; corner < 3; ++corner) {
+            unsigned int index = indices[i + corner];
+            glm::vec3 offset = vertices[index].position - position;
+            if (glm::dot(offset, offset) > radiusSquared) continue;
+
+            neighbourSum[index] += vertices[indices[i + (corner + 1) % 3]].position +
+                                   vertices[indices[i + (corner + 2) % 3]].position;
+            neighbourCount[index] += 2;
+        }
+    }
+
+    std::vector<glm::vec3> original(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        original[i] = vertices[i].position;
+    }
+
+    deformVertices(position, radius, strength, [&](Vertex& vertex, float influence) {
+        size_t index = &vertex - vertices.data();
+        if (neighbourCount[index] == 0) return;
+        glm::vec3 average = neighbourSum[index] / static_cast<float>(neighbourCount[index]);
+        vertex.position = glm::mix(original[index], average, glm::min(influence, 1.0f));
+    });
+
+    recalculateNormals();
+}
+
+void SculptMesh::pinch(const glm::vec3& position, float radius, float strength) {
+    deformVertices(position, radius, strength, [&](Vertex& vertex, float influence) {
+        // Draw vertices towards the brush centre within their tangent plane
+        glm::vec3 toCenter = position - vertex.position;
+        toCenter -= vertex.normal * glm::dot(toCenter, vertex.normal);
+        vertex.position += toCenter * glm::min(influence, 1.0f) * 0.5f;
+    });
+
+    recalculateNormals();
+}
+
+void SculptMesh::recalculateNormals() {
+    for (auto& vertex : vertices) {
+        vertex.normal = glm::vec3(0.0f);
+    }
+
+    // Area-weighted: the unnormalised cross product is twice the triangle area
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        Vertex& v0 = vertices[indices[i]];
+        Vertex& v1 = vertices[indices[i + 1]];
+        Vertex& v2 = vertices[indices[i + 2]];
+        glm::vec3 faceNormal = glm::cross(v1.position - v0.position, v2.position - v0.position);
+        v0.normal += faceNormal;
+        v1.normal += faceNormal;
+        v2.normal += faceNormal;
+    }
+
+    for (auto& vertex : vertices) {
+        float length = glm::length(vertex.normal);
+        vertex.normal = length > 0.0f ? vertex.normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+}
+
+std::shared_ptr<Mesh> SculptMesh::generateMesh() {
+#ifndef ENGINE_HEADLESS
+    auto mesh = std::make_shared<Mesh>();
+    mesh->initialize(vertices, indices);
+    return mesh;
+#else
+    return nullptr;
+#endif
+}
+
+void SculptMesh::deformVertices(const glm::vec3& position, float radius, float strength,
+                                const std::function<void(Vertex&, float)>& deformFunc) {
+    const float radiusSquared = radius * radius;
+    for (auto& vertex : vertices) {
+        glm::vec3 offset = vertex.position - position;
+        float distanceSquared = glm::dot(offset, offset);
+        if (distanceSquared > radiusSquared) continue;
+
+        deformFunc(vertex, calculateFalloff(std::sqrt(distanceSquared), radius) * strength);
+    }
+}
+
+float SculptMesh::calculateFalloff(float distance, float radius) {
+    // Smoothstep from 1 at the centre to 0 at the rim
+    float t = glm::clamp(1.0f - distance / radius, 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
 
 void SculptMesh::flatten(const glm::vec3& position, float radius, float strength, const glm::vec3& normal) {
     glm::vec3 targetPlaneNormal = glm::normalize(normal);
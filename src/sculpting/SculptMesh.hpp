@@ -1,7 +1,11 @@
 #pragma once
+#include <functional>
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
-#include "../renderer/Mesh.hpp"
+#include "../renderer/Vertex.hpp"
+
+class Mesh;
 
 class SculptMesh {
 public:
@@ -1,6 +1,8 @@
 #include "SculptingSystem.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include "../components/Transform.hpp"
+#include "../core/AllocationTracker.hpp"
+#include "../core/Profiler.hpp"
 
 void SculptingSystem::initialize() {
     activeCamera = nullptr;
@@ -8,6 +10,8 @@ void SculptingSystem::initialize() {
 }
 
 void SculptingSystem::update(float deltaTime) {
+    PROFILE_SCOPE("SculptingSystem::update");
+    MEMORY_TAG(Sculpt);
     if (!targetMesh || !activeCamera) return;
 
     auto& input = Input::getInstance();
@@ -19,7 +23,7 @@ void SculptingSystem::update(float deltaTime) {
     }
 
     // Handle sculpting input
-    if (input.isMouseButtonPressed(GLFW_MOUSE_BUTTON_LEFT)) {
+    if (input.isMouseButtonPressed(MouseButton::Left)) {
         glm::vec3 hitPoint;
         if (castRayToMesh(input.getMousePosition(), hitPoint)) {
             activeTool.apply(*targetMesh, hitPoint);
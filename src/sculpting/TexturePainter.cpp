@@ -1,7 +1,47 @@
 #include "TexturePainter.hpp"
+#include "../core/AllocationTracker.hpp"
+#include "../core/Profiler.hpp"
 #include <algorithm>
 #include <cmath>
 
+// Headless builds composite on the CPU only and never upload
+#ifndef ENGINE_HEADLESS
+#include "../renderer/Texture.hpp"
+#endif
+
+TexturePainter::TexturePainter()
+    : textureWidth(0)
+    , textureHeight(0)
+    , brushType(BrushType::Color)
+    , brushRadius(10.0f)
+    , brushHardness(0.5f)
+{}
+
+TexturePainter::~TexturePainter() = default;
+
+void TexturePainter::initialize(int width, int height) {
+    MEMORY_TAG(Painting);
+    textureWidth = width;
+    textureHeight = height;
+    layers.clear();
+    composite.assign(static_cast<size_t>(width) * height * 4, 0);
+    addLayer("Base Layer");
+
+#ifndef ENGINE_HEADLESS
+    finalTexture = std::make_shared<Texture>();
+    finalTexture->loadFromData(composite.data(), width, height, Texture::Format::RGBA);
+#endif
+}
+
+int TexturePainter::addLayer(const std::string& name) {
+    MEMORY_TAG(Painting);
+    Layer layer;
+    layer.name = name;
+    layer.pixels.assign(static_cast<size_t>(textureWidth) * textureHeight * 4, 0);
+    layers.push_back(std::move(layer));
+    return static_cast<int>(layers.size()) - 1;
+}
+
 float TexturePainter::calculateBrushStrength(float distance) {
     if (distance >= brushRadius) return 0.0f;
     
@@ -47,8 +87,7 @@ void TexturePainter::applyBrush(const glm::vec2& uv, const std::function<void(in
 glm::vec4 TexturePainter::getPixel(int layerIndex, int x, int y) {
     if (layerIndex < 0 || layerIndex >= layers.size()) return glm::vec4(0.0f);
     
-    // Get raw pixel data from texture
-    unsigned char* data = layers[layerIndex].texture->getData();
+    const unsigned char* data = layers[layerIndex].pixels.data();
     int index = (y * textureWidth + x) * 4;
     
     return glm::vec4(
@@ -62,7 +101,7 @@ glm::vec4 TexturePainter::getPixel(int layerIndex, int x, int y) {
 void TexturePainter::setPixel(int layerIndex, int x, int y, const glm::vec4& color) {
     if (layerIndex < 0 || layerIndex >= layers.size()) return;
     
-    unsigned char* data = layers[layerIndex].texture->getData();
+    unsigned char* data = layers[layerIndex].pixels.data();
     int index = (y * textureWidth + x) * 4;
     
     data[index] = static_cast<unsigned char>(color.r * 255.0f);
@@ -71,15 +110,18 @@ void TexturePainter::setPixel(int layerIndex, int x, int y, const glm::vec4& col
     data[index + 3] = static_cast<unsigned char>(color.a * 255.0f);
 }
 
-void TexturePainter::updateFinalTexture() {
-    // Create temporary buffer for final result
-    std::vector<unsigned char> finalData(textureWidth * textureHeight * 4, 0);
+void TexturePainter::compositeLayers() {
+    PROFILE_SCOPE("TexturePainter::compositeLayers");
+    MEMORY_TAG(Painting);
+    // The composite buffer is reused between calls rather than reallocated
+    std::vector<unsigned char>& finalData = composite;
+    std::fill(finalData.begin(), finalData.end(), 0);
     
     // Blend all visible layers
     for (const auto& layer : layers) {
         if (!layer.visible) continue;
         
-        unsigned char* layerData = layer.texture->getData();
+        const unsigned char* layerData = layer.pixels.data();
         for (int i = 0; i < textureWidth * textureHeight * 4; i += 4) {
             // Get source and destination colors
             glm::vec4 srcColor(
@@ -106,28 +148,36 @@ void TexturePainter::updateFinalTexture() {
             finalData[i + 3] = static_cast<unsigned char>(result.a * 255.0f);
         }
     }
-    
-    // Update final texture
-    finalTexture->update(finalData.data());
+}
+
+void TexturePainter::updateFinalTexture() {
+    PROFILE_SCOPE("TexturePainter::updateFinalTexture");
+    compositeLayers();
+
+#ifndef ENGINE_HEADLESS
+    if (finalTexture) {
+        finalTexture->update(composite.data());
+    }
+#endif
 }
 
 glm::vec4 TexturePainter::blendColors(const glm::vec4& src, const glm::vec4& dst, int blendMode) {
     switch (blendMode) {
         case 0: // Normal
             return glm::vec4(
-                src.rgb() * src.a + dst.rgb() * (1.0f - src.a),
+                glm::vec3(src) * src.a + glm::vec3(dst) * (1.0f - src.a),
                 src.a + dst.a * (1.0f - src.a)
             );
             
         case 1: // Multiply
             return glm::vec4(
-                src.rgb() * dst.rgb(),
+                glm::vec3(src) * glm::vec3(dst),
                 src.a * dst.a
             );
             
         case 2: // Add
             return glm::vec4(
-                glm::min(src.rgb() + dst.rgb(), glm::vec3(1.0f)),
+                glm::min(glm::vec3(src) + glm::vec3(dst), glm::vec3(1.0f)),
                 glm::min(src.a + dst.a, 1.0f)
             );
             
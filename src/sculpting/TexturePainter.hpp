@@ -0,0 +1,75 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Texture;
+
+class TexturePainter {
+public:
+    enum class BrushType {
+        Color,
+        Smooth,
+        Smear,
+        Clone
+    };
+
+    // Layers are painted and blended on the CPU as RGBA8; only the composite
+    // is uploaded to the GPU
+    struct Layer {
+        std::string name;
+        std::vector<unsigned char> pixels;
+        float opacity = 1.0f;
+        bool visible = true;
+        int blendMode = 0; // 0 Normal, 1 Multiply, 2 Add
+    };
+
+    TexturePainter();
+    ~TexturePainter();
+
+    // Discards every layer and starts over with one transparent base layer
+    void initialize(int width, int height);
+
+    int addLayer(const std::string& name);
+    Layer& getLayer(int index) { return layers[index]; }
+    size_t getLayerCount() const { return layers.size(); }
+
+    // Brush settings
+    void setBrushType(BrushType type) { brushType = type; }
+    void setBrushRadius(float radius) { brushRadius = radius; }
+    void setBrushHardness(float hardness) { brushHardness = hardness; }
+    BrushType getBrushType() const { return brushType; }
+
+    glm::vec4 getPixel(int layerIndex, int x, int y);
+    void setPixel(int layerIndex, int x, int y, const glm::vec4& color);
+
+    // Runs `operation` on every pixel under a brush centred at `uv`
+    void applyBrush(const glm::vec2& uv, const std::function<void(int x, int y, float strength)>& operation);
+
+    // Blends every visible layer into the composite buffer. Needs no GL.
+    void compositeLayers();
+    const std::vector<unsigned char>& getComposite() const { return composite; }
+
+    // compositeLayers() followed by an upload to the final texture
+    void updateFinalTexture();
+    std::shared_ptr<Texture> getFinalTexture() const { return finalTexture; }
+
+    int getWidth() const { return textureWidth; }
+    int getHeight() const { return textureHeight; }
+
+private:
+    int textureWidth;
+    int textureHeight;
+    std::vector<Layer> layers;
+    std::vector<unsigned char> composite;
+    std::shared_ptr<Texture> finalTexture;
+
+    BrushType brushType;
+    float brushRadius;
+    float brushHardness;
+
+    float calculateBrushStrength(float distance);
+    glm::vec4 blendColors(const glm::vec4& src, const glm::vec4& dst, int blendMode);
+};
@@ -1,4 +1,5 @@
 #include "UndoSystem.hpp"
+#include "../core/AllocationTracker.hpp"
 
 void UndoSystem::initialize(size_t maxStates) {
     maxUndoStates = maxStates;
@@ -11,11 +12,13 @@ void UndoSystem::clear() {
 }
 
 void UndoSystem::saveState(const SculptMesh& mesh) {
+    MEMORY_TAG(Sculpt);
     redoStates.clear(); // Clear redo stack when new action is performed
     pushState(createState(mesh));
 }
 
 bool UndoSystem::undo() {
+    MEMORY_TAG(Sculpt);
     if (!canUndo()) return false;
 
     auto currentMesh = SculptingSystem::getInstance().getTargetMesh();
@@ -33,6 +36,7 @@ bool UndoSystem::undo() {
 }
 
 bool UndoSystem::redo() {
+    MEMORY_TAG(Sculpt);
     if (!canRedo()) return false;
 
     auto currentMesh = SculptingSystem::getInstance().getTargetMesh();